@@ -0,0 +1,210 @@
+#include "../include/compressed_sparse_row_builder.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace {
+
+constexpr auto seed = 42U;
+
+/** Gated association of n tracks to n detections at unit density.
+ *
+ * Candidates are the detections within the gate radius of a track, found
+ * through a grid of unit cells, with the squared distance as cost. This is
+ * the stream that all construction paths below consume.
+ */
+class Association {
+public:
+  Association(Eigen::Index n, double radius) : n_{n}, radius_{radius} {
+    auto gen = std::mt19937{seed};
+    side_ = std::sqrt(static_cast<double>(n));
+    auto pos = std::uniform_real_distribution<double>{0.0, side_};
+    auto noise = std::normal_distribution<double>{0.0, 0.2};
+    tracks_.resize(n);
+    detections_.resize(n);
+    for (Eigen::Index k = 0; k < n; ++k) {
+      tracks_[k] = {pos(gen), pos(gen)};
+      detections_[k] = {tracks_[k].first + noise(gen),
+                        tracks_[k].second + noise(gen)};
+    }
+    g_ = static_cast<Eigen::Index>(std::ceil(side_)) + 1;
+    cell_ptr_.assign(g_ * g_ + 1, 0);
+    for (const auto &p : detections_) {
+      ++cell_ptr_[cell(p) + 1];
+    }
+    std::partial_sum(cell_ptr_.begin(), cell_ptr_.end(), cell_ptr_.begin());
+    cell_col_.resize(n);
+    auto cursor = cell_ptr_;
+    for (Eigen::Index c = 0; c < n; ++c) {
+      cell_col_[cursor[cell(detections_[c])]++] = c;
+    }
+  }
+
+  [[nodiscard]] Eigen::Index size() const noexcept { return n_; }
+
+  [[nodiscard]] double gate() const noexcept { return radius_ * radius_; }
+
+  /** Calls f(col, cost) for every detection in the cells around track r.
+   */
+  template <typename F> void for_each_candidate(Eigen::Index r, F &&f) const {
+    const auto &p = tracks_[r];
+    const auto reach = static_cast<Eigen::Index>(std::ceil(radius_));
+    const auto cx = clamp(p.first);
+    const auto cy = clamp(p.second);
+    for (auto x = std::max<Eigen::Index>(cx - reach, 0);
+         x <= std::min(cx + reach, g_ - 1); ++x) {
+      for (auto y = std::max<Eigen::Index>(cy - reach, 0);
+           y <= std::min(cy + reach, g_ - 1); ++y) {
+        for (auto k = cell_ptr_[x * g_ + y]; k < cell_ptr_[x * g_ + y + 1];
+             ++k) {
+          const auto c = cell_col_[k];
+          const auto dx = p.first - detections_[c].first;
+          const auto dy = p.second - detections_[c].second;
+          f(c, dx * dx + dy * dy);
+        }
+      }
+    }
+  }
+
+private:
+  [[nodiscard]] Eigen::Index clamp(double p) const noexcept {
+    return std::clamp(static_cast<Eigen::Index>(std::floor(p)),
+                      Eigen::Index{0}, g_ - 1);
+  }
+
+  [[nodiscard]] Eigen::Index
+  cell(const std::pair<double, double> &p) const noexcept {
+    return clamp(p.first) * g_ + clamp(p.second);
+  }
+
+  Eigen::Index n_{};
+  double radius_{};
+  double side_{};
+  Eigen::Index g_{};
+  std::vector<std::pair<double, double>> tracks_{};
+  std::vector<std::pair<double, double>> detections_{};
+  std::vector<Eigen::Index> cell_ptr_{};
+  std::vector<Eigen::Index> cell_col_{};
+};
+
+void report(benchmark::State &state, const Association &association,
+            const asap::CompressedSparseRowMatrix<double> &csr) {
+  state.counters["nnz"] = static_cast<double>(csr.val.size());
+  state.counters["rows/s"] = benchmark::Counter(
+      static_cast<double>(association.size()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/** The current pipeline: Eigen insert, compress and copy into the CSR.
+ */
+void BM_EigenInsert(benchmark::State &state) {
+  const auto association = Association{state.range(0), 2.0};
+  const auto n = association.size();
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  for (auto _ : state) {
+    auto sm = Eigen::SparseMatrix<double, Eigen::RowMajor>(n, n);
+    sm.reserve(Eigen::VectorXi::Constant(n, 64));
+    for (Eigen::Index r = 0; r < n; ++r) {
+      association.for_each_candidate(r, [&](Eigen::Index c, double cost) {
+        if (cost <= association.gate()) {
+          sm.insert(r, c) = cost;
+        }
+      });
+    }
+    sm.makeCompressed();
+    csr.assign(sm);
+    benchmark::DoNotOptimize(csr.val.data());
+  }
+  report(state, association, csr);
+}
+
+/** Eigen triplets, setFromTriplets and copy into the CSR.
+ */
+void BM_EigenTriplets(benchmark::State &state) {
+  const auto association = Association{state.range(0), 2.0};
+  const auto n = association.size();
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (auto _ : state) {
+    triplets.clear();
+    for (Eigen::Index r = 0; r < n; ++r) {
+      association.for_each_candidate(r, [&](Eigen::Index c, double cost) {
+        if (cost <= association.gate()) {
+          triplets.emplace_back(r, c, cost);
+        }
+      });
+    }
+    auto sm = Eigen::SparseMatrix<double, Eigen::RowMajor>(n, n);
+    sm.setFromTriplets(triplets.begin(), triplets.end());
+    csr.assign(sm);
+    benchmark::DoNotOptimize(csr.val.data());
+  }
+  report(state, association, csr);
+}
+
+void BM_BuilderTriplets(benchmark::State &state) {
+  const auto association = Association{state.range(0), 2.0};
+  const auto n = association.size();
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  auto options = asap::CompressedSparseRowBuilderOptions{};
+  options.gate = association.gate();
+  auto builder = asap::CompressedSparseRowBuilder<double>{options};
+  for (auto _ : state) {
+    builder.reset(n, n);
+    for (Eigen::Index r = 0; r < n; ++r) {
+      association.for_each_candidate(
+          r, [&](Eigen::Index c, double cost) { builder.add(r, c, cost); });
+    }
+    builder.build(csr);
+    benchmark::DoNotOptimize(csr.val.data());
+  }
+  report(state, association, csr);
+}
+
+void BM_BuilderCallback(benchmark::State &state) {
+  const auto association = Association{state.range(0), 2.0};
+  const auto n = association.size();
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  auto scratch = std::vector<asap::Edge<double, Eigen::Index>>{};
+  auto options = asap::CompressedSparseRowBuilderOptions{};
+  options.gate = association.gate();
+  options.top_k = state.range(1);
+  for (auto _ : state) {
+    asap::build_compressed_sparse_row_matrix(
+        n, n,
+        [&](Eigen::Index r, const auto &emit) {
+          association.for_each_candidate(r, emit);
+        },
+        csr, scratch, options);
+    benchmark::DoNotOptimize(csr.val.data());
+  }
+  report(state, association, csr);
+}
+
+} // namespace
+
+BENCHMARK(BM_EigenInsert)
+    ->ArgName("n")
+    ->Arg(1 << 12)
+    ->Arg(1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_EigenTriplets)
+    ->ArgName("n")
+    ->Arg(1 << 12)
+    ->Arg(1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_BuilderTriplets)
+    ->ArgName("n")
+    ->Arg(1 << 12)
+    ->Arg(1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_BuilderCallback)
+    ->ArgNames({"n", "top_k"})
+    ->ArgsProduct({{1 << 12, 1 << 16}, {0, 4}})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+#include "../include/compressed_sparse_row_dense.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+
+namespace {
+
+constexpr auto seed = 42U;
+constexpr auto gate = 4.0;
+
+using RowMajorMatrixT =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+/** Dense squared distances of n tracks to n detections at unit density.
+ *
+ * The gate of 4 keeps about 12 detections per track.
+ */
+Eigen::MatrixXd make_dense(Eigen::Index n) {
+  auto gen = std::mt19937{seed};
+  const auto side = std::sqrt(static_cast<double>(n));
+  auto pos = std::uniform_real_distribution<double>{0.0, side};
+  auto tracks = Eigen::Matrix2Xd(2, n);
+  auto detections = Eigen::Matrix2Xd(2, n);
+  for (Eigen::Index k = 0; k < n; ++k) {
+    tracks.col(k) << pos(gen), pos(gen);
+    detections.col(k) << pos(gen), pos(gen);
+  }
+  auto dense = Eigen::MatrixXd(n, n);
+  for (Eigen::Index c = 0; c < n; ++c) {
+    dense.col(c) =
+        (tracks.colwise() - detections.col(c)).colwise().squaredNorm();
+  }
+  return dense;
+}
+
+void report(benchmark::State &state,
+            const asap::CompressedSparseRowMatrix<double> &csr) {
+  state.counters["nnz"] = static_cast<double>(csr.val.size());
+  state.counters["entries/s"] = benchmark::Counter(
+      static_cast<double>(csr.rows * csr.cols),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/** The hand-written loop: Eigen insert, compress and copy into the CSR.
+ */
+void BM_EigenInsert(benchmark::State &state) {
+  const auto dense = make_dense(state.range(0));
+  const auto n = dense.rows();
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  for (auto _ : state) {
+    auto sm = Eigen::SparseMatrix<double, Eigen::RowMajor>(n, n);
+    sm.reserve(Eigen::VectorXi::Constant(n, 32));
+    for (Eigen::Index r = 0; r < n; ++r) {
+      for (Eigen::Index c = 0; c < n; ++c) {
+        if (dense(r, c) <= gate) {
+          sm.insert(r, c) = dense(r, c);
+        }
+      }
+    }
+    sm.makeCompressed();
+    csr.assign(sm);
+    benchmark::DoNotOptimize(csr.val.data());
+  }
+  report(state, csr);
+}
+
+template <typename MatrixT>
+void BM_Dense(benchmark::State &state) {
+  const auto dense = MatrixT(make_dense(state.range(0)));
+  auto options = asap::DenseCompressedSparseRowOptions{};
+  options.gate = gate;
+  options.top_k = state.range(1);
+  options.vectorize = state.range(2) != 0;
+  options.num_threads = static_cast<std::size_t>(state.range(3));
+  auto ws = asap::DenseCompressedSparseRowWorkspace<double>{};
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  for (auto _ : state) {
+    asap::build_compressed_sparse_row_matrix(dense, csr, ws, options);
+    benchmark::DoNotOptimize(csr.val.data());
+  }
+  report(state, csr);
+}
+
+void thread_sweep(benchmark::internal::Benchmark *b) {
+  const auto max_threads =
+      static_cast<int>(std::max(std::thread::hardware_concurrency(), 1U));
+  for (const auto n : {1 << 10, 1 << 12}) {
+    for (const auto top_k : {0, 4}) {
+      for (const auto vectorize : {0, 1}) {
+        b->Args({n, top_k, vectorize, 1});
+      }
+      for (auto threads = 2; threads <= max_threads; threads *= 2) {
+        b->Args({n, top_k, 1, threads});
+      }
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK(BM_EigenInsert)
+    ->ArgName("n")
+    ->Arg(1 << 10)
+    ->Arg(1 << 12)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Dense, Eigen::MatrixXd)
+    ->ArgNames({"n", "top_k", "vectorize", "threads"})
+    ->Apply(thread_sweep)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Dense, RowMajorMatrixT)
+    ->ArgNames({"n", "top_k", "vectorize", "threads"})
+    ->Apply(thread_sweep)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
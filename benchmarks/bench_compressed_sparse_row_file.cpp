@@ -0,0 +1,131 @@
+#include "../include/compressed_sparse_row_file.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+using asap::workloads::SparseMatrixT;
+
+constexpr auto seed = 42U;
+
+SparseMatrixT make_matrix(Eigen::Index n) {
+  return asap::workloads::make_k_nearest_neighbour(n, n + n / 10, 16, seed);
+}
+
+std::string temp_path(const std::string &name, Eigen::Index n) {
+  return (std::filesystem::temp_directory_path() /
+          ("asap_bench_" + name + "_" + std::to_string(n)))
+      .string();
+}
+
+/** Writes sm as a "rows cols nnz" line followed by "row col cost" lines.
+ */
+void write_text(const std::string &path, const SparseMatrixT &sm) {
+  auto os = std::ofstream(path);
+  os.precision(17);
+  os << sm.rows() << ' ' << sm.cols() << ' ' << sm.nonZeros() << '\n';
+  for (Eigen::Index r = 0; r < sm.outerSize(); ++r) {
+    for (auto it = SparseMatrixT::InnerIterator(sm, r); it; ++it) {
+      os << it.row() << ' ' << it.col() << ' ' << it.value() << '\n';
+    }
+  }
+}
+
+SparseMatrixT read_text(const std::string &path) {
+  auto is = std::ifstream(path);
+  auto rows = Eigen::Index{};
+  auto cols = Eigen::Index{};
+  auto nnz = std::size_t{};
+  is >> rows >> cols >> nnz;
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  triplets.reserve(nnz);
+  auto r = Eigen::Index{};
+  auto c = Eigen::Index{};
+  auto v = 0.0;
+  while (is >> r >> c >> v) {
+    triplets.emplace_back(r, c, v);
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+void BM_LoadText(benchmark::State &state) {
+  const auto path = temp_path("text", state.range(0));
+  write_text(path, make_matrix(state.range(0)));
+
+  for (auto _ : state) {
+    const auto sm = read_text(path);
+    benchmark::DoNotOptimize(sm.valuePtr());
+  }
+
+  std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_LoadText)
+    ->ArgName("n")
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 18)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_LoadMapped(benchmark::State &state) {
+  const auto path = temp_path("csr", state.range(0));
+  const auto status =
+      asap::write_compressed_sparse_row_file(path, make_matrix(state.range(0)));
+  if (status != asap::CompressedSparseRowFileStatus::Ok) {
+    state.SkipWithError(asap::to_string(status));
+    return;
+  }
+  const auto verify = state.range(1) != 0;
+
+  auto mapped = asap::MappedCompressedSparseRowMatrix<double, int>{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mapped.open(path, verify));
+    benchmark::DoNotOptimize(mapped.view().val);
+  }
+
+  std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_LoadMapped)
+    ->ArgNames({"n", "verify"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 12, 1 << 18, 8), {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+/** Solve of the mapped matrix, which loading is compared against.
+ */
+void BM_SolveMapped(benchmark::State &state) {
+  const auto path = temp_path("solve", state.range(0));
+  const auto status =
+      asap::write_compressed_sparse_row_file(path, make_matrix(state.range(0)));
+  if (status != asap::CompressedSparseRowFileStatus::Ok) {
+    state.SkipWithError(asap::to_string(status));
+    return;
+  }
+
+  auto mapped = asap::MappedCompressedSparseRowMatrix<double, int>{};
+  if (mapped.open(path) != asap::CompressedSparseRowFileStatus::Ok) {
+    state.SkipWithError("cannot map file");
+    return;
+  }
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double, int>{};
+  auto res = asap::Result<double, int>{};
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(mapped.view(), ws, res);
+    benchmark::DoNotOptimize(res.row_idx.data());
+  }
+
+  std::filesystem::remove(path);
+}
+
+BENCHMARK(BM_SolveMapped)
+    ->ArgName("n")
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 18)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
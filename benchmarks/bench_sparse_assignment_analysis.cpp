@@ -0,0 +1,115 @@
+#include "../include/sparse_assignment_analysis.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace {
+
+using ColMajorMatrixT = Eigen::SparseMatrix<double>;
+
+constexpr auto seed = 42U;
+constexpr auto frames = 8;
+
+enum class Workload { Tracking, Scene };
+
+/** Frames of one gating pattern with new costs, in column-major storage.
+ *
+ * Tracking is a wide k-nearest-neighbour problem with 10% clutter, Scene
+ * the same number of rows split into independent heavy-tailed clusters.
+ * Every frame perturbs the costs of the first one.
+ */
+std::vector<ColMajorMatrixT> make_frames(Workload workload, Eigen::Index n) {
+  const auto sm =
+      workload == Workload::Tracking
+          ? ColMajorMatrixT(asap::workloads::make_k_nearest_neighbour(
+                n, n + n / 10, 8, seed))
+          : ColMajorMatrixT(asap::workloads::make_scene(
+                asap::workloads::make_clusters(
+                    static_cast<std::size_t>(n / 8), 64, seed),
+                seed));
+  auto gen = std::mt19937{seed};
+  auto noise = std::uniform_real_distribution<double>{0.9, 1.1};
+  auto result = std::vector<ColMajorMatrixT>(frames, sm);
+  for (auto &frame : result) {
+    for (Eigen::Index p = 0; p < frame.nonZeros(); ++p) {
+      frame.valuePtr()[p] *= noise(gen);
+    }
+  }
+  return result;
+}
+
+void report(benchmark::State &state, const ColMajorMatrixT &sm) {
+  state.counters["rows"] = static_cast<double>(sm.rows());
+  state.counters["nnz"] = static_cast<double>(sm.nonZeros());
+  state.counters["solves/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+
+/** Every frame is solved from scratch: transpose into the workspace,
+ * feasibility check and LAPJVsp.
+ */
+void BM_Direct(benchmark::State &state, Workload workload) {
+  const auto problems = make_frames(workload, state.range(0));
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.check_feasibility = true;
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  auto k = std::size_t{0};
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(problems[k++ % frames], ws, res,
+                                          options);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  report(state, problems.front());
+}
+
+/** Every frame is transposed, split into components and solved.
+ */
+void BM_Decomposition(benchmark::State &state, Workload workload) {
+  const auto problems = make_frames(workload, state.range(0));
+  auto ws = asap::SparseAssignmentDecompositionWorkspace<double>{};
+  auto res = asap::Result{};
+
+  auto k = std::size_t{0};
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(problems[k++ % frames], ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  report(state, problems.front());
+}
+
+/** The pattern is analyzed once, every frame only gathers its costs.
+ */
+void BM_Analyzed(benchmark::State &state, Workload workload) {
+  const auto problems = make_frames(workload, state.range(0));
+  auto analysis = asap::SparseAssignmentAnalysis<double>{};
+  asap::analyze_sparse_assignment_problem(problems.front(), analysis);
+  auto res = asap::Result{};
+
+  auto k = std::size_t{0};
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(problems[k++ % frames], analysis,
+                                          res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  report(state, problems.front());
+  state.counters["components"] =
+      static_cast<double>(analysis.decomposition.components);
+}
+
+#define ASAP_ANALYSIS_BENCHMARK(NAME, WORKLOAD)                                \
+  BENCHMARK_CAPTURE(NAME, WORKLOAD, Workload::WORKLOAD)                        \
+      ->ArgName("n")                                                           \
+      ->Arg(1 << 12)                                                           \
+      ->Arg(1 << 15)                                                           \
+      ->Unit(benchmark::kMillisecond)
+
+ASAP_ANALYSIS_BENCHMARK(BM_Direct, Tracking);
+ASAP_ANALYSIS_BENCHMARK(BM_Analyzed, Tracking);
+ASAP_ANALYSIS_BENCHMARK(BM_Direct, Scene);
+ASAP_ANALYSIS_BENCHMARK(BM_Decomposition, Scene);
+ASAP_ANALYSIS_BENCHMARK(BM_Analyzed, Scene);
+
+} // namespace
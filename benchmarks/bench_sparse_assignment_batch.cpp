@@ -0,0 +1,122 @@
+#include "../include/sparse_assignment_batch.hpp"
+#include "../include/sparse_assignment_decomposition.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+namespace {
+
+constexpr auto seed = 42U;
+
+/** Solves a scene of gated clusters one by one with a single workspace.
+ */
+void BM_ClustersSequential(benchmark::State &state) {
+  const auto clusters =
+      asap::workloads::make_clusters(state.range(0), 2000, seed);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = std::vector<asap::Result<>>(clusters.size());
+
+  for (auto _ : state) {
+    for (std::size_t k = 0; k < clusters.size(); ++k) {
+      asap::solve_sparse_assignment_problem(clusters[k], ws, res[k]);
+    }
+    benchmark::DoNotOptimize(res.data());
+  }
+  state.counters["problems/s"] = benchmark::Counter(
+      static_cast<double>(clusters.size()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_ClustersSequential)
+    ->ArgName("clusters")
+    ->Arg(256)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+
+/** Solves the same scene with the batch API on 1 to N threads.
+ */
+void BM_ClustersBatch(benchmark::State &state) {
+  const auto clusters =
+      asap::workloads::make_clusters(state.range(0), 2000, seed);
+  auto ws = asap::SparseAssignmentBatchWorkspace<double>{};
+  auto res = std::vector<asap::Result<>>{};
+  auto options = asap::SparseAssignmentBatchOptions{};
+  options.num_threads = static_cast<std::size_t>(state.range(1));
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problems(clusters.begin(), clusters.end(),
+                                           ws, res, options);
+    benchmark::DoNotOptimize(res.data());
+  }
+  state.counters["problems/s"] = benchmark::Counter(
+      static_cast<double>(clusters.size()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(BM_ClustersBatch)
+    ->Apply([](auto *b) {
+      const auto max_threads =
+          std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+      auto threads = std::vector<std::int64_t>{};
+      for (std::int64_t t = 1; t < max_threads; t *= 2) {
+        threads.push_back(t);
+      }
+      threads.push_back(max_threads);
+      b->ArgNames({"clusters", "threads"})->ArgsProduct({{256, 1024}, threads});
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/** Solves the clusters of a scene as one problem without decomposition.
+ */
+void BM_SceneMonolithic(benchmark::State &state) {
+  const auto sm = asap::workloads::make_scene(
+      asap::workloads::make_clusters(state.range(0), 2000, seed), seed);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+}
+
+BENCHMARK(BM_SceneMonolithic)
+    ->ArgName("clusters")
+    ->Arg(256)
+    ->Arg(1024)
+    ->Unit(benchmark::kMillisecond);
+
+/** Finds the clusters of the scene and solves them on 1 to N threads.
+ */
+void BM_SceneDecomposed(benchmark::State &state) {
+  const auto sm = asap::workloads::make_scene(
+      asap::workloads::make_clusters(state.range(0), 2000, seed), seed);
+  auto ws = asap::SparseAssignmentDecompositionWorkspace<double>{};
+  auto res = asap::Result{};
+  auto options = asap::SparseAssignmentDecompositionOptions{};
+  options.num_threads = static_cast<std::size_t>(state.range(1));
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res, options);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  state.counters["components"] = static_cast<double>(ws.components);
+}
+
+BENCHMARK(BM_SceneDecomposed)
+    ->Apply([](auto *b) {
+      const auto max_threads =
+          std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+      auto threads = std::vector<std::int64_t>{};
+      for (std::int64_t t = 1; t < max_threads; t *= 2) {
+        threads.push_back(t);
+      }
+      threads.push_back(max_threads);
+      b->ArgNames({"clusters", "threads"})->ArgsProduct({{256, 1024}, threads});
+    })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
@@ -0,0 +1,121 @@
+#include "../include/sparse_assignment_k_best.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <queue>
+
+namespace {
+
+using asap::workloads::SparseMatrixT;
+
+constexpr auto seed = 42U;
+
+/** Tracks against 10% more detections, each track gated to its k nearest.
+ */
+SparseMatrixT make_tracking_matrix(Eigen::Index n) {
+  return asap::workloads::make_k_nearest_neighbour(n, n + n / 10, 8, seed);
+}
+
+void BM_KBest(benchmark::State &state) {
+  const auto sm = make_tracking_matrix(state.range(0));
+  const auto k = state.range(1);
+  auto ws = asap::SparseAssignmentKBestWorkspace<double>{};
+  auto res = asap::KBestResult<>{};
+
+  for (auto _ : state) {
+    asap::solve_k_best_sparse_assignment_problem(sm, k, ws, res);
+    benchmark::DoNotOptimize(res.costs.data());
+  }
+
+  state.counters["solutions"] = static_cast<double>(res.costs.size());
+  state.counters["augmentations"] = static_cast<double>(ws.augmentations);
+}
+
+BENCHMARK(BM_KBest)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 7, 1 << 9, 1 << 11}, {10, 100}})
+    ->Unit(benchmark::kMillisecond);
+
+/** Murty's algorithm that solves every child from scratch, the baseline.
+ */
+struct FromScratchNode {
+  double cost{};
+  Eigen::Index fixed{};
+  std::vector<Eigen::Index> x{};
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> excluded{};
+};
+
+bool operator<(const FromScratchNode &lhs, const FromScratchNode &rhs) {
+  return lhs.cost > rhs.cost;
+}
+
+bool solve_from_scratch(const SparseMatrixT &sm,
+                        asap::SparseJonkerVolgenantWorkspace<double> &ws,
+                        FromScratchNode &node) {
+  auto fixed_col = std::vector<bool>(sm.cols(), false);
+  for (Eigen::Index i = 0; i < node.fixed; ++i) {
+    fixed_col[node.x[i]] = true;
+  }
+  auto sub = sm;
+  sub.prune([&](Eigen::Index row, Eigen::Index col, double) {
+    if (row < node.fixed) {
+      return col == node.x[row];
+    }
+    return !fixed_col[col] &&
+           (std::find(node.excluded.begin(), node.excluded.end(),
+                      std::make_pair(row, col)) == node.excluded.end());
+  });
+  const auto res = asap::solve_sparse_assignment_problem(sub, ws);
+  if (!res.valid) {
+    return false;
+  }
+  node.cost = 0.0;
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    node.x[res.row_idx[k]] = res.col_idx[k];
+    node.cost += sm.coeff(res.row_idx[k], res.col_idx[k]);
+  }
+  return true;
+}
+
+void BM_KBestFromScratch(benchmark::State &state) {
+  const auto sm = make_tracking_matrix(state.range(0));
+  const auto k = state.range(1);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto solves = 0.0;
+
+  for (auto _ : state) {
+    auto queue = std::priority_queue<FromScratchNode>{};
+    auto root = FromScratchNode{0.0, 0, std::vector<Eigen::Index>(sm.rows()),
+                                {}};
+    solves = 1.0;
+    if (solve_from_scratch(sm, ws, root)) {
+      queue.push(root);
+    }
+    auto found = Eigen::Index{0};
+    while ((found < k) && !queue.empty()) {
+      const auto node = queue.top();
+      queue.pop();
+      ++found;
+      for (auto r = node.fixed; r < sm.rows(); ++r) {
+        auto child = node;
+        child.fixed = r;
+        child.excluded.emplace_back(r, node.x[r]);
+        solves += 1.0;
+        if (solve_from_scratch(sm, ws, child)) {
+          queue.push(std::move(child));
+        }
+      }
+    }
+    benchmark::DoNotOptimize(found);
+  }
+
+  state.counters["solves"] = solves;
+}
+
+BENCHMARK(BM_KBestFromScratch)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 7}, {10, 100}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
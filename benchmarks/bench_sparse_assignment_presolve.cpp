@@ -0,0 +1,74 @@
+#include "../include/sparse_assignment_presolve.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+namespace {
+
+using asap::workloads::SparseMatrixT;
+
+constexpr auto seed = 42U;
+
+/** Tracks against the detections within a squared distance gate of them,
+ * wide with 10% clutter or square. The own detection of every track is kept
+ * so that the problem stays feasible. Costs are quantized to quarters, whose
+ * ties leave rows to the shortest augmenting path phase.
+ */
+SparseMatrixT make_gated_matrix(Eigen::Index n, bool wide, double gate) {
+  auto sm = asap::workloads::make_k_nearest_neighbour(
+      n, wide ? n + n / 10 : n, 16, seed);
+  sm.prune([gate](Eigen::Index row, Eigen::Index col, double cost) {
+    return (cost <= gate) || (row == col);
+  });
+  return SparseMatrixT(
+      sm.unaryExpr([](double cost) { return std::floor(4.0 * cost); }));
+}
+
+void BM_Plain(benchmark::State &state, bool wide) {
+  const auto sm = make_gated_matrix(
+      state.range(0), wide, static_cast<double>(state.range(1)) / 100.0);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+
+  state.counters["nnz"] = static_cast<double>(sm.nonZeros());
+  state.counters["augmentations"] = static_cast<double>(ws.augmentations);
+}
+
+void BM_Presolve(benchmark::State &state, bool wide) {
+  const auto sm = make_gated_matrix(
+      state.range(0), wide, static_cast<double>(state.range(1)) / 100.0);
+  auto ws = asap::SparseAssignmentPresolveWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+
+  state.counters["nnz"] = static_cast<double>(sm.nonZeros());
+  state.counters["augmentations"] =
+      static_cast<double>(ws.solver.augmentations);
+  state.counters["forced"] = static_cast<double>(ws.forced);
+  state.counters["pruned"] = static_cast<double>(ws.pruned);
+  state.counters["reduced_rows"] = static_cast<double>(ws.reduced_rows);
+}
+
+#define ASAP_PRESOLVE_BENCHMARK(NAME, SHAPE, WIDE)                             \
+  BENCHMARK_CAPTURE(NAME, SHAPE, WIDE)                                         \
+      ->ArgNames({"n", "gate_percent"})                                        \
+      ->ArgsProduct({{1 << 14, 1 << 16}, {50, 100, 200}})                      \
+      ->Unit(benchmark::kMillisecond)
+
+ASAP_PRESOLVE_BENCHMARK(BM_Plain, Wide, true);
+ASAP_PRESOLVE_BENCHMARK(BM_Presolve, Wide, true);
+ASAP_PRESOLVE_BENCHMARK(BM_Plain, Square, false);
+ASAP_PRESOLVE_BENCHMARK(BM_Presolve, Square, false);
+
+} // namespace
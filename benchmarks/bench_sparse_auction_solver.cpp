@@ -0,0 +1,114 @@
+#include "../include/sparse_auction_solver.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+namespace {
+
+using asap::workloads::SparseMatrixT;
+
+constexpr auto seed = 42U;
+
+/** Solves sm repeatedly with the auction on the given number of threads and
+ * reports the non-zeros processed per second and the bids per second.
+ */
+void solve(benchmark::State &state, const SparseMatrixT &sm,
+           asap::SparseAuctionOptions options) {
+  auto ws = asap::SparseAuctionWorkspace<double>{};
+  auto res = asap::Result{};
+  options.num_threads = static_cast<std::size_t>(state.range(1));
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res, options);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+
+  if (!res.valid) {
+    state.SkipWithError("infeasible instance");
+    return;
+  }
+
+  const auto nnz = static_cast<double>(sm.nonZeros());
+  state.counters["threads"] = static_cast<double>(options.num_threads);
+  state.counters["rounds"] = static_cast<double>(ws.rounds);
+  state.counters["augmentations"] = static_cast<double>(ws.jv.augmentations);
+  state.counters["nnz/s"] =
+      benchmark::Counter(nnz, benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["bids/s"] =
+      benchmark::Counter(static_cast<double>(ws.bids),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+/** Thread counts from 1 to the number of hardware threads in powers of two.
+ */
+void thread_sweep(benchmark::internal::Benchmark *b,
+                  std::vector<std::int64_t> sizes) {
+  const auto max_threads =
+      std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+  auto threads = std::vector<std::int64_t>{};
+  for (std::int64_t t = 1; t < max_threads; t *= 2) {
+    threads.push_back(t);
+  }
+  threads.push_back(max_threads);
+  b->ArgNames({"n", "threads"})->ArgsProduct({sizes, threads});
+}
+
+void BM_UniformAuction(benchmark::State &state, bool exact) {
+  const auto n = state.range(0);
+  const auto sm = asap::workloads::make_uniform(n, n, 64, seed);
+  auto options = asap::SparseAuctionOptions{};
+  options.exact = exact;
+  solve(state, sm, options);
+}
+
+BENCHMARK_CAPTURE(BM_UniformAuction, Exact, true)
+    ->Apply([](auto *b) { thread_sweep(b, {1 << 12, 1 << 14}); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_UniformAuction, Bounded, false)
+    ->Apply([](auto *b) { thread_sweep(b, {1 << 12, 1 << 14}); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_KNearestNeighbourAuction(benchmark::State &state, bool exact) {
+  const auto n = state.range(0);
+  const auto sm = asap::workloads::make_k_nearest_neighbour(n, n, 32, seed);
+  auto options = asap::SparseAuctionOptions{};
+  options.exact = exact;
+  solve(state, sm, options);
+}
+
+BENCHMARK_CAPTURE(BM_KNearestNeighbourAuction, Exact, true)
+    ->Apply([](auto *b) { thread_sweep(b, {1 << 14, 1 << 16}); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_KNearestNeighbourAuction, Bounded, false)
+    ->Apply([](auto *b) { thread_sweep(b, {1 << 14, 1 << 16}); })
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/** LAPJVsp on the same instances as baseline for the auction.
+ */
+void BM_UniformJonkerVolgenant(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm = asap::workloads::make_uniform(n, n, 64, seed);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+}
+
+BENCHMARK(BM_UniformJonkerVolgenant)
+    ->ArgName("n")
+    ->Arg(1 << 12)
+    ->Arg(1 << 14)
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,506 @@
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_workloads.hpp"
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace {
+
+using asap::workloads::ScipyFamily;
+using asap::workloads::SparseMatrixT;
+
+constexpr auto seed = 42U;
+
+/** Solves sm repeatedly and reports the non-zeros processed per second and
+ * the time per row augmented by the shortest augmenting path phase.
+ */
+void solve(benchmark::State &state, const SparseMatrixT &sm,
+           const asap::SparseJonkerVolgenantOptions &options = {}) {
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res, options);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+
+  if (!res.valid) {
+    state.SkipWithError("infeasible instance");
+    return;
+  }
+
+  const auto nnz = static_cast<double>(sm.nonZeros());
+  const auto augmentations = static_cast<double>(ws.augmentations);
+  state.counters["nnz"] = nnz;
+  state.counters["augmentations"] = augmentations;
+  state.counters["nnz/s"] =
+      benchmark::Counter(nnz, benchmark::Counter::kIsIterationInvariantRate);
+  if (augmentations > 0.0) {
+    state.counters["t/augmentation"] = benchmark::Counter(
+        augmentations, benchmark::Counter::kIsIterationInvariantRate |
+                           benchmark::Counter::kInvert);
+  }
+}
+
+void BM_Uniform(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm = asap::workloads::make_uniform(n, n, state.range(1), seed);
+  solve(state, sm);
+}
+
+BENCHMARK(BM_Uniform)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 10, 1 << 12, 1 << 14}, {4, 16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+/** The uniform workload with its costs quantized to CostT, which narrows the
+ * value array and replaces floating point by exact integer comparisons.
+ */
+template <typename CostT> void BM_CostType(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm = Eigen::SparseMatrix<CostT, Eigen::RowMajor>(
+      asap::workloads::make_uniform(n, n, state.range(1), seed)
+          .template cast<CostT>());
+  auto ws = asap::SparseJonkerVolgenantWorkspace<CostT>{};
+  auto res = asap::Result<CostT>{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  state.counters["nnz/s"] = benchmark::Counter(
+      static_cast<double>(sm.nonZeros()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_CostType, double)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 12, 1 << 14}, {16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_CostType, float)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 12, 1 << 14}, {16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_CostType, std::int32_t)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 12, 1 << 14}, {16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_CostType, std::int64_t)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 12, 1 << 14}, {16, 64}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_Banded(benchmark::State &state, asap::AugmentationStrategy strategy) {
+  const auto sm = asap::workloads::make_banded(state.range(0), 10, seed);
+  solve(state, sm, asap::SparseJonkerVolgenantOptions{strategy});
+  state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_Banded, LinearScan, asap::AugmentationStrategy::LinearScan)
+    ->ArgName("n")
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+BENCHMARK_CAPTURE(BM_Banded, Heap, asap::AugmentationStrategy::Heap)
+    ->ArgName("n")
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Unit(benchmark::kMillisecond)
+    ->Complexity();
+
+/** Rows with hundreds of candidates, where every scanned column of a
+ * shortest path search needs the cost of its matched edge. The spare columns
+ * skip augmenting row reduction, so all rows go through the search.
+ */
+void BM_HighDegree(benchmark::State &state,
+                   asap::AugmentationStrategy strategy) {
+  const auto n = state.range(0);
+  const auto sm =
+      asap::workloads::make_uniform(n, n + n / 8, state.range(1), seed);
+  solve(state, sm, asap::SparseJonkerVolgenantOptions{strategy});
+}
+
+BENCHMARK_CAPTURE(BM_HighDegree, LinearScan,
+                  asap::AugmentationStrategy::LinearScan)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 11, 1 << 13}, {256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_HighDegree, Heap, asap::AugmentationStrategy::Heap)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 11, 1 << 13}, {256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+/** Square instances with long rows, where the column reduction and the
+ * augmenting row reduction dominate, solved with and without the vectorized
+ * row scans.
+ */
+void BM_Vectorize(benchmark::State &state, bool vectorize) {
+  const auto n = state.range(0);
+  const auto sm = asap::workloads::make_uniform(n, n, state.range(1), seed);
+  auto options =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Heap};
+  options.vectorize = vectorize;
+  solve(state, sm, options);
+}
+
+BENCHMARK_CAPTURE(BM_Vectorize, Scalar, false)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 11, 1 << 13}, {64, 256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_Vectorize, Simd, true)
+    ->ArgNames({"n", "nnz_per_row"})
+    ->ArgsProduct({{1 << 11, 1 << 13}, {64, 256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+/** k-nearest-neighbour instances solved with the statistics policy S, which
+ * shows the cost of recording SolverStats against the default policy.
+ */
+template <typename S> void BM_Stats(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm =
+      asap::workloads::make_k_nearest_neighbour(n, n, state.range(1), seed);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double, Eigen::Index, S>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  state.counters["nnz/s"] = benchmark::Counter(
+      static_cast<double>(sm.nonZeros()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_Stats, asap::NoSolverStats)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 12, 1 << 15}, {8, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_Stats, asap::SolverStats)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 12, 1 << 15}, {8, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+/** Large k-nearest-neighbour instances stored as separate col_ind and val
+ * arrays or as interleaved {col, cost} edges, with costs of type T and
+ * indices of type I. Both layouts take the scalar row scans, so only the
+ * memory layout differs.
+ */
+template <typename T, typename I, bool Interleaved>
+void BM_EdgeLayout(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm = Eigen::SparseMatrix<T, Eigen::RowMajor>(
+      asap::workloads::make_k_nearest_neighbour(n, n, state.range(1), seed)
+          .template cast<T>());
+  auto ws = asap::SparseJonkerVolgenantWorkspace<T, I>{};
+  auto res = asap::Result<T, I>{};
+  auto options =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Heap};
+  options.vectorize = false;
+
+  const auto run = [&](const auto &view) {
+    for (auto _ : state) {
+      asap::solve_sparse_assignment_problem(view, ws, res, options);
+      benchmark::DoNotOptimize(res.col_idx.data());
+    }
+  };
+  if constexpr (Interleaved) {
+    auto csr = asap::InterleavedCompressedSparseRowMatrix<T, I>{};
+    csr.assign(sm);
+    run(csr.view());
+  } else {
+    auto csr = asap::CompressedSparseRowMatrix<T, I>{};
+    csr.assign(sm);
+    run(asap::CompressedSparseRowMatrixView<T, I>{
+        csr.val.data(), csr.col_ind.data(), csr.row_ptr.data(), csr.rows,
+        csr.cols});
+  }
+  state.counters["nnz/s"] = benchmark::Counter(
+      static_cast<double>(sm.nonZeros()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_EdgeLayout, double, std::int64_t, false)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 14, 1 << 17}, {32}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_EdgeLayout, double, std::int64_t, true)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 14, 1 << 17}, {32}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_EdgeLayout, float, std::int32_t, false)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 14, 1 << 17}, {32}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_EdgeLayout, float, std::int32_t, true)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 14, 1 << 17}, {32}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_KNearestNeighbour(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm =
+      asap::workloads::make_k_nearest_neighbour(n, n, state.range(1), seed);
+  solve(state, sm);
+}
+
+BENCHMARK(BM_KNearestNeighbour)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 10, 1 << 12, 1 << 14, 1 << 16}, {8, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+/** k-nearest-neighbour instances stored and solved with index type I, so
+ * col_ind, row_ptr and the assignment and search state all have its width.
+ */
+template <typename I> void BM_IndexType(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto sm =
+      asap::workloads::make_k_nearest_neighbour(n, n, state.range(1), seed);
+  auto csr = asap::CompressedSparseRowMatrix<double, I>{};
+  csr.assign(sm);
+  const auto view = asap::CompressedSparseRowMatrixView<double, I>{
+      csr.val.data(), csr.col_ind.data(), csr.row_ptr.data(), csr.rows,
+      csr.cols};
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double, I>{};
+  auto res = asap::Result<double, I>{};
+  const auto options =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Heap};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(view, ws, res, options);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+  state.counters["nnz/s"] = benchmark::Counter(
+      static_cast<double>(sm.nonZeros()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(BM_IndexType, std::int64_t)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 14, 1 << 17}, {8, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_TEMPLATE(BM_IndexType, std::int32_t)
+    ->ArgNames({"n", "k"})
+    ->ArgsProduct({{1 << 14, 1 << 17}, {8, 32}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_BlockDiagonal(benchmark::State &state) {
+  const auto sm = asap::workloads::make_block_diagonal(
+      state.range(0), state.range(1), 8, seed);
+  solve(state, sm);
+}
+
+BENCHMARK(BM_BlockDiagonal)
+    ->ArgNames({"blocks", "block_size"})
+    ->ArgsProduct({{16, 256}, {32, 128}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_NearlyDense(benchmark::State &state) {
+  const auto n = state.range(0);
+  const auto density = static_cast<double>(state.range(1)) / 100.0;
+  const auto sm = asap::workloads::make_nearly_dense(n, n, density, seed);
+  solve(state, sm);
+}
+
+BENCHMARK(BM_NearlyDense)
+    ->ArgNames({"n", "density_percent"})
+    ->ArgsProduct({{128, 256, 512}, {50, 90}})
+    ->Unit(benchmark::kMillisecond);
+
+void BM_Rectangular(benchmark::State &state) {
+  const auto rows = state.range(0);
+  const auto cols = rows * state.range(1) / 100;
+  const auto sm = asap::workloads::make_uniform(rows, cols, 16, seed);
+  solve(state, sm);
+}
+
+BENCHMARK(BM_Rectangular)
+    ->ArgNames({"rows", "aspect_percent"})
+    ->ArgsProduct({{1 << 11}, {25, 50, 90, 110, 150, 200, 500, 1000}})
+    ->Unit(benchmark::kMillisecond);
+
+/** Tracks against detections with clutter: each row reaches its k nearest
+ * columns, and all but rows columns are left unassigned.
+ */
+void BM_WideKNearestNeighbour(benchmark::State &state,
+                              asap::AugmentationStrategy strategy) {
+  const auto rows = state.range(0);
+  const auto cols = rows * state.range(1) / 100;
+  const auto sm =
+      asap::workloads::make_k_nearest_neighbour(rows, cols, 16, seed);
+  solve(state, sm, asap::SparseJonkerVolgenantOptions{strategy});
+}
+
+BENCHMARK_CAPTURE(BM_WideKNearestNeighbour, LinearScan,
+                  asap::AugmentationStrategy::LinearScan)
+    ->ArgNames({"rows", "aspect_percent"})
+    ->ArgsProduct({{1 << 12, 1 << 15}, {110, 150, 200, 500, 1000}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_WideKNearestNeighbour, Heap,
+                  asap::AugmentationStrategy::Heap)
+    ->ArgNames({"rows", "aspect_percent"})
+    ->ArgsProduct({{1 << 12, 1 << 15}, {110, 150, 200, 500, 1000}})
+    ->Unit(benchmark::kMillisecond);
+
+/** k-nearest-neighbour costs quantized to quarters, whose many ties leave
+ * thousands of rows to the augmentation, solved with the heap augmentation
+ * and with the parallel augmentation on 1 to the number of hardware threads.
+ */
+void BM_QuantizedKNearestNeighbour(benchmark::State &state,
+                                   asap::AugmentationStrategy strategy) {
+  const auto n = state.range(0);
+  const auto sm = SparseMatrixT(
+      asap::workloads::make_k_nearest_neighbour(n, n + n / 10, 8, seed)
+          .unaryExpr([](double c) { return std::floor(4.0 * c); }));
+  auto options = asap::SparseJonkerVolgenantOptions{strategy};
+  options.num_threads = static_cast<std::size_t>(state.range(1));
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res, options);
+    benchmark::DoNotOptimize(res.col_idx.data());
+  }
+
+  state.counters["augmentations"] = static_cast<double>(ws.augmentations);
+  state.counters["conflicts"] = static_cast<double>(ws.conflicts);
+}
+
+BENCHMARK_CAPTURE(BM_QuantizedKNearestNeighbour, Heap,
+                  asap::AugmentationStrategy::Heap)
+    ->ArgNames({"n", "threads"})
+    ->ArgsProduct({{1 << 15, 1 << 17}, {1}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_QuantizedKNearestNeighbour, Parallel,
+                  asap::AugmentationStrategy::Parallel)
+    ->Apply([](auto *b) {
+      const auto max_threads =
+          std::max<std::int64_t>(std::thread::hardware_concurrency(), 1);
+      auto threads = std::vector<std::int64_t>{};
+      for (std::int64_t t = 1; t < max_threads; t *= 2) {
+        threads.push_back(t);
+      }
+      threads.push_back(max_threads);
+      b->ArgNames({"n", "threads"})->ArgsProduct({{1 << 15, 1 << 17}, threads});
+    })
+    ->Unit(benchmark::kMillisecond);
+
+void BM_Infeasible(benchmark::State &state, bool check_feasibility) {
+  // Rows 0 and 1 compete for column 0 only, which no weighted phase notices
+  // before it reaches them.
+  const auto n = state.range(0);
+  auto sm = asap::workloads::make_uniform(n, n, 16, seed);
+  sm.prune([](Eigen::Index row, Eigen::Index col, double) {
+    return (row > 1) || (col == 0);
+  });
+  sm.coeffRef(0, 0) = 1.0;
+  sm.coeffRef(1, 0) = 1.0;
+  sm.makeCompressed();
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.check_feasibility = check_feasibility;
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (auto _ : state) {
+    asap::solve_sparse_assignment_problem(sm, ws, res, options);
+    benchmark::DoNotOptimize(res.valid);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_Infeasible, NoCheck, false)
+    ->ArgName("n")
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 14)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_Infeasible, HopcroftKarpCheck, true)
+    ->ArgName("n")
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 14)
+    ->Unit(benchmark::kMillisecond);
+
+/** Frame-to-frame tracking: every iteration perturbs 1% of the costs and
+ * solves again, either from scratch or warm-started from the last frame.
+ */
+void BM_Tracking(benchmark::State &state, bool warm_start) {
+  const auto n = state.range(0);
+  auto sm = asap::workloads::make_k_nearest_neighbour(n, n, 16, seed);
+  auto gen = std::mt19937{seed};
+  auto row_dist = std::uniform_int_distribution<Eigen::Index>{0, n - 1};
+  auto noise_dist = std::normal_distribution<double>{0.0, 0.01};
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::solve_sparse_assignment_problem(sm, ws);
+  auto augmentations = 0.0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (Eigen::Index k = 0; k < n / 100; ++k) {
+      for (SparseMatrixT::InnerIterator it(sm, row_dist(gen)); it; ++it) {
+        it.valueRef() = std::abs(it.value() + noise_dist(gen));
+      }
+    }
+    state.ResumeTiming();
+
+    if (warm_start) {
+      res = asap::resolve_sparse_assignment_problem(sm, ws, std::move(res));
+    } else {
+      asap::solve_sparse_assignment_problem(sm, ws, res);
+    }
+    benchmark::DoNotOptimize(res.col_idx.data());
+    augmentations += static_cast<double>(ws.augmentations);
+  }
+
+  state.counters["augmentations"] =
+      benchmark::Counter(augmentations, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_CAPTURE(BM_Tracking, Cold, false)
+    ->ArgName("n")
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(BM_Tracking, WarmStart, true)
+    ->ArgName("n")
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+void BM_ScipyReference(benchmark::State &state, ScipyFamily family) {
+  const auto n = state.range(0);
+  const auto sm = asap::workloads::make_scipy_reference(
+      family, n, n * state.range(1), seed);
+  solve(state, sm);
+}
+
+#define ASAP_SCIPY_REFERENCE_BENCHMARK(FAMILY)                                 \
+  BENCHMARK_CAPTURE(BM_ScipyReference, FAMILY, ScipyFamily::FAMILY)            \
+      ->ArgNames({"n", "aspect"})                                              \
+      ->ArgsProduct({{100, 200, 300, 400}, {1, 2}})                            \
+      ->Unit(benchmark::kMillisecond)
+
+ASAP_SCIPY_REFERENCE_BENCHMARK(RandomUniform);
+ASAP_SCIPY_REFERENCE_BENCHMARK(RandomUniformSparse);
+ASAP_SCIPY_REFERENCE_BENCHMARK(RandomUniformInteger);
+ASAP_SCIPY_REFERENCE_BENCHMARK(RandomGeometric);
+ASAP_SCIPY_REFERENCE_BENCHMARK(RandomTwoCost);
+ASAP_SCIPY_REFERENCE_BENCHMARK(MacholWien);
+
+} // namespace
@@ -0,0 +1,363 @@
+#ifndef ASAP_BENCHMARKS_SPARSE_ASSIGNMENT_WORKLOADS_HPP
+#define ASAP_BENCHMARKS_SPARSE_ASSIGNMENT_WORKLOADS_HPP
+
+#include <eigen3/Eigen/SparseCore>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace asap {
+
+namespace workloads {
+
+/** @brief Seeded generators for sparse assignment benchmark instances.
+ *
+ * All generators are deterministic for a given seed and add the entries
+ * (k, k) for k < min(rows, cols), so every instance admits a full matching.
+ * Costs of duplicate entries are resolved by keeping the last one.
+ */
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+using TripletT = Eigen::Triplet<double>;
+
+inline SparseMatrixT make_sparse_matrix(Eigen::Index rows, Eigen::Index cols,
+                                        std::vector<TripletT> &triplets) {
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](const auto &, const auto &b) { return b; });
+  return sm;
+}
+
+template <typename CostDistribution>
+void add_diagonal(Eigen::Index rows, Eigen::Index cols, std::mt19937 &gen,
+                  CostDistribution &cost_dist,
+                  std::vector<TripletT> &triplets) {
+  for (Eigen::Index k = 0; k < std::min(rows, cols); ++k) {
+    triplets.emplace_back(k, k, cost_dist(gen));
+  }
+}
+
+/** @brief Uniformly random columns and costs with nnz_per_row per row.
+ */
+inline SparseMatrixT make_uniform(Eigen::Index rows, Eigen::Index cols,
+                                  Eigen::Index nnz_per_row, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto col_dist = std::uniform_int_distribution<Eigen::Index>{0, cols - 1};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 1000.0};
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(rows * (nnz_per_row + 1));
+  add_diagonal(rows, cols, gen, cost_dist, triplets);
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index k = 0; k < nnz_per_row; ++k) {
+      triplets.emplace_back(r, col_dist(gen), cost_dist(gen));
+    }
+  }
+  return make_sparse_matrix(rows, cols, triplets);
+}
+
+/** @brief Random columns within a window around the diagonal of each row.
+ */
+inline SparseMatrixT make_banded(Eigen::Index n, Eigen::Index nnz_per_row,
+                                 unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto offset_dist = std::uniform_int_distribution<Eigen::Index>{
+      -2 * nnz_per_row, 2 * nnz_per_row};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 1000.0};
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(n * (nnz_per_row + 1));
+  add_diagonal(n, n, gen, cost_dist, triplets);
+  for (Eigen::Index r = 0; r < n; ++r) {
+    for (Eigen::Index k = 0; k < nnz_per_row; ++k) {
+      const auto c = std::clamp(r + offset_dist(gen), Eigen::Index{0}, n - 1);
+      triplets.emplace_back(r, c, cost_dist(gen));
+    }
+  }
+  return make_sparse_matrix(n, n, triplets);
+}
+
+/** @brief Geometric k-nearest-neighbour gating as in tracking problems.
+ *
+ * Rows are uniformly distributed points at unit density, the first
+ * min(rows, cols) columns are noisy copies of them and the remaining columns
+ * are clutter. Each row is connected to its k nearest columns with the
+ * squared distance as cost.
+ */
+inline SparseMatrixT make_k_nearest_neighbour(Eigen::Index rows,
+                                              Eigen::Index cols,
+                                              Eigen::Index k, unsigned seed) {
+  using PointT = std::pair<double, double>;
+
+  auto gen = std::mt19937{seed};
+  const auto side = std::sqrt(static_cast<double>(std::max(rows, cols)));
+  auto pos_dist = std::uniform_real_distribution<double>{0.0, side};
+  auto noise_dist = std::normal_distribution<double>{0.0, 0.2};
+
+  auto row_pts = std::vector<PointT>(rows);
+  for (auto &p : row_pts) {
+    p = {pos_dist(gen), pos_dist(gen)};
+  }
+  auto col_pts = std::vector<PointT>(cols);
+  for (Eigen::Index c = 0; c < cols; ++c) {
+    col_pts[c] = (c < rows) ? PointT{row_pts[c].first + noise_dist(gen),
+                                     row_pts[c].second + noise_dist(gen)}
+                            : PointT{pos_dist(gen), pos_dist(gen)};
+  }
+
+  // Bucket the columns into a grid of unit cells.
+  const auto g = static_cast<Eigen::Index>(std::ceil(side)) + 1;
+  const auto cell = [g](double p) {
+    return std::clamp(static_cast<Eigen::Index>(std::floor(p)), Eigen::Index{0},
+                      g - 1);
+  };
+  auto cell_ptr = std::vector<Eigen::Index>(g * g + 1, 0);
+  auto cell_col = std::vector<Eigen::Index>(cols);
+  for (const auto &p : col_pts) {
+    ++cell_ptr[cell(p.first) * g + cell(p.second) + 1];
+  }
+  std::partial_sum(cell_ptr.begin(), cell_ptr.end(), cell_ptr.begin());
+  auto cursor = cell_ptr;
+  for (Eigen::Index c = 0; c < cols; ++c) {
+    cell_col[cursor[cell(col_pts[c].first) * g + cell(col_pts[c].second)]++] =
+        c;
+  }
+
+  const auto dist = [&](Eigen::Index r, Eigen::Index c) {
+    const auto dx = row_pts[r].first - col_pts[c].first;
+    const auto dy = row_pts[r].second - col_pts[c].second;
+    return dx * dx + dy * dy;
+  };
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(rows * (k + 1));
+  auto candidates = std::vector<std::pair<double, Eigen::Index>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    const auto cx = cell(row_pts[r].first);
+    const auto cy = cell(row_pts[r].second);
+    candidates.clear();
+    for (Eigen::Index ring = 0; ring < g; ++ring) {
+      for (auto ix = cx - ring; ix <= cx + ring; ++ix) {
+        for (auto iy = cy - ring; iy <= cy + ring; ++iy) {
+          const auto on_ring = (std::abs(ix - cx) == ring) ||
+                               (std::abs(iy - cy) == ring);
+          if (!on_ring || ix < 0 || iy < 0 || ix >= g || iy >= g) {
+            continue;
+          }
+          for (auto t = cell_ptr[ix * g + iy]; t < cell_ptr[ix * g + iy + 1];
+               ++t) {
+            candidates.emplace_back(dist(r, cell_col[t]), cell_col[t]);
+          }
+        }
+      }
+      // Columns outside the visited rings are at least ring cells away.
+      if (static_cast<Eigen::Index>(candidates.size()) >= k) {
+        std::nth_element(candidates.begin(), candidates.begin() + (k - 1),
+                         candidates.end());
+        if (candidates[k - 1].first <= static_cast<double>(ring * ring)) {
+          break;
+        }
+      }
+    }
+    const auto kept = std::min<Eigen::Index>(k, candidates.size());
+    for (Eigen::Index t = 0; t < kept; ++t) {
+      triplets.emplace_back(r, candidates[t].second, candidates[t].first);
+    }
+    if (r < cols) {
+      triplets.emplace_back(r, r, dist(r, r));
+    }
+  }
+  return make_sparse_matrix(rows, cols, triplets);
+}
+
+/** @brief Independent square blocks along the diagonal.
+ */
+inline SparseMatrixT make_block_diagonal(Eigen::Index blocks,
+                                         Eigen::Index block_size,
+                                         Eigen::Index nnz_per_row,
+                                         unsigned seed) {
+  const auto n = blocks * block_size;
+  auto gen = std::mt19937{seed};
+  auto offset_dist =
+      std::uniform_int_distribution<Eigen::Index>{0, block_size - 1};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 1000.0};
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(n * (nnz_per_row + 1));
+  add_diagonal(n, n, gen, cost_dist, triplets);
+  for (Eigen::Index r = 0; r < n; ++r) {
+    const auto offset = (r / block_size) * block_size;
+    for (Eigen::Index k = 0; k < nnz_per_row; ++k) {
+      triplets.emplace_back(r, offset + offset_dist(gen), cost_dist(gen));
+    }
+  }
+  return make_sparse_matrix(n, n, triplets);
+}
+
+/** @brief Each entry is present with probability density.
+ */
+inline SparseMatrixT make_nearly_dense(Eigen::Index rows, Eigen::Index cols,
+                                       double density, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto keep_dist = std::bernoulli_distribution{density};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 1000.0};
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(static_cast<std::size_t>(rows * cols * density) + rows);
+  add_diagonal(rows, cols, gen, cost_dist, triplets);
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if (keep_dist(gen)) {
+        triplets.emplace_back(r, c, cost_dist(gen));
+      }
+    }
+  }
+  return make_sparse_matrix(rows, cols, triplets);
+}
+
+/** @brief Independent gated clusters with heavy-tailed sizes.
+ *
+ * Cluster sizes follow a Pareto-like distribution between 2 and max_size,
+ * so a few large clusters dominate the work as in tracking scenes.
+ */
+inline std::vector<SparseMatrixT> make_clusters(std::size_t count,
+                                                Eigen::Index max_size,
+                                                unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto size_dist = std::uniform_real_distribution<double>{0.0, 1.0};
+
+  auto clusters = std::vector<SparseMatrixT>{};
+  clusters.reserve(count);
+  for (std::size_t k = 0; k < count; ++k) {
+    const auto u = size_dist(gen);
+    const auto n = std::clamp<Eigen::Index>(
+        static_cast<Eigen::Index>(2.0 / std::pow(1.0 - u, 0.8)), 2, max_size);
+    clusters.push_back(
+        make_uniform(n, n, std::min<Eigen::Index>(n, 8), gen()));
+  }
+  return clusters;
+}
+
+/** @brief Places the clusters on shuffled rows and columns of one matrix.
+ *
+ * The result is a single problem whose connected components are the given
+ * clusters. Rows and columns are permuted, so it does not keep the diagonal
+ * but still admits a full matching.
+ */
+inline SparseMatrixT make_scene(const std::vector<SparseMatrixT> &clusters,
+                                unsigned seed) {
+  auto gen = std::mt19937{seed};
+
+  auto rows = Eigen::Index{0};
+  auto cols = Eigen::Index{0};
+  auto nnz = Eigen::Index{0};
+  for (const auto &cluster : clusters) {
+    rows += cluster.rows();
+    cols += cluster.cols();
+    nnz += cluster.nonZeros();
+  }
+  auto row_perm = std::vector<Eigen::Index>(rows);
+  auto col_perm = std::vector<Eigen::Index>(cols);
+  std::iota(row_perm.begin(), row_perm.end(), 0);
+  std::iota(col_perm.begin(), col_perm.end(), 0);
+  std::shuffle(row_perm.begin(), row_perm.end(), gen);
+  std::shuffle(col_perm.begin(), col_perm.end(), gen);
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(nnz);
+  auto row_offset = Eigen::Index{0};
+  auto col_offset = Eigen::Index{0};
+  for (const auto &cluster : clusters) {
+    for (Eigen::Index r = 0; r < cluster.outerSize(); ++r) {
+      for (SparseMatrixT::InnerIterator it(cluster, r); it; ++it) {
+        triplets.emplace_back(row_perm[row_offset + it.row()],
+                              col_perm[col_offset + it.col()], it.value());
+      }
+    }
+    row_offset += cluster.rows();
+    col_offset += cluster.cols();
+  }
+  return make_sparse_matrix(rows, cols, triplets);
+}
+
+/** @brief Instance families of the scipy benchmark suite.
+ *
+ * These mirror the input types of the asv benchmark of
+ * scipy.sparse.csgraph.min_weight_full_bipartite_matching. The random number
+ * generator differs from numpy, so the instances share distribution and
+ * shape with their scipy counterparts but not the exact entries.
+ */
+enum class ScipyFamily {
+  RandomUniform,
+  RandomUniformSparse,
+  RandomUniformInteger,
+  RandomGeometric,
+  RandomTwoCost,
+  MacholWien
+};
+
+inline SparseMatrixT make_scipy_reference(ScipyFamily family,
+                                          Eigen::Index rows, Eigen::Index cols,
+                                          unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto uniform_dist = std::uniform_real_distribution<double>{0.0, 1.0};
+  auto keep_dist = std::bernoulli_distribution{0.1};
+  auto integer_dist = std::uniform_int_distribution<int>{1, 100};
+  auto two_cost_dist = std::bernoulli_distribution{0.5};
+
+  auto row_pts = std::vector<std::pair<double, double>>(rows);
+  auto col_pts = std::vector<std::pair<double, double>>(cols);
+  if (family == ScipyFamily::RandomGeometric) {
+    for (auto &p : row_pts) {
+      p = {uniform_dist(gen), uniform_dist(gen)};
+    }
+    for (auto &p : col_pts) {
+      p = {uniform_dist(gen), uniform_dist(gen)};
+    }
+  }
+
+  auto triplets = std::vector<TripletT>{};
+  triplets.reserve(rows * cols);
+  if (family == ScipyFamily::RandomUniformSparse) {
+    add_diagonal(rows, cols, gen, uniform_dist, triplets);
+  }
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      switch (family) {
+      case ScipyFamily::RandomUniform:
+        triplets.emplace_back(r, c, uniform_dist(gen));
+        break;
+      case ScipyFamily::RandomUniformSparse:
+        if (keep_dist(gen)) {
+          triplets.emplace_back(r, c, uniform_dist(gen));
+        }
+        break;
+      case ScipyFamily::RandomUniformInteger:
+        triplets.emplace_back(r, c, integer_dist(gen));
+        break;
+      case ScipyFamily::RandomGeometric:
+        triplets.emplace_back(
+            r, c,
+            std::hypot(row_pts[r].first - col_pts[c].first,
+                       row_pts[r].second - col_pts[c].second));
+        break;
+      case ScipyFamily::RandomTwoCost:
+        triplets.emplace_back(r, c, two_cost_dist(gen) ? 1.0 : 1000000.0);
+        break;
+      case ScipyFamily::MacholWien:
+        triplets.emplace_back(r, c, static_cast<double>((r + 1) * (c + 1)));
+        break;
+      }
+    }
+  }
+  return make_sparse_matrix(rows, cols, triplets);
+}
+
+} // namespace workloads
+
+} // namespace asap
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <numeric>
 #include <vector>
 
@@ -19,6 +20,16 @@ std::ostream &operator<<(std::ostream &os, const Container<T, Alloc> &c) {
 
 namespace internal {
 
+/** @brief Vector of U whose allocator is A rebound to U.
+ *
+ * Lets a container templated on one allocator A own buffers of several
+ * element types that all draw from the same allocator, for example the same
+ * std::pmr::memory_resource.
+ */
+template <typename U, typename A>
+using rebind_vector_t =
+    std::vector<U, typename std::allocator_traits<A>::template rebind_alloc<U>>;
+
 template <template <typename, typename> typename Container, typename T,
           typename Alloc = std::allocator<T>>
 [[nodiscard]] auto argsort(const Container<T, Alloc> &c) {
@@ -0,0 +1,202 @@
+#ifndef ASAP_COMPRESSED_SPARSE_ROW_BUILDER_HPP
+#define ASAP_COMPRESSED_SPARSE_ROW_BUILDER_HPP
+
+#include "compressed_sparse_row_matrix.hpp"
+
+#include <limits>
+
+namespace asap {
+
+/** @brief Configures the construction of a CSR from candidate edges.
+ *
+ * Candidates with a cost above gate are dropped as they arrive. If top_k is
+ * positive, only the top_k cheapest entries of each row are kept, ties are
+ * broken towards lower columns. Duplicate candidates for the same entry keep
+ * the lower cost.
+ */
+struct CompressedSparseRowBuilderOptions {
+  double gate{std::numeric_limits<double>::infinity()};
+  Eigen::Index top_k{0};
+};
+
+/** @brief Builds a CSR matrix from a stream of (row, col, cost) triplets.
+ *
+ * Triplets may arrive in any order and are gated on arrival, so rejected
+ * candidates take no memory. build() distributes the triplets into the CSR
+ * arrays by a counting sort over their rows without going through an
+ * Eigen::SparseMatrix. All buffers are kept across builds.
+ */
+template <typename T, typename I = Eigen::Index>
+struct CompressedSparseRowBuilder {
+  explicit CompressedSparseRowBuilder(
+      const CompressedSparseRowBuilderOptions &options = {}) noexcept;
+
+  /** @brief Starts a new rows x cols matrix and drops all triplets.
+   */
+  void reset(Eigen::Index rows, Eigen::Index cols);
+
+  /** @brief Adds a candidate entry, unless its cost exceeds the gate.
+   */
+  void add(Eigen::Index row, Eigen::Index col, T cost);
+
+  /** @brief Writes the matrix of all added triplets to csr.
+   *
+   * Columns are sorted within each row, so a matrix built from the triplets
+   * of an Eigen::SparseMatrix has the same CSR arrays.
+   */
+  void build(CompressedSparseRowMatrix<T, I> &csr);
+
+  CompressedSparseRowBuilderOptions options{};
+  Eigen::Index rows{};
+  Eigen::Index cols{};
+  std::vector<I> row_ind{};
+  std::vector<Edge<T, I>> edges{};
+  std::vector<Edge<T, I>> sorted{};
+};
+
+namespace internal {
+
+/** @brief Appends the row of candidates [first, last) to the end of csr.
+ *
+ * Sorts the candidates by column, merges duplicates and keeps the top_k
+ * cheapest ones. csr.row_ptr[r] must hold the end of the previous row.
+ */
+template <typename T, typename I, typename It>
+void append_row(It first, It last, Eigen::Index top_k,
+                CompressedSparseRowMatrix<T, I> &csr, Eigen::Index r) {
+  const auto by_column = [](const auto &lhs, const auto &rhs) {
+    return (lhs.col < rhs.col) ||
+           ((lhs.col == rhs.col) && (lhs.cost < rhs.cost));
+  };
+  const auto by_cost = [](const auto &lhs, const auto &rhs) {
+    return (lhs.cost < rhs.cost) ||
+           ((lhs.cost == rhs.cost) && (lhs.col < rhs.col));
+  };
+
+  std::sort(first, last, by_column);
+  last = std::unique(first, last, [](const auto &lhs, const auto &rhs) {
+    return lhs.col == rhs.col;
+  });
+  if ((top_k > 0) && (std::distance(first, last) > top_k)) {
+    std::nth_element(first, first + top_k - 1, last, by_cost);
+    last = first + top_k;
+    std::sort(first, last, by_column);
+  }
+
+  auto t = static_cast<Eigen::Index>(csr.row_ptr[r]);
+  for (auto it = first; it != last; ++it) {
+    csr.col_ind[t] = it->col;
+    csr.val[t] = it->cost;
+    ++t;
+  }
+  csr.row_ptr[r + 1] = static_cast<I>(t);
+}
+
+} // namespace internal
+
+/** @brief Builds a CSR matrix row by row from a candidate callback.
+ *
+ * For each row r in order, candidates(r, emit) is called and reports the
+ * candidate entries of row r by calling emit(col, cost). Candidates are
+ * gated as they are emitted, and each row is sorted, merged and cut to the
+ * top_k cheapest entries before it is appended to the CSR arrays. Only one
+ * row of candidates is buffered at a time, in scratch.
+ */
+template <typename T, typename I, typename F>
+void build_compressed_sparse_row_matrix(
+    Eigen::Index rows, Eigen::Index cols, F &&candidates,
+    CompressedSparseRowMatrix<T, I> &csr, std::vector<Edge<T, I>> &scratch,
+    const CompressedSparseRowBuilderOptions &options = {}) {
+  csr.rows = rows;
+  csr.cols = cols;
+  csr.row_ptr.resize(rows + 1);
+  csr.row_ptr[0] = 0;
+  csr.col_ind.clear();
+  csr.val.clear();
+
+  const auto emit = [&scratch, gate = options.gate](Eigen::Index col,
+                                                    T cost) {
+    if (static_cast<double>(cost) <= gate) {
+      scratch.push_back({static_cast<I>(col), cost});
+    }
+  };
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    scratch.clear();
+    candidates(r, emit);
+    const auto kept =
+        (options.top_k > 0)
+            ? std::min(scratch.size(), static_cast<std::size_t>(options.top_k))
+            : scratch.size();
+    const auto end = static_cast<std::size_t>(csr.row_ptr[r]) + kept;
+    if (csr.col_ind.size() < end) {
+      csr.col_ind.resize(end);
+      csr.val.resize(end);
+    }
+    internal::append_row(scratch.begin(), scratch.end(), options.top_k, csr,
+                         r);
+  }
+  csr.col_ind.resize(csr.row_ptr[rows]);
+  csr.val.resize(csr.row_ptr[rows]);
+}
+
+template <typename T, typename I>
+CompressedSparseRowBuilder<T, I>::CompressedSparseRowBuilder(
+    const CompressedSparseRowBuilderOptions &options) noexcept
+    : options{options} {}
+
+template <typename T, typename I>
+void CompressedSparseRowBuilder<T, I>::reset(Eigen::Index rows,
+                                             Eigen::Index cols) {
+  this->rows = rows;
+  this->cols = cols;
+  row_ind.clear();
+  edges.clear();
+}
+
+template <typename T, typename I>
+void CompressedSparseRowBuilder<T, I>::add(Eigen::Index row, Eigen::Index col,
+                                           T cost) {
+  if (static_cast<double>(cost) <= options.gate) {
+    row_ind.push_back(static_cast<I>(row));
+    edges.push_back({static_cast<I>(col), cost});
+  }
+}
+
+template <typename T, typename I>
+void CompressedSparseRowBuilder<T, I>::build(
+    CompressedSparseRowMatrix<T, I> &csr) {
+  csr.rows = rows;
+  csr.cols = cols;
+  csr.row_ptr.assign(rows + 1, I{0});
+  for (const auto r : row_ind) {
+    ++csr.row_ptr[r + 1];
+  }
+  std::partial_sum(csr.row_ptr.begin(), csr.row_ptr.end(),
+                   csr.row_ptr.begin());
+
+  // row_ptr[r] is used as insertion cursor and ends up at row_ptr[r + 1].
+  sorted.resize(edges.size());
+  for (std::size_t k = 0; k < edges.size(); ++k) {
+    sorted[csr.row_ptr[row_ind[k]]++] = edges[k];
+  }
+  std::copy_backward(csr.row_ptr.begin(), std::prev(csr.row_ptr.end()),
+                     csr.row_ptr.end());
+  csr.row_ptr[0] = 0;
+
+  // Rows only shrink when merged or cut, so csr never outgrows the triplets.
+  csr.col_ind.resize(sorted.size());
+  csr.val.resize(sorted.size());
+  auto begin = std::size_t{0};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    const auto end = static_cast<std::size_t>(csr.row_ptr[r + 1]);
+    internal::append_row(sorted.begin() + begin, sorted.begin() + end,
+                         options.top_k, csr, r);
+    begin = end;
+  }
+  csr.col_ind.resize(csr.row_ptr[rows]);
+  csr.val.resize(csr.row_ptr[rows]);
+}
+
+} // namespace asap
+
+#endif
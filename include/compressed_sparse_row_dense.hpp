@@ -0,0 +1,326 @@
+#ifndef ASAP_COMPRESSED_SPARSE_ROW_DENSE_HPP
+#define ASAP_COMPRESSED_SPARSE_ROW_DENSE_HPP
+
+#include "compressed_sparse_row_matrix.hpp"
+#include "simd_kernels.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace asap {
+
+/** @brief Configures the conversion of a dense cost matrix into a CSR.
+ *
+ * Entries with a cost above gate are dropped. If top_k is positive, only the
+ * top_k cheapest remaining entries of each row are kept, ties are broken
+ * towards lower columns like in CompressedSparseRowBuilder.
+ *
+ * If vectorize is set, double costs are compacted with AVX2 or AVX-512
+ * kernels selected at runtime, which keep the same entries as the scalar
+ * loop. Blocks of rows are converted on num_threads threads, where 0 selects
+ * the number of hardware threads.
+ */
+struct DenseCompressedSparseRowOptions {
+  double gate{std::numeric_limits<double>::infinity()};
+  Eigen::Index top_k{0};
+  bool vectorize{true};
+  std::size_t num_threads{0};
+};
+
+namespace internal {
+
+/** @brief Per-thread buffers of the dense conversion.
+ *
+ * col_ind and val collect the kept entries of all row blocks the thread
+ * converted, of which the first size are in use. Column-major inputs are
+ * compacted column by column into the entry_* buffers of a block first.
+ * line holds a row or column segment of inputs that are not stored
+ * contiguously.
+ */
+template <typename T, typename I> struct DenseRowBlockScratch {
+  std::vector<I> col_ind{};
+  std::vector<T> val{};
+  std::size_t size{};
+  std::vector<I> entry_row{};
+  std::vector<I> entry_col{};
+  std::vector<T> entry_val{};
+  std::vector<I> row_count{};
+  std::vector<T> line{};
+  std::vector<Edge<T, I>> edges{};
+};
+
+} // namespace internal
+
+/** @brief Owns the thread pool and the per-thread buffers of the dense
+ * conversion.
+ *
+ * All buffers are kept across conversions, so converting matrices of
+ * similar shape and density does not touch the heap.
+ */
+template <typename T, typename I = Eigen::Index>
+struct DenseCompressedSparseRowWorkspace {
+  void reset(Eigen::Index rows, Eigen::Index cols, std::size_t num_threads);
+
+  std::unique_ptr<ThreadPool> pool{};
+  std::vector<internal::DenseRowBlockScratch<T, I>> scratch{};
+  std::vector<std::size_t> block_thread{};
+  std::vector<std::size_t> block_offset{};
+  Eigen::Index block_rows{};
+};
+
+template <typename T, typename I>
+void DenseCompressedSparseRowWorkspace<T, I>::reset(Eigen::Index rows,
+                                                    Eigen::Index cols,
+                                                    std::size_t num_threads) {
+  // Blocks of at least 4k costs amortize claiming them.
+  constexpr auto block_size = Eigen::Index{1} << 12;
+  internal::reset_thread_pool(pool, num_threads);
+  const auto threads = static_cast<Eigen::Index>(pool->size());
+  if (scratch.size() < pool->size()) {
+    scratch.resize(pool->size());
+  }
+  for (auto &s : scratch) {
+    s.size = 0;
+  }
+  block_rows =
+      (threads == 1)
+          ? std::max(rows, Eigen::Index{1})
+          : std::max((rows + 4 * threads - 1) / (4 * threads),
+                     std::max(block_size / std::max(cols, Eigen::Index{1}),
+                              Eigen::Index{1}));
+  const auto blocks =
+      static_cast<std::size_t>((rows + block_rows - 1) / block_rows);
+  block_thread.resize(blocks);
+  block_offset.resize(blocks);
+}
+
+namespace internal {
+
+/** @brief Grows the buffers to hold at least n entries.
+ */
+template <typename... Buffers>
+void reserve_entries(std::size_t n, Buffers &...buffers) {
+  const auto grow = [n](auto &buffer) {
+    if (buffer.size() < n) {
+      buffer.resize(std::max(n, 2 * buffer.size()));
+    }
+  };
+  (grow(buffers), ...);
+}
+
+/** @brief Cuts the m entries of a row, sorted by column, to the top_k
+ * cheapest ones and returns their number.
+ */
+template <typename T, typename I>
+Eigen::Index keep_top_k(I *kk, T *out, Eigen::Index m, Eigen::Index top_k,
+                        std::vector<Edge<T, I>> &edges) {
+  if ((top_k <= 0) || (m <= top_k)) {
+    return m;
+  }
+  edges.resize(m);
+  for (Eigen::Index t = 0; t < m; ++t) {
+    edges[t] = {kk[t], out[t]};
+  }
+  const auto by_cost = [](const auto &lhs, const auto &rhs) {
+    return (lhs.cost < rhs.cost) ||
+           ((lhs.cost == rhs.cost) && (lhs.col < rhs.col));
+  };
+  std::nth_element(edges.begin(), edges.begin() + top_k - 1, edges.end(),
+                   by_cost);
+  std::sort(edges.begin(), edges.begin() + top_k,
+            [](const auto &lhs, const auto &rhs) { return lhs.col < rhs.col; });
+  for (Eigen::Index t = 0; t < top_k; ++t) {
+    kk[t] = edges[t].col;
+    out[t] = edges[t].cost;
+  }
+  return top_k;
+}
+
+/** @brief Pointer to the costs of a row or column segment.
+ *
+ * Returns the segment in place if it is stored contiguously and evaluates it
+ * into line otherwise.
+ */
+template <typename Derived, typename T>
+const T *contiguous_segment(const Eigen::MatrixBase<Derived> &segment,
+                            std::vector<T> &line) {
+  if constexpr ((Derived::Flags & Eigen::DirectAccessBit) != 0) {
+    if (segment.innerStride() == 1) {
+      return segment.derived().data();
+    }
+  }
+  line.resize(segment.size());
+  Eigen::Map<Eigen::Matrix<T, Eigen::Dynamic, 1>>(line.data(),
+                                                   segment.size()) = segment;
+  return line.data();
+}
+
+/** @brief Appends rows [begin, end) of a row-major dense matrix to s.
+ */
+template <typename Derived, typename T, typename I>
+void gate_dense_rows(SimdLevel level, const Eigen::MatrixBase<Derived> &dense,
+                     Eigen::Index begin, Eigen::Index end,
+                     const DenseCompressedSparseRowOptions &options,
+                     DenseRowBlockScratch<T, I> &s, I *row_nnz) {
+  const auto cols = dense.cols();
+  for (auto r = begin; r < end; ++r) {
+    reserve_entries(s.size + static_cast<std::size_t>(cols), s.col_ind,
+                    s.val);
+    auto *kk = s.col_ind.data() + s.size;
+    auto *out = s.val.data() + s.size;
+    const auto *row = contiguous_segment(dense.row(r).transpose(), s.line);
+    const auto m = keep_top_k(
+        kk, out, gate_row(level, row, cols, options.gate, kk, out),
+        options.top_k, s.edges);
+    s.size += static_cast<std::size_t>(m);
+    row_nnz[r] = static_cast<I>(m);
+  }
+}
+
+/** @brief Appends rows [begin, end) of a column-major dense matrix to s.
+ *
+ * Compacts the segment of each column in turn, so the input is read along
+ * its storage order, and distributes the entries to their rows by a counting
+ * sort, which keeps them sorted by column.
+ */
+template <typename Derived, typename T, typename I>
+void gate_dense_columns(SimdLevel level,
+                        const Eigen::MatrixBase<Derived> &dense,
+                        Eigen::Index begin, Eigen::Index end,
+                        const DenseCompressedSparseRowOptions &options,
+                        DenseRowBlockScratch<T, I> &s, I *row_nnz) {
+  const auto n = end - begin;
+  auto m = std::size_t{0};
+  for (Eigen::Index c = 0; c < dense.cols(); ++c) {
+    reserve_entries(m + static_cast<std::size_t>(n), s.entry_row,
+                    s.entry_col, s.entry_val);
+    const auto *column =
+        contiguous_segment(dense.col(c).segment(begin, n), s.line);
+    const auto kept = gate_row(level, column, n, options.gate,
+                               s.entry_row.data() + m, s.entry_val.data() + m);
+    std::fill_n(s.entry_col.begin() + m, kept, static_cast<I>(c));
+    m += static_cast<std::size_t>(kept);
+  }
+
+  // row_count[k] is used as insertion cursor of row begin + k.
+  s.row_count.assign(n + 1, I{0});
+  for (std::size_t t = 0; t < m; ++t) {
+    ++s.row_count[s.entry_row[t] + 1];
+  }
+  std::partial_sum(s.row_count.begin(), s.row_count.end(),
+                   s.row_count.begin());
+  reserve_entries(s.size + m, s.col_ind, s.val);
+  auto *kk = s.col_ind.data() + s.size;
+  auto *out = s.val.data() + s.size;
+  for (std::size_t t = 0; t < m; ++t) {
+    const auto u = s.row_count[s.entry_row[t]]++;
+    kk[u] = s.entry_col[t];
+    out[u] = s.entry_val[t];
+  }
+
+  // Rows only shrink when cut, so they are moved forward in place.
+  auto first = I{0};
+  auto kept = I{0};
+  for (Eigen::Index k = 0; k < n; ++k) {
+    const auto last = s.row_count[k];
+    if (kept != first) {
+      std::copy(kk + first, kk + last, kk + kept);
+      std::copy(out + first, out + last, out + kept);
+    }
+    const auto nnz = static_cast<I>(keep_top_k(
+        kk + kept, out + kept, last - first, options.top_k, s.edges));
+    row_nnz[begin + k] = nnz;
+    kept += nnz;
+    first = last;
+  }
+  s.size += static_cast<std::size_t>(kept);
+}
+
+} // namespace internal
+
+/** @brief Converts a dense cost matrix into a CSR matrix.
+ *
+ * Accepts any dense Eigen expression, including Eigen::Ref and Eigen::Map.
+ * Each row is compacted to the entries within the gate and cut to the top_k
+ * cheapest ones. Blocks of rows are converted in parallel into per-thread
+ * buffers, which are then copied to their place in csr once the row
+ * pointers are known, so every dense entry is read exactly once. Row-major
+ * inputs are compacted row by row, column-major inputs column by column
+ * within a block. The result does not depend on the number of threads.
+ */
+template <typename Derived, typename T, typename I>
+void build_compressed_sparse_row_matrix(
+    const Eigen::MatrixBase<Derived> &dense,
+    CompressedSparseRowMatrix<T, I> &csr,
+    DenseCompressedSparseRowWorkspace<T, I> &ws,
+    const DenseCompressedSparseRowOptions &options = {}) {
+  static_assert(std::is_same_v<typename Derived::Scalar, T>,
+                "dense and csr must have the same scalar type");
+  const auto rows = dense.rows();
+  const auto cols = dense.cols();
+  ws.reset(rows, cols, options.num_threads);
+  csr.rows = rows;
+  csr.cols = cols;
+  csr.row_ptr.resize(rows + 1);
+  csr.row_ptr[0] = 0;
+
+  const auto level = options.vectorize ? internal::detect_simd_level()
+                                       : internal::SimdLevel::Scalar;
+  const auto block_rows = static_cast<std::size_t>(ws.block_rows);
+  ws.pool->parallel_for(
+      static_cast<std::size_t>(rows), block_rows,
+      [&](std::size_t begin, std::size_t end, std::size_t thread) {
+        auto &s = ws.scratch[thread];
+        ws.block_thread[begin / block_rows] = thread;
+        ws.block_offset[begin / block_rows] = s.size;
+        if constexpr (static_cast<bool>(Derived::IsRowMajor)) {
+          internal::gate_dense_rows(level, dense,
+                                    static_cast<Eigen::Index>(begin),
+                                    static_cast<Eigen::Index>(end), options,
+                                    s, csr.row_ptr.data() + 1);
+        } else {
+          internal::gate_dense_columns(level, dense,
+                                       static_cast<Eigen::Index>(begin),
+                                       static_cast<Eigen::Index>(end),
+                                       options, s, csr.row_ptr.data() + 1);
+        }
+      });
+  std::partial_sum(csr.row_ptr.begin(), csr.row_ptr.end(),
+                   csr.row_ptr.begin());
+
+  // A single block is complete in the buffers of the caller, which are
+  // swapped with csr instead of copied.
+  const auto nnz = static_cast<std::size_t>(csr.row_ptr[rows]);
+  if (ws.block_thread.size() == 1) {
+    auto &s = ws.scratch[ws.block_thread[0]];
+    std::swap(s.col_ind, csr.col_ind);
+    std::swap(s.val, csr.val);
+    csr.col_ind.resize(nnz);
+    csr.val.resize(nnz);
+    return;
+  }
+  csr.col_ind.resize(nnz);
+  csr.val.resize(nnz);
+  ws.pool->parallel_for(
+      ws.block_thread.size(), 1,
+      [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (auto b = begin; b < end; ++b) {
+          const auto &s = ws.scratch[ws.block_thread[b]];
+          const auto r = b * block_rows;
+          const auto r_end =
+              std::min(r + block_rows, static_cast<std::size_t>(rows));
+          const auto first = static_cast<std::size_t>(csr.row_ptr[r]);
+          const auto n = static_cast<std::size_t>(csr.row_ptr[r_end]) - first;
+          const auto offset = ws.block_offset[b];
+          std::copy_n(s.col_ind.begin() + offset, n,
+                      csr.col_ind.begin() + first);
+          std::copy_n(s.val.begin() + offset, n, csr.val.begin() + first);
+        }
+      });
+}
+
+} // namespace asap
+
+#endif
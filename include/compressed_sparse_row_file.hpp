@@ -0,0 +1,560 @@
+#ifndef ASAP_COMPRESSED_SPARSE_ROW_FILE_HPP
+#define ASAP_COMPRESSED_SPARSE_ROW_FILE_HPP
+
+#include "compressed_sparse_row_matrix.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace asap {
+
+/** @brief Tags of the value and index types stored in a CSR file.
+ */
+enum class CompressedSparseRowFileType : std::uint32_t {
+  Unknown = 0,
+  Float32 = 1,
+  Float64 = 2,
+  Int32 = 3,
+  Int64 = 4
+};
+
+[[nodiscard]] constexpr const char *
+to_string(CompressedSparseRowFileType type) noexcept {
+  switch (type) {
+  case CompressedSparseRowFileType::Unknown:
+    return "unknown";
+  case CompressedSparseRowFileType::Float32:
+    return "f32";
+  case CompressedSparseRowFileType::Float64:
+    return "f64";
+  case CompressedSparseRowFileType::Int32:
+    return "i32";
+  case CompressedSparseRowFileType::Int64:
+    return "i64";
+  }
+  return "";
+}
+
+/** @brief Outcome of writing, reading or mapping a CSR file.
+ *
+ * ByteOrderMismatch marks a file written on a machine of the other byte
+ * order, TypeMismatch a file whose value or index type differs from the
+ * requested one. Corrupt marks row pointers or column indices that do not
+ * describe a valid matrix of the header's shape.
+ */
+enum class CompressedSparseRowFileStatus {
+  Ok,
+  OpenFailed,
+  IoFailed,
+  BadMagic,
+  UnsupportedVersion,
+  ByteOrderMismatch,
+  TypeMismatch,
+  Truncated,
+  Corrupt
+};
+
+[[nodiscard]] constexpr const char *
+to_string(CompressedSparseRowFileStatus status) noexcept {
+  switch (status) {
+  case CompressedSparseRowFileStatus::Ok:
+    return "ok";
+  case CompressedSparseRowFileStatus::OpenFailed:
+    return "open_failed";
+  case CompressedSparseRowFileStatus::IoFailed:
+    return "io_failed";
+  case CompressedSparseRowFileStatus::BadMagic:
+    return "bad_magic";
+  case CompressedSparseRowFileStatus::UnsupportedVersion:
+    return "unsupported_version";
+  case CompressedSparseRowFileStatus::ByteOrderMismatch:
+    return "byte_order_mismatch";
+  case CompressedSparseRowFileStatus::TypeMismatch:
+    return "type_mismatch";
+  case CompressedSparseRowFileStatus::Truncated:
+    return "truncated";
+  case CompressedSparseRowFileStatus::Corrupt:
+    return "corrupt";
+  }
+  return "";
+}
+
+/** @brief The 64 byte header at the start of a CSR file.
+ *
+ * The header is followed by the arrays row_ptr of rows + 1 indices, col_ind
+ * of nnz indices and val of nnz values, each starting at the next multiple
+ * of 64 bytes and padded with zeros. row_ptr starts at 0. All fields and
+ * array entries are stored in the byte order of the writer, which byte_order
+ * records as the number 0x01020304. Mapping the file then needs no decoding
+ * and every array is aligned for its type and to cache lines.
+ */
+struct CompressedSparseRowFileHeader {
+  static constexpr char magic_bytes[8] = {'A', 'S', 'A', 'P',
+                                          'C', 'S', 'R', '\0'};
+  static constexpr std::uint32_t current_version = 1;
+  static constexpr std::uint32_t native_byte_order = 0x01020304;
+  static constexpr std::uint64_t alignment = 64;
+
+  [[nodiscard]] std::uint64_t row_ptr_offset() const noexcept;
+  [[nodiscard]] std::uint64_t col_ind_offset() const noexcept;
+  [[nodiscard]] std::uint64_t val_offset() const noexcept;
+  [[nodiscard]] std::uint64_t file_size() const noexcept;
+
+  char magic[8]{};
+  std::uint32_t version{};
+  std::uint32_t byte_order{};
+  CompressedSparseRowFileType value_type{};
+  CompressedSparseRowFileType index_type{};
+  std::uint64_t rows{};
+  std::uint64_t cols{};
+  std::uint64_t nnz{};
+  std::uint64_t reserved[2]{};
+};
+
+static_assert(sizeof(CompressedSparseRowFileHeader) == 64);
+static_assert(std::is_trivially_copyable_v<CompressedSparseRowFileHeader>);
+
+/** @brief Type tag of T, Unknown if T cannot be stored in a CSR file.
+ */
+template <typename T>
+[[nodiscard]] constexpr CompressedSparseRowFileType
+compressed_sparse_row_file_type() noexcept {
+  if constexpr (std::is_floating_point_v<T> && sizeof(T) == 4) {
+    return CompressedSparseRowFileType::Float32;
+  } else if constexpr (std::is_floating_point_v<T> && sizeof(T) == 8) {
+    return CompressedSparseRowFileType::Float64;
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> &&
+                       sizeof(T) == 4) {
+    return CompressedSparseRowFileType::Int32;
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> &&
+                       sizeof(T) == 8) {
+    return CompressedSparseRowFileType::Int64;
+  } else {
+    return CompressedSparseRowFileType::Unknown;
+  }
+}
+
+/** @brief Writes csr to os in the CSR file format.
+ *
+ * The row pointers are rebased to start at 0, so views of a block of rows
+ * can be written. os must be opened in binary mode.
+ */
+template <typename T, typename I>
+[[nodiscard]] CompressedSparseRowFileStatus write_compressed_sparse_row_file(
+    std::ostream &os, const CompressedSparseRowMatrixView<T, I> &csr);
+
+template <typename T, typename I>
+[[nodiscard]] CompressedSparseRowFileStatus write_compressed_sparse_row_file(
+    const std::string &path, const CompressedSparseRowMatrixView<T, I> &csr);
+
+/** @brief Writes the Eigen sparse matrix sm to path in the CSR file format.
+ *
+ * Column-major matrices are converted to CSR first.
+ */
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<is_sparse_matrix_v<SparseMatrixT>,
+                               CompressedSparseRowFileStatus>
+write_compressed_sparse_row_file(const std::string &path,
+                                 const SparseMatrixT &sm);
+
+/** @brief Reads and checks the header of the CSR file at path.
+ *
+ * Callers that do not know the types of a file read its header first and
+ * dispatch on value_type and index_type.
+ */
+[[nodiscard]] inline CompressedSparseRowFileStatus
+read_compressed_sparse_row_file_header(const std::string &path,
+                                       CompressedSparseRowFileHeader &header);
+
+/** @brief Read-only memory mapping of a CSR file.
+ *
+ * view() points straight into the mapping, so a file is handed to the
+ * solvers without reading or copying its arrays. Pages are loaded by the
+ * operating system as the solver first touches them and are shared with the
+ * page cache, which makes loading a cached file almost free. The mapping is
+ * released by close() or the destructor. T and I must match the type tags of
+ * the file.
+ */
+template <typename T, typename I = Eigen::Index>
+class MappedCompressedSparseRowMatrix {
+public:
+  static_assert(compressed_sparse_row_file_type<T>() !=
+                    CompressedSparseRowFileType::Unknown,
+                "T must be a 32 or 64 bit floating point or signed integer");
+  static_assert(std::is_integral_v<I> &&
+                    (compressed_sparse_row_file_type<I>() !=
+                     CompressedSparseRowFileType::Unknown),
+                "I must be a 32 or 64 bit signed integer");
+
+  MappedCompressedSparseRowMatrix() = default;
+  MappedCompressedSparseRowMatrix(const MappedCompressedSparseRowMatrix &) =
+      delete;
+  MappedCompressedSparseRowMatrix &
+  operator=(const MappedCompressedSparseRowMatrix &) = delete;
+  MappedCompressedSparseRowMatrix(
+      MappedCompressedSparseRowMatrix &&other) noexcept;
+  MappedCompressedSparseRowMatrix &
+  operator=(MappedCompressedSparseRowMatrix &&other) noexcept;
+  ~MappedCompressedSparseRowMatrix() { close(); }
+
+  /** @brief Maps the CSR file at path, releasing any previous mapping.
+   *
+   * The header and the file size are always checked. If verify is set, the
+   * row pointers and column indices are checked as well, which reads the
+   * index arrays once. Leave it cleared for trusted files to map them in
+   * constant time.
+   */
+  [[nodiscard]] CompressedSparseRowFileStatus open(const std::string &path,
+                                                   bool verify = true);
+
+  /** @brief Releases the mapping, after which the view is empty.
+   */
+  void close() noexcept;
+
+  [[nodiscard]] bool is_open() const noexcept { return data_ != nullptr; }
+
+  [[nodiscard]] const CompressedSparseRowFileHeader &header() const noexcept {
+    return header_;
+  }
+
+  /** @brief Non-owning view of the mapped matrix, which the solvers accept.
+   *
+   * The view is valid until the mapping is released.
+   */
+  [[nodiscard]] CompressedSparseRowMatrixView<T, I> view() const noexcept;
+
+private:
+  [[nodiscard]] bool verify_indices() const noexcept;
+
+  void *data_{};
+  std::size_t size_{};
+  CompressedSparseRowFileHeader header_{};
+};
+
+namespace internal {
+
+[[nodiscard]] constexpr std::uint64_t
+align_compressed_sparse_row_file_offset(std::uint64_t offset) noexcept {
+  constexpr auto a = CompressedSparseRowFileHeader::alignment;
+  return (offset + a - 1) / a * a;
+}
+
+/** @brief Writes zeros to os until offset is aligned.
+ */
+inline void pad_compressed_sparse_row_file(std::ostream &os,
+                                           std::uint64_t &offset) {
+  static constexpr char zeros[CompressedSparseRowFileHeader::alignment]{};
+  const auto aligned = align_compressed_sparse_row_file_offset(offset);
+  os.write(zeros, static_cast<std::streamsize>(aligned - offset));
+  offset = aligned;
+}
+
+template <typename T>
+void write_compressed_sparse_row_file_array(std::ostream &os, const T *data,
+                                            std::uint64_t size,
+                                            std::uint64_t &offset) {
+  os.write(reinterpret_cast<const char *>(data),
+           static_cast<std::streamsize>(size * sizeof(T)));
+  offset += size * sizeof(T);
+  pad_compressed_sparse_row_file(os, offset);
+}
+
+/** @brief Checks the fields of header that do not depend on T and I.
+ */
+[[nodiscard]] inline CompressedSparseRowFileStatus
+check_compressed_sparse_row_file_header(
+    const CompressedSparseRowFileHeader &header) noexcept {
+  if (std::memcmp(header.magic, CompressedSparseRowFileHeader::magic_bytes,
+                  sizeof(header.magic)) != 0) {
+    return CompressedSparseRowFileStatus::BadMagic;
+  }
+  if (header.byte_order != CompressedSparseRowFileHeader::native_byte_order) {
+    return header.byte_order == 0x04030201
+               ? CompressedSparseRowFileStatus::ByteOrderMismatch
+               : CompressedSparseRowFileStatus::Corrupt;
+  }
+  if (header.version != CompressedSparseRowFileHeader::current_version) {
+    return CompressedSparseRowFileStatus::UnsupportedVersion;
+  }
+  const auto is_index = [](CompressedSparseRowFileType type) {
+    return (type == CompressedSparseRowFileType::Int32) ||
+           (type == CompressedSparseRowFileType::Int64);
+  };
+  if ((header.value_type == CompressedSparseRowFileType::Unknown) ||
+      (header.value_type > CompressedSparseRowFileType::Int64) ||
+      !is_index(header.index_type)) {
+    return CompressedSparseRowFileStatus::Corrupt;
+  }
+  return CompressedSparseRowFileStatus::Ok;
+}
+
+} // namespace internal
+
+inline std::uint64_t
+CompressedSparseRowFileHeader::row_ptr_offset() const noexcept {
+  return sizeof(CompressedSparseRowFileHeader);
+}
+
+inline std::uint64_t
+CompressedSparseRowFileHeader::col_ind_offset() const noexcept {
+  const auto index_size = index_type == CompressedSparseRowFileType::Int32
+                              ? std::uint64_t{4}
+                              : std::uint64_t{8};
+  return internal::align_compressed_sparse_row_file_offset(
+      row_ptr_offset() + (rows + 1) * index_size);
+}
+
+inline std::uint64_t
+CompressedSparseRowFileHeader::val_offset() const noexcept {
+  const auto index_size = index_type == CompressedSparseRowFileType::Int32
+                              ? std::uint64_t{4}
+                              : std::uint64_t{8};
+  return internal::align_compressed_sparse_row_file_offset(col_ind_offset() +
+                                                           nnz * index_size);
+}
+
+inline std::uint64_t
+CompressedSparseRowFileHeader::file_size() const noexcept {
+  const auto value_size = (value_type == CompressedSparseRowFileType::Float32 ||
+                           value_type == CompressedSparseRowFileType::Int32)
+                              ? std::uint64_t{4}
+                              : std::uint64_t{8};
+  return internal::align_compressed_sparse_row_file_offset(val_offset() +
+                                                           nnz * value_size);
+}
+
+template <typename T, typename I>
+CompressedSparseRowFileStatus write_compressed_sparse_row_file(
+    std::ostream &os, const CompressedSparseRowMatrixView<T, I> &csr) {
+  static_assert(compressed_sparse_row_file_type<T>() !=
+                    CompressedSparseRowFileType::Unknown,
+                "T must be a 32 or 64 bit floating point or signed integer");
+  static_assert(compressed_sparse_row_file_type<I>() !=
+                    CompressedSparseRowFileType::Unknown,
+                "I must be a 32 or 64 bit signed integer");
+
+  const auto base = csr.row_ptr[0];
+  auto header = CompressedSparseRowFileHeader{};
+  std::memcpy(header.magic, CompressedSparseRowFileHeader::magic_bytes,
+              sizeof(header.magic));
+  header.version = CompressedSparseRowFileHeader::current_version;
+  header.byte_order = CompressedSparseRowFileHeader::native_byte_order;
+  header.value_type = compressed_sparse_row_file_type<T>();
+  header.index_type = compressed_sparse_row_file_type<I>();
+  header.rows = static_cast<std::uint64_t>(csr.rows);
+  header.cols = static_cast<std::uint64_t>(csr.cols);
+  header.nnz = static_cast<std::uint64_t>(csr.row_ptr[csr.rows] - base);
+
+  auto offset = std::uint64_t{sizeof(header)};
+  os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  if (base == 0) {
+    internal::write_compressed_sparse_row_file_array(os, csr.row_ptr,
+                                                     header.rows + 1, offset);
+  } else {
+    // Rebase in blocks, which bounds the scratch buffer.
+    constexpr auto block = Eigen::Index{1024};
+    I rebased[block];
+    for (Eigen::Index r = 0; r <= csr.rows; r += block) {
+      const auto end = std::min(r + block, csr.rows + 1);
+      for (auto s = r; s < end; ++s) {
+        rebased[s - r] = static_cast<I>(csr.row_ptr[s] - base);
+      }
+      os.write(reinterpret_cast<const char *>(rebased),
+               static_cast<std::streamsize>((end - r) * sizeof(I)));
+    }
+    offset += (header.rows + 1) * sizeof(I);
+    internal::pad_compressed_sparse_row_file(os, offset);
+  }
+  internal::write_compressed_sparse_row_file_array(os, csr.col_ind + base,
+                                                   header.nnz, offset);
+  internal::write_compressed_sparse_row_file_array(os, csr.val + base,
+                                                   header.nnz, offset);
+
+  return os ? CompressedSparseRowFileStatus::Ok
+            : CompressedSparseRowFileStatus::IoFailed;
+}
+
+template <typename T, typename I>
+CompressedSparseRowFileStatus write_compressed_sparse_row_file(
+    const std::string &path, const CompressedSparseRowMatrixView<T, I> &csr) {
+  auto os = std::ofstream(path, std::ios::binary | std::ios::trunc);
+  if (!os) {
+    return CompressedSparseRowFileStatus::OpenFailed;
+  }
+  const auto status = write_compressed_sparse_row_file(os, csr);
+  os.close();
+  if ((status == CompressedSparseRowFileStatus::Ok) && !os) {
+    return CompressedSparseRowFileStatus::IoFailed;
+  }
+  return status;
+}
+
+template <typename SparseMatrixT>
+std::enable_if_t<is_sparse_matrix_v<SparseMatrixT>,
+                 CompressedSparseRowFileStatus>
+write_compressed_sparse_row_file(const std::string &path,
+                                 const SparseMatrixT &sm) {
+  auto csr = CompressedSparseRowMatrix<typename SparseMatrixT::Scalar,
+                                       typename SparseMatrixT::StorageIndex>{};
+  csr.assign(sm);
+  return write_compressed_sparse_row_file(path, csr.view());
+}
+
+inline CompressedSparseRowFileStatus
+read_compressed_sparse_row_file_header(const std::string &path,
+                                       CompressedSparseRowFileHeader &header) {
+  auto is = std::ifstream(path, std::ios::binary);
+  if (!is) {
+    return CompressedSparseRowFileStatus::OpenFailed;
+  }
+  if (!is.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return CompressedSparseRowFileStatus::Truncated;
+  }
+  return internal::check_compressed_sparse_row_file_header(header);
+}
+
+template <typename T, typename I>
+MappedCompressedSparseRowMatrix<T, I>::MappedCompressedSparseRowMatrix(
+    MappedCompressedSparseRowMatrix &&other) noexcept
+    : data_{other.data_}, size_{other.size_}, header_{other.header_} {
+  other.data_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename T, typename I>
+MappedCompressedSparseRowMatrix<T, I> &
+MappedCompressedSparseRowMatrix<T, I>::operator=(
+    MappedCompressedSparseRowMatrix &&other) noexcept {
+  if (this != &other) {
+    close();
+    data_ = other.data_;
+    size_ = other.size_;
+    header_ = other.header_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+template <typename T, typename I>
+CompressedSparseRowFileStatus
+MappedCompressedSparseRowMatrix<T, I>::open(const std::string &path,
+                                            bool verify) {
+  close();
+
+  const auto fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return CompressedSparseRowFileStatus::OpenFailed;
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    return CompressedSparseRowFileStatus::IoFailed;
+  }
+  const auto size = static_cast<std::uint64_t>(st.st_size);
+  if (size < sizeof(CompressedSparseRowFileHeader)) {
+    ::close(fd);
+    return CompressedSparseRowFileStatus::Truncated;
+  }
+  auto *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return CompressedSparseRowFileStatus::IoFailed;
+  }
+  data_ = data;
+  size_ = size;
+  std::memcpy(&header_, data_, sizeof(header_));
+
+  auto status = internal::check_compressed_sparse_row_file_header(header_);
+  if ((status == CompressedSparseRowFileStatus::Ok) &&
+      ((header_.value_type != compressed_sparse_row_file_type<T>()) ||
+       (header_.index_type != compressed_sparse_row_file_type<I>()))) {
+    status = CompressedSparseRowFileStatus::TypeMismatch;
+  }
+  constexpr auto max_index =
+      static_cast<std::uint64_t>(std::numeric_limits<I>::max());
+  if ((status == CompressedSparseRowFileStatus::Ok) &&
+      ((header_.rows >= max_index) || (header_.cols > max_index) ||
+       (header_.nnz > max_index))) {
+    status = CompressedSparseRowFileStatus::Corrupt;
+  }
+  // Bound the array lengths by the mapping before the offsets are computed,
+  // so crafted counts cannot wrap around in their byte sizes.
+  if ((status == CompressedSparseRowFileStatus::Ok) &&
+      ((header_.rows + 1 > size / sizeof(I)) ||
+       (header_.nnz > size / std::max(sizeof(I), sizeof(T))))) {
+    status = CompressedSparseRowFileStatus::Truncated;
+  }
+  if ((status == CompressedSparseRowFileStatus::Ok) &&
+      (header_.file_size() > size)) {
+    status = CompressedSparseRowFileStatus::Truncated;
+  }
+  if ((status == CompressedSparseRowFileStatus::Ok) && verify &&
+      !verify_indices()) {
+    status = CompressedSparseRowFileStatus::Corrupt;
+  }
+  if (status != CompressedSparseRowFileStatus::Ok) {
+    close();
+  }
+  return status;
+}
+
+template <typename T, typename I>
+void MappedCompressedSparseRowMatrix<T, I>::close() noexcept {
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  header_ = CompressedSparseRowFileHeader{};
+}
+
+template <typename T, typename I>
+CompressedSparseRowMatrixView<T, I>
+MappedCompressedSparseRowMatrix<T, I>::view() const noexcept {
+  if (data_ == nullptr) {
+    static constexpr I empty_row_ptr[1]{};
+    return {nullptr, nullptr, empty_row_ptr, 0, 0};
+  }
+  const auto *bytes = static_cast<const char *>(data_);
+  return {reinterpret_cast<const T *>(bytes + header_.val_offset()),
+          reinterpret_cast<const I *>(bytes + header_.col_ind_offset()),
+          reinterpret_cast<const I *>(bytes + header_.row_ptr_offset()),
+          static_cast<Eigen::Index>(header_.rows),
+          static_cast<Eigen::Index>(header_.cols)};
+}
+
+template <typename T, typename I>
+bool MappedCompressedSparseRowMatrix<T, I>::verify_indices() const noexcept {
+  const auto csr = view();
+  const auto nnz = static_cast<I>(header_.nnz);
+  const auto cols = static_cast<I>(header_.cols);
+  if ((csr.row_ptr[0] != 0) || (csr.row_ptr[csr.rows] != nnz)) {
+    return false;
+  }
+  for (Eigen::Index r = 0; r < csr.rows; ++r) {
+    if (csr.row_ptr[r] > csr.row_ptr[r + 1]) {
+      return false;
+    }
+  }
+  auto out_of_range = false;
+  for (I t = 0; t < nnz; ++t) {
+    out_of_range |= (csr.col_ind[t] < 0) || (csr.col_ind[t] >= cols);
+  }
+  return !out_of_range;
+}
+
+} // namespace asap
+
+#endif
@@ -2,47 +2,240 @@
 #define ASAP_COMPRESSED_SPARSE_ROW_MATRIX_HPP
 
 #include "common.hpp"
+#include "compressed_sparse_row_matrix_view.hpp"
+#include "interleaved_compressed_sparse_row_matrix.hpp"
 #include "sparse_matrix_traits.hpp"
 
 namespace asap {
 
-template <typename T> struct CompressedSparseRowMatrix {
+/** @brief Owning CSR matrix with values of type T and indices of type I.
+ *
+ * A 32-bit index type halves the memory traffic of col_ind and row_ptr and
+ * suffices for matrices with less than 2^31 non-zeros. All arrays are
+ * allocated by A, rebound to their element type.
+ */
+template <typename T, typename I = Eigen::Index,
+          typename A = std::allocator<T>>
+struct CompressedSparseRowMatrix {
+  CompressedSparseRowMatrix() = default;
+
+  explicit CompressedSparseRowMatrix(const A &alloc) noexcept;
+
   explicit CompressedSparseRowMatrix(
       const Eigen::SparseMatrix<T, Eigen::RowMajor> &sm) noexcept;
 
   explicit CompressedSparseRowMatrix(
       Eigen::SparseMatrix<T, Eigen::RowMajor> &&sm) noexcept;
 
-  std::vector<T> val{};
-  std::vector<Eigen::Index> col_ind{};
-  std::vector<Eigen::Index> row_ptr{};
+  /** @brief Overwrites the matrix with the entries of sm.
+   *
+   * Existing buffers are reused and only grow if sm has more rows or non-zeros
+   * than any previously assigned matrix. Column-major inputs are converted by
+   * a counting sort over their row indices.
+   */
+  template <int Options>
+  void assign(const Eigen::SparseMatrix<T, Options> &sm);
+
+  /** @brief Overwrites the matrix with the entries of the transpose of sm.
+   *
+   * Row-major inputs are transposed by a counting sort over their column
+   * indices, column-major inputs are copied. Neither allocates once the
+   * buffers are large enough.
+   */
+  template <int Options>
+  void assign_transpose(const Eigen::SparseMatrix<T, Options> &sm);
+
+  /** @brief Overwrites the matrix with the entries of the transpose of csr.
+   */
+  template <typename J>
+  void assign_transpose(const CompressedSparseRowMatrixView<T, J> &csr);
+
+  /** @brief Overwrites the matrix with the entries of the transpose of csr.
+   */
+  template <typename J>
+  void
+  assign_transpose(const InterleavedCompressedSparseRowMatrixView<T, J> &csr);
+
+  /** @brief Non-owning view of the matrix, which the solvers accept.
+   */
+  [[nodiscard]] CompressedSparseRowMatrixView<T, I> view() const noexcept;
+
+  using Scalar = T;
+  using StorageIndex = I;
+  using allocator_type = A;
+
+  internal::rebind_vector_t<T, A> val{};
+  internal::rebind_vector_t<I, A> col_ind{};
+  internal::rebind_vector_t<I, A> row_ptr{};
   Eigen::Index rows{};
   Eigen::Index cols{};
+
+private:
+  template <int Options>
+  void assign_storage(const Eigen::SparseMatrix<T, Options> &sm);
+
+  template <int Options>
+  void assign_storage_transpose(const Eigen::SparseMatrix<T, Options> &sm);
+
+  template <typename ViewT> void assign_view_transpose(const ViewT &csr);
 };
 
-template <typename T>
-CompressedSparseRowMatrix<T>::CompressedSparseRowMatrix(
+template <typename T, typename I, typename A>
+CompressedSparseRowMatrix<T, I, A>::CompressedSparseRowMatrix(
+    const A &alloc) noexcept
+    : val{alloc}, col_ind{alloc}, row_ptr{alloc} {}
+
+template <typename T, typename I, typename A>
+CompressedSparseRowMatrix<T, I, A>::CompressedSparseRowMatrix(
     const Eigen::SparseMatrix<T, Eigen::RowMajor> &sm) noexcept
     : val{sm.valuePtr(), sm.valuePtr() + sm.nonZeros()},
       col_ind{sm.innerIndexPtr(), sm.innerIndexPtr() + sm.nonZeros()},
       row_ptr{sm.outerIndexPtr(), sm.outerIndexPtr() + sm.outerSize()},
       rows{sm.rows()}, cols{sm.cols()} {
-  row_ptr.push_back(val.size());
+  row_ptr.push_back(static_cast<I>(val.size()));
 }
 
-template <typename T>
-CompressedSparseRowMatrix<T>::CompressedSparseRowMatrix(
+template <typename T, typename I, typename A>
+CompressedSparseRowMatrix<T, I, A>::CompressedSparseRowMatrix(
     Eigen::SparseMatrix<T, Eigen::RowMajor> &&sm) noexcept
     : val{sm.valuePtr(), sm.valuePtr() + sm.nonZeros()},
       col_ind{sm.innerIndexPtr(), sm.innerIndexPtr() + sm.nonZeros()},
       row_ptr{sm.outerIndexPtr(), sm.outerIndexPtr() + sm.outerSize()},
       rows{sm.rows()}, cols{sm.cols()} {
-  row_ptr.push_back(val.size());
+  row_ptr.push_back(static_cast<I>(val.size()));
+}
+
+template <typename T, typename I, typename A>
+template <int Options>
+void CompressedSparseRowMatrix<T, I, A>::assign(
+    const Eigen::SparseMatrix<T, Options> &sm) {
+  if constexpr (Options & Eigen::RowMajorBit) {
+    assign_storage(sm);
+  } else {
+    assign_storage_transpose(sm);
+  }
+}
+
+template <typename T, typename I, typename A>
+template <int Options>
+void CompressedSparseRowMatrix<T, I, A>::assign_transpose(
+    const Eigen::SparseMatrix<T, Options> &sm) {
+  if constexpr (Options & Eigen::RowMajorBit) {
+    assign_storage_transpose(sm);
+  } else {
+    assign_storage(sm);
+  }
+}
+
+template <typename T, typename I, typename A>
+template <int Options>
+void CompressedSparseRowMatrix<T, I, A>::assign_storage(
+    const Eigen::SparseMatrix<T, Options> &sm) {
+  using InnerIterator = typename Eigen::SparseMatrix<T, Options>::InnerIterator;
+
+  rows = sm.outerSize();
+  cols = sm.innerSize();
+  val.resize(sm.nonZeros());
+  col_ind.resize(sm.nonZeros());
+  row_ptr.resize(rows + 1);
+
+  auto t = I{0};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    row_ptr[r] = t;
+    for (auto it = InnerIterator(sm, r); it; ++it) {
+      col_ind[t] = static_cast<I>(it.index());
+      val[t] = it.value();
+      ++t;
+    }
+  }
+  row_ptr[rows] = t;
+}
+
+template <typename T, typename I, typename A>
+template <int Options>
+void CompressedSparseRowMatrix<T, I, A>::assign_storage_transpose(
+    const Eigen::SparseMatrix<T, Options> &sm) {
+  using InnerIterator = typename Eigen::SparseMatrix<T, Options>::InnerIterator;
+
+  rows = sm.innerSize();
+  cols = sm.outerSize();
+  val.resize(sm.nonZeros());
+  col_ind.resize(sm.nonZeros());
+  row_ptr.assign(rows + 1, I{0});
+
+  for (Eigen::Index c = 0; c < cols; ++c) {
+    for (auto it = InnerIterator(sm, c); it; ++it) {
+      ++row_ptr[it.index() + 1];
+    }
+  }
+  std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+  // row_ptr[r] is used as insertion cursor and ends up at row_ptr[r + 1].
+  for (Eigen::Index c = 0; c < cols; ++c) {
+    for (auto it = InnerIterator(sm, c); it; ++it) {
+      const auto t = row_ptr[it.index()]++;
+      col_ind[t] = static_cast<I>(c);
+      val[t] = it.value();
+    }
+  }
+  std::copy_backward(row_ptr.begin(), std::prev(row_ptr.end()),
+                     row_ptr.end());
+  row_ptr[0] = 0;
+}
+
+template <typename T, typename I, typename A>
+template <typename J>
+void CompressedSparseRowMatrix<T, I, A>::assign_transpose(
+    const CompressedSparseRowMatrixView<T, J> &csr) {
+  assign_view_transpose(csr);
+}
+
+template <typename T, typename I, typename A>
+template <typename J>
+void CompressedSparseRowMatrix<T, I, A>::assign_transpose(
+    const InterleavedCompressedSparseRowMatrixView<T, J> &csr) {
+  assign_view_transpose(csr);
+}
+
+template <typename T, typename I, typename A>
+template <typename ViewT>
+void CompressedSparseRowMatrix<T, I, A>::assign_view_transpose(
+    const ViewT &csr) {
+  const auto nnz = Eigen::Index{csr.row_ptr[csr.rows] - csr.row_ptr[0]};
+
+  rows = csr.cols;
+  cols = csr.rows;
+  val.resize(nnz);
+  col_ind.resize(nnz);
+  row_ptr.assign(rows + 1, I{0});
+
+  for (Eigen::Index t = csr.row_ptr[0]; t < csr.row_ptr[csr.rows]; ++t) {
+    ++row_ptr[csr.col_ind[t] + 1];
+  }
+  std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+  // row_ptr[r] is used as insertion cursor and ends up at row_ptr[r + 1].
+  for (Eigen::Index c = 0; c < cols; ++c) {
+    for (Eigen::Index t = csr.row_ptr[c]; t < csr.row_ptr[c + 1]; ++t) {
+      const auto k = row_ptr[csr.col_ind[t]]++;
+      col_ind[k] = static_cast<I>(c);
+      val[k] = csr.val[t];
+    }
+  }
+  std::copy_backward(row_ptr.begin(), std::prev(row_ptr.end()),
+                     row_ptr.end());
+  row_ptr[0] = 0;
+}
+
+template <typename T, typename I, typename A>
+CompressedSparseRowMatrixView<T, I>
+CompressedSparseRowMatrix<T, I, A>::view() const noexcept {
+  return {val.data(), col_ind.data(), row_ptr.data(), rows, cols};
 }
 
-template <typename T>
+template <typename T, typename I, typename A>
 std::ostream &operator<<(std::ostream &os,
-                         const CompressedSparseRowMatrix<T> &csr) {
+                         const CompressedSparseRowMatrix<T, I, A> &csr) {
   os << "CSR Matrix Representation" << '\n';
   os << "Dimension ( " << csr.rows << " x " << csr.cols << " )" << '\n';
   os << "Val       ( ";
@@ -0,0 +1,104 @@
+#ifndef ASAP_COMPRESSED_SPARSE_ROW_MATRIX_VIEW_HPP
+#define ASAP_COMPRESSED_SPARSE_ROW_MATRIX_VIEW_HPP
+
+#include "common.hpp"
+#include "sparse_matrix_traits.hpp"
+
+#include <cassert>
+
+namespace asap {
+
+/** @brief Non-owning CSR view over externally owned buffers.
+ *
+ * row_ptr must hold rows + 1 entries with row_ptr[rows] being the number of
+ * non-zeros. This matches the outer index of a compressed row-major Eigen
+ * sparse matrix, so a view can alias an Eigen::SparseMatrix or an
+ * Eigen::Map<Eigen::SparseMatrix> without copying any entries. The viewed
+ * buffers must outlive the view.
+ *
+ * row_ptr[0] may also be non-zero, in which case the entries of row r are
+ * val[row_ptr[r]..row_ptr[r + 1]). This lets views address the diagonal
+ * blocks of a larger, concatenated CSR without rebasing its row pointers.
+ */
+template <typename T, typename I> struct CompressedSparseRowMatrixView {
+  using Scalar = T;
+  using StorageIndex = I;
+
+  CompressedSparseRowMatrixView(const T *val, const I *col_ind,
+                                const I *row_ptr, Eigen::Index rows,
+                                Eigen::Index cols) noexcept;
+
+  template <typename Derived>
+  explicit CompressedSparseRowMatrixView(
+      const Eigen::SparseCompressedBase<Derived> &sm) noexcept;
+
+  const T *val{};
+  const I *col_ind{};
+  const I *row_ptr{};
+  Eigen::Index rows{};
+  Eigen::Index cols{};
+};
+
+template <typename Derived>
+CompressedSparseRowMatrixView(const Eigen::SparseCompressedBase<Derived> &)
+    -> CompressedSparseRowMatrixView<typename Derived::Scalar,
+                                     typename Derived::StorageIndex>;
+
+namespace internal {
+
+template <typename T>
+struct is_compressed_sparse_row_matrix_view : std::false_type {};
+
+template <typename T, typename I>
+struct is_compressed_sparse_row_matrix_view<
+    CompressedSparseRowMatrixView<T, I>> : std::true_type {};
+
+} // namespace internal
+
+template <typename T>
+static constexpr auto is_compressed_sparse_row_matrix_view_v =
+    internal::is_compressed_sparse_row_matrix_view<std::decay_t<T>>::value;
+
+template <typename T, typename I>
+CompressedSparseRowMatrixView<T, I>::CompressedSparseRowMatrixView(
+    const T *val, const I *col_ind, const I *row_ptr, Eigen::Index rows,
+    Eigen::Index cols) noexcept
+    : val{val}, col_ind{col_ind}, row_ptr{row_ptr}, rows{rows}, cols{cols} {}
+
+template <typename T, typename I>
+template <typename Derived>
+CompressedSparseRowMatrixView<T, I>::CompressedSparseRowMatrixView(
+    const Eigen::SparseCompressedBase<Derived> &sm) noexcept
+    : val{sm.valuePtr()}, col_ind{sm.innerIndexPtr()},
+      row_ptr{sm.outerIndexPtr()}, rows{sm.rows()}, cols{sm.cols()} {
+  static_assert(Derived::IsRowMajor,
+                "CompressedSparseRowMatrixView requires row-major storage");
+  assert(sm.isCompressed());
+}
+
+template <typename T, typename I>
+std::ostream &operator<<(std::ostream &os,
+                         const CompressedSparseRowMatrixView<T, I> &csr) {
+  os << "CSR Matrix View" << '\n';
+  os << "Dimension ( " << csr.rows << " x " << csr.cols << " )" << '\n';
+  os << "Val       ( ";
+  for (Eigen::Index t = csr.row_ptr[0]; t < csr.row_ptr[csr.rows]; ++t) {
+    os << csr.val[t] << ' ';
+  }
+  os << ')' << '\n';
+  os << "ColInd    ( ";
+  for (Eigen::Index t = csr.row_ptr[0]; t < csr.row_ptr[csr.rows]; ++t) {
+    os << csr.col_ind[t] << ' ';
+  }
+  os << ')' << '\n';
+  os << "RowPtr    ( ";
+  for (Eigen::Index r = 0; r <= csr.rows; ++r) {
+    os << csr.row_ptr[r] << ' ';
+  }
+  os << ')' << '\n';
+  return os;
+}
+
+} // namespace asap
+
+#endif
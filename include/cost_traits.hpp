@@ -0,0 +1,57 @@
+#ifndef ASAP_COST_TRAITS_HPP
+#define ASAP_COST_TRAITS_HPP
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace asap {
+
+namespace internal {
+
+/** @brief Distance the solvers treat as unreachable.
+ *
+ * Floating point costs use the largest finite value, arithmetic beyond it
+ * saturates to infinity. Integer costs keep a factor of four of headroom
+ * below the largest value, so differences and sums of INF with costs and
+ * duals never overflow as long as all costs lie within +-max() / 16.
+ */
+template <typename T> [[nodiscard]] constexpr T infinity() noexcept {
+  static_assert(std::is_arithmetic_v<T>, "costs must be arithmetic");
+  if constexpr (std::numeric_limits<T>::is_integer) {
+    return std::numeric_limits<T>::max() / 4;
+  } else {
+    return std::numeric_limits<T>::max();
+  }
+}
+
+/** @brief Tolerance for ties between distances of cost type T.
+ *
+ * Integer costs always compare exactly, floating point costs use eps.
+ */
+template <typename T> [[nodiscard]] constexpr T tolerance(double eps) noexcept {
+  if constexpr (std::numeric_limits<T>::is_integer) {
+    return T{0};
+  } else {
+    return static_cast<T>(eps);
+  }
+}
+
+/** @brief Whether distances a and b tie within eps.
+ *
+ * Compiles to an exact comparison for integer costs.
+ */
+template <typename T>
+[[nodiscard]] constexpr bool is_tie(T a, T b, T eps) noexcept {
+  if constexpr (std::numeric_limits<T>::is_integer) {
+    return a == b;
+  } else {
+    return std::abs(a - b) <= eps;
+  }
+}
+
+} // namespace internal
+
+} // namespace asap
+
+#endif
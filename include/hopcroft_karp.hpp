@@ -0,0 +1,69 @@
+#ifndef ASAP_HOPCROFT_KARP_HPP
+#define ASAP_HOPCROFT_KARP_HPP
+
+#include "common.hpp"
+#include "hopcroft_karp_impl.hpp"
+#include "sparse_assignment_problem.hpp"
+
+namespace asap {
+
+/** @brief Finds a maximum cardinality matching of the non-zeros of sm.
+ *
+ * Costs are ignored. res holds the matched entries sorted by row and is
+ * valid if every row, or every column of a tall matrix, is matched, that is
+ * if the assignment problem of sm is feasible. Accepts the same inputs as
+ * the assignment solvers and reuses the buffers of ws and res. The duals of
+ * res are left empty.
+ */
+template <typename SparseMatrixT, typename A>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+maximum_cardinality_matching(
+    const SparseMatrixT &sm,
+    HopcroftKarpWorkspace<typename SparseMatrixT::Scalar, A> &ws,
+    Result<typename SparseMatrixT::Scalar, Eigen::Index, A> &res) {
+  internal::visit_compressed_sparse_row_matrix(
+      sm, ws.csr, [&](const auto &csr, bool transposed) {
+        internal::hopcroft_karp(csr, ws);
+        res.valid = (ws.matched == csr.rows);
+        res.u.clear();
+        res.v.clear();
+
+        // Unmatched rows are left out of the row-sorted matching.
+        res.row_idx.resize(ws.matched);
+        res.col_idx.resize(ws.matched);
+        auto k = Eigen::Index{0};
+        if (transposed) {
+          for (Eigen::Index r = 0; r < csr.cols; ++r) {
+            if (ws.y[r] != -1) {
+              res.row_idx[k] = r;
+              res.col_idx[k] = ws.y[r];
+              ++k;
+            }
+          }
+        } else {
+          for (Eigen::Index r = 0; r < csr.rows; ++r) {
+            if (ws.x[r] != -1) {
+              res.row_idx[k] = r;
+              res.col_idx[k] = ws.x[r];
+              ++k;
+            }
+          }
+        }
+      });
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>,
+                               Result<typename SparseMatrixT::Scalar>>
+maximum_cardinality_matching(const SparseMatrixT &sm) {
+  using ScalarT = typename SparseMatrixT::Scalar;
+
+  auto ws = HopcroftKarpWorkspace<ScalarT>{};
+  auto res = Result<ScalarT>{};
+  maximum_cardinality_matching(sm, ws, res);
+  return res;
+}
+
+} // namespace asap
+
+#endif
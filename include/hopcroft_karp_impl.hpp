@@ -0,0 +1,187 @@
+#ifndef ASAP_HOPCROFT_KARP_IMPL_HPP
+#define ASAP_HOPCROFT_KARP_IMPL_HPP
+
+#include "hopcroft_karp_workspace.hpp"
+
+namespace asap {
+
+namespace internal {
+
+/** @brief Finds a maximum cardinality matching using Hopcroft-Karp.
+ *
+ * Only the sparsity pattern of csr is used. Every phase computes the layers
+ * of shortest alternating paths from all free rows by a breadth-first search
+ * and augments a maximal set of vertex-disjoint shortest paths by iterative
+ * depth-first searches, so at most O(sqrt(V)) phases of O(E) are needed [1].
+ * A greedy pass seeds the matching before the first phase. On return ws.x
+ * and ws.y hold the matching and ws.matched its cardinality.
+ *
+ * Source index:
+ * [1] John E. Hopcroft and Richard M. Karp:
+ *     An n^5/2 Algorithm for Maximum Matchings in Bipartite Graphs.
+ *     SIAM Journal on Computing 2(4):225-231, 1973.
+ */
+template <typename MatrixT, typename T, typename A>
+void hopcroft_karp(const MatrixT &csr, HopcroftKarpWorkspace<T, A> &ws);
+
+/** @brief Labels the rows by their distance to the free rows.
+ *
+ * Returns the layer of the rows that are adjacent to a free column, or -1 if
+ * no augmenting path exists.
+ */
+template <typename MatrixT, typename T, typename A>
+[[nodiscard]] Eigen::Index hopcroft_karp_bfs(const MatrixT &csr,
+                                             HopcroftKarpWorkspace<T, A> &ws);
+
+/** @brief Augments along a shortest alternating path from free row i0.
+ *
+ * Returns whether a path was found.
+ */
+template <typename MatrixT, typename T, typename A>
+[[nodiscard]] bool hopcroft_karp_dfs(Eigen::Index i0, Eigen::Index limit,
+                                     const MatrixT &csr,
+                                     HopcroftKarpWorkspace<T, A> &ws);
+
+template <typename MatrixT, typename T, typename A>
+void hopcroft_karp(const MatrixT &csr, HopcroftKarpWorkspace<T, A> &ws) {
+  using I = Eigen::Index;
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto nr = I{csr.rows};
+  const auto nc = I{csr.cols};
+  auto &x = ws.x;
+  auto &y = ws.y;
+
+  ws.reset(nr, nc);
+
+  for (I i = 0; i < nr; ++i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      const auto j = I{kk[t]};
+      if (y[j] == -1) {
+        x[i] = j;
+        y[j] = i;
+        ++ws.matched;
+        break;
+      }
+    }
+  }
+
+  const auto max_matched = std::min(nr, nc);
+  while (ws.matched < max_matched) {
+    const auto limit = hopcroft_karp_bfs(csr, ws);
+    if (limit == -1) {
+      return;
+    }
+    for (I i = 0; i < nr; ++i) {
+      ws.next_edge[i] = first[i];
+    }
+    for (I i = 0; i < nr; ++i) {
+      if ((x[i] == -1) && hopcroft_karp_dfs(i, limit, csr, ws)) {
+        ++ws.matched;
+      }
+    }
+  }
+}
+
+template <typename MatrixT, typename T, typename A>
+Eigen::Index hopcroft_karp_bfs(const MatrixT &csr,
+                               HopcroftKarpWorkspace<T, A> &ws) {
+  using I = Eigen::Index;
+
+  static constexpr auto INF = std::numeric_limits<I>::max();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto nr = I{csr.rows};
+  const auto &x = ws.x;
+  const auto &y = ws.y;
+  auto &dist = ws.dist;
+  auto &queue = ws.queue;
+
+  auto tail = I{0};
+  for (I i = 0; i < nr; ++i) {
+    if (x[i] == -1) {
+      dist[i] = 0;
+      queue[tail] = i;
+      ++tail;
+    } else {
+      dist[i] = INF;
+    }
+  }
+
+  auto limit = I{-1};
+  for (I head = 0; head < tail; ++head) {
+    const auto i = queue[head];
+    if ((limit != -1) && (dist[i] >= limit)) {
+      break;
+    }
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      const auto i1 = y[kk[t]];
+      if (i1 == -1) {
+        limit = dist[i];
+      } else if (dist[i1] == INF) {
+        dist[i1] = dist[i] + 1;
+        queue[tail] = i1;
+        ++tail;
+      }
+    }
+  }
+  return limit;
+}
+
+template <typename MatrixT, typename T, typename A>
+bool hopcroft_karp_dfs(Eigen::Index i0, Eigen::Index limit,
+                       const MatrixT &csr, HopcroftKarpWorkspace<T, A> &ws) {
+  using I = Eigen::Index;
+
+  static constexpr auto INF = std::numeric_limits<I>::max();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  auto &x = ws.x;
+  auto &y = ws.y;
+  auto &dist = ws.dist;
+  auto &stack = ws.stack;
+  auto &next_edge = ws.next_edge;
+
+  // Rows on the stack form the current alternating path, each row continues
+  // through the column at its next_edge.
+  auto sp = I{1};
+  stack[0] = i0;
+  while (sp > 0) {
+    const auto i = stack[sp - 1];
+    if (next_edge[i] == first[i + 1]) {
+      // Dead end, no later search of this phase has to visit i again.
+      dist[i] = INF;
+      --sp;
+      if (sp > 0) {
+        ++next_edge[stack[sp - 1]];
+      }
+      continue;
+    }
+    const auto i1 = y[kk[next_edge[i]]];
+    if ((i1 == -1) && (dist[i] == limit)) {
+      for (I s = 0; s < sp; ++s) {
+        const auto r = stack[s];
+        const auto j = I{kk[next_edge[r]]};
+        x[r] = j;
+        y[j] = r;
+      }
+      return true;
+    }
+    if ((i1 != -1) && (dist[i1] == dist[i] + 1)) {
+      stack[sp] = i1;
+      ++sp;
+    } else {
+      ++next_edge[i];
+    }
+  }
+  return false;
+}
+
+} // namespace internal
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef ASAP_HOPCROFT_KARP_WORKSPACE_HPP
+#define ASAP_HOPCROFT_KARP_WORKSPACE_HPP
+
+#include "compressed_sparse_row_matrix.hpp"
+
+namespace asap {
+
+/** @brief Owns all buffers needed by Hopcroft-Karp.
+ *
+ * Like the LAPJVsp workspace, buffers only grow, so repeated matchings of
+ * problems no larger than previous ones do not touch the heap. All buffers
+ * are allocated by A.
+ */
+template <typename T, typename A = std::allocator<T>>
+struct HopcroftKarpWorkspace {
+  HopcroftKarpWorkspace() = default;
+
+  explicit HopcroftKarpWorkspace(const A &alloc) noexcept
+      : csr{alloc}, x{alloc}, y{alloc}, dist{alloc}, queue{alloc},
+        stack{alloc}, next_edge{alloc} {}
+
+  void reset(Eigen::Index nr, Eigen::Index nc);
+
+  using allocator_type = A;
+
+  CompressedSparseRowMatrix<T, Eigen::Index, A> csr{};
+  internal::rebind_vector_t<Eigen::Index, A> x{};
+  internal::rebind_vector_t<Eigen::Index, A> y{};
+  internal::rebind_vector_t<Eigen::Index, A> dist{};
+  internal::rebind_vector_t<Eigen::Index, A> queue{};
+  internal::rebind_vector_t<Eigen::Index, A> stack{};
+  internal::rebind_vector_t<Eigen::Index, A> next_edge{};
+
+  // Number of matched rows after the last run.
+  Eigen::Index matched{};
+};
+
+template <typename T, typename A>
+void HopcroftKarpWorkspace<T, A>::reset(Eigen::Index nr, Eigen::Index nc) {
+  x.assign(nr, Eigen::Index{-1});
+  y.assign(nc, Eigen::Index{-1});
+  dist.resize(nr);
+  queue.resize(nr);
+  stack.resize(nr);
+  next_edge.resize(nr);
+  matched = 0;
+}
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef ASAP_INTERLEAVED_COMPRESSED_SPARSE_ROW_MATRIX_HPP
+#define ASAP_INTERLEAVED_COMPRESSED_SPARSE_ROW_MATRIX_HPP
+
+#include "common.hpp"
+#include "sparse_matrix_traits.hpp"
+
+namespace asap {
+
+/** @brief Column index and cost of one CSR entry.
+ *
+ * With a 32-bit index type and a 32-bit cost type an edge packs into 8 bytes.
+ */
+template <typename T, typename I> struct Edge {
+  I col{};
+  T cost{};
+};
+
+namespace internal {
+
+/** @brief Indexes the column indices of an array of edges like an array.
+ */
+template <typename T, typename I> struct EdgeColumns {
+  [[nodiscard]] I operator[](Eigen::Index t) const noexcept {
+    return edges[t].col;
+  }
+
+  const Edge<T, I> *edges{};
+};
+
+/** @brief Indexes the costs of an array of edges like an array.
+ */
+template <typename T, typename I> struct EdgeCosts {
+  [[nodiscard]] T operator[](Eigen::Index t) const noexcept {
+    return edges[t].cost;
+  }
+
+  const Edge<T, I> *edges{};
+};
+
+} // namespace internal
+
+/** @brief Non-owning CSR view over interleaved {col, cost} edges.
+ *
+ * The solvers read the column index and the cost of an entry together, so
+ * storing both in one array halves the number of memory streams of the row
+ * scans. col_ind and val index the edges like the arrays of a
+ * CompressedSparseRowMatrixView, which lets all solvers run on either
+ * layout. row_ptr follows the conventions of CompressedSparseRowMatrixView.
+ * The viewed buffers must outlive the view.
+ */
+template <typename T, typename I>
+struct InterleavedCompressedSparseRowMatrixView {
+  using Scalar = T;
+  using StorageIndex = I;
+
+  InterleavedCompressedSparseRowMatrixView(const Edge<T, I> *edges,
+                                           const I *row_ptr, Eigen::Index rows,
+                                           Eigen::Index cols) noexcept;
+
+  const Edge<T, I> *edges{};
+  const I *row_ptr{};
+  Eigen::Index rows{};
+  Eigen::Index cols{};
+  internal::EdgeColumns<T, I> col_ind{};
+  internal::EdgeCosts<T, I> val{};
+};
+
+/** @brief Owning CSR matrix storing its entries as interleaved edges.
+ *
+ * The solvers take the matrix through view().
+ */
+template <typename T, typename I = Eigen::Index>
+struct InterleavedCompressedSparseRowMatrix {
+  /** @brief Overwrites the matrix with the entries of sm.
+   *
+   * Existing buffers are reused. Column-major inputs are converted by a
+   * counting sort over their row indices.
+   */
+  template <int Options>
+  void assign(const Eigen::SparseMatrix<T, Options> &sm);
+
+  [[nodiscard]] InterleavedCompressedSparseRowMatrixView<T, I>
+  view() const noexcept;
+
+  using Scalar = T;
+  using StorageIndex = I;
+
+  std::vector<Edge<T, I>> edges{};
+  std::vector<I> row_ptr{};
+  Eigen::Index rows{};
+  Eigen::Index cols{};
+};
+
+namespace internal {
+
+template <typename T>
+struct is_interleaved_compressed_sparse_row_matrix_view : std::false_type {};
+
+template <typename T, typename I>
+struct is_interleaved_compressed_sparse_row_matrix_view<
+    InterleavedCompressedSparseRowMatrixView<T, I>> : std::true_type {};
+
+} // namespace internal
+
+template <typename T>
+static constexpr auto is_interleaved_compressed_sparse_row_matrix_view_v =
+    internal::is_interleaved_compressed_sparse_row_matrix_view<
+        std::decay_t<T>>::value;
+
+template <typename T, typename I>
+InterleavedCompressedSparseRowMatrixView<T, I>::
+    InterleavedCompressedSparseRowMatrixView(const Edge<T, I> *edges,
+                                             const I *row_ptr,
+                                             Eigen::Index rows,
+                                             Eigen::Index cols) noexcept
+    : edges{edges}, row_ptr{row_ptr}, rows{rows}, cols{cols},
+      col_ind{edges}, val{edges} {}
+
+template <typename T, typename I>
+template <int Options>
+void InterleavedCompressedSparseRowMatrix<T, I>::assign(
+    const Eigen::SparseMatrix<T, Options> &sm) {
+  using InnerIterator = typename Eigen::SparseMatrix<T, Options>::InnerIterator;
+
+  rows = sm.rows();
+  cols = sm.cols();
+  edges.resize(sm.nonZeros());
+  row_ptr.assign(rows + 1, I{0});
+
+  if constexpr (Options & Eigen::RowMajorBit) {
+    auto t = I{0};
+    for (Eigen::Index r = 0; r < rows; ++r) {
+      row_ptr[r] = t;
+      for (auto it = InnerIterator(sm, r); it; ++it) {
+        edges[t] = {static_cast<I>(it.index()), it.value()};
+        ++t;
+      }
+    }
+    row_ptr[rows] = t;
+  } else {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      for (auto it = InnerIterator(sm, c); it; ++it) {
+        ++row_ptr[it.index() + 1];
+      }
+    }
+    std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+
+    // row_ptr[r] is used as insertion cursor and ends up at row_ptr[r + 1].
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      for (auto it = InnerIterator(sm, c); it; ++it) {
+        edges[row_ptr[it.index()]++] = {static_cast<I>(c), it.value()};
+      }
+    }
+    std::copy_backward(row_ptr.begin(), std::prev(row_ptr.end()),
+                       row_ptr.end());
+    row_ptr[0] = 0;
+  }
+}
+
+template <typename T, typename I>
+InterleavedCompressedSparseRowMatrixView<T, I>
+InterleavedCompressedSparseRowMatrix<T, I>::view() const noexcept {
+  return {edges.data(), row_ptr.data(), rows, cols};
+}
+
+} // namespace asap
+
+#endif
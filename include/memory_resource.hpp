@@ -0,0 +1,52 @@
+#ifndef ASAP_MEMORY_RESOURCE_HPP
+#define ASAP_MEMORY_RESOURCE_HPP
+
+#include "hopcroft_karp.hpp"
+#include "sparse_jonker_volgenant_solver.hpp"
+
+#include <memory_resource>
+
+namespace asap::pmr {
+
+/** @brief Containers whose buffers come from a std::pmr::memory_resource.
+ *
+ * Like std::pmr::vector, these are the allocator-aware types of asap with a
+ * std::pmr::polymorphic_allocator. Construct them from the resource, for
+ * example a std::pmr::monotonic_buffer_resource over a stack or arena buffer,
+ * and pass them to the same solvers as their default counterparts:
+ *
+ *   auto arena = std::pmr::monotonic_buffer_resource{buffer, size};
+ *   auto ws = asap::pmr::SparseJonkerVolgenantWorkspace<double>{&arena};
+ *   auto res = asap::pmr::Result<double>{&arena};
+ *   asap::solve_sparse_assignment_problem(sm, ws, res);
+ *
+ * Every buffer the solve touches, including the CSR copy of the problem, the
+ * feasibility matching and the per-thread search state of the parallel
+ * augmentation, is allocated from the resource. Worker threads of the thread
+ * pool are not. Instrumented solves keep this with asap::pmr::SolverStats as
+ * statistics policy, whose phase and path buffers also come from the
+ * resource of the workspace, while asap::SolverStats allocates from the
+ * global heap.
+ */
+template <typename T>
+using Allocator = std::pmr::polymorphic_allocator<T>;
+
+template <typename T, typename I = Eigen::Index>
+using CompressedSparseRowMatrix =
+    asap::CompressedSparseRowMatrix<T, I, Allocator<T>>;
+
+template <typename T = double, typename I = Eigen::Index>
+using Result = asap::Result<T, I, Allocator<T>>;
+
+using SolverStats = BasicSolverStats<Allocator<PhaseStats>>;
+
+template <typename T, typename I = Eigen::Index, typename S = NoSolverStats>
+using SparseJonkerVolgenantWorkspace =
+    asap::SparseJonkerVolgenantWorkspace<T, I, S, Allocator<T>>;
+
+template <typename T>
+using HopcroftKarpWorkspace = asap::HopcroftKarpWorkspace<T, Allocator<T>>;
+
+} // namespace asap::pmr
+
+#endif
@@ -0,0 +1,543 @@
+#ifndef ASAP_SIMD_KERNELS_HPP
+#define ASAP_SIMD_KERNELS_HPP
+
+#include "cost_traits.hpp"
+
+#include <Eigen/Core>
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) &&       \
+    !defined(ASAP_DISABLE_SIMD)
+#define ASAP_HAS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+namespace asap {
+
+namespace internal {
+
+/** @brief Instruction set used by the vectorized row scan kernels.
+ */
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+/** @brief Best instruction set supported by the running CPU.
+ *
+ * Detected once on first use. Always Scalar on non-x86 targets or if
+ * ASAP_DISABLE_SIMD is defined.
+ */
+[[nodiscard]] inline SimdLevel detect_simd_level() noexcept {
+#ifdef ASAP_HAS_X86_SIMD
+  static const auto level = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return SimdLevel::Avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return SimdLevel::Avx2;
+    }
+    return SimdLevel::Scalar;
+  }();
+  return level;
+#else
+  return SimdLevel::Scalar;
+#endif
+}
+
+/** @brief Whether the kernels have a vectorized version for T and J.
+ *
+ * Double costs with 32 or 64-bit column indices are vectorized, all other
+ * combinations always take the scalar kernels.
+ */
+template <typename T, typename J>
+static constexpr auto has_simd_kernels_v =
+    std::is_same_v<T, double> && std::is_integral_v<J> &&
+    ((sizeof(J) == 4) || (sizeof(J) == 8));
+
+/** @brief Whether X stores its elements contiguously in memory.
+ *
+ * Only contiguous costs and column indices can be loaded into vector
+ * registers, other indexable types such as the columns of interleaved edges
+ * take the scalar kernels.
+ */
+template <typename X> struct is_contiguous : std::is_pointer<X> {};
+
+template <typename T, typename A>
+struct is_contiguous<std::vector<T, A>> : std::true_type {};
+
+template <typename X>
+using element_t = std::decay_t<decltype(std::declval<const X &>()[0])>;
+
+template <typename T> [[nodiscard]] const T *data_of(const T *x) noexcept {
+  return x;
+}
+
+template <typename T, typename A>
+[[nodiscard]] const T *data_of(const std::vector<T, A> &x) noexcept {
+  return x.data();
+}
+
+template <typename CostsT, typename ColumnsT, typename T>
+static constexpr auto is_vectorizable_v =
+    is_contiguous<CostsT>::value && is_contiguous<ColumnsT>::value &&
+    std::is_same_v<element_t<CostsT>, T> &&
+    has_simd_kernels_v<T, element_t<ColumnsT>>;
+
+/** @brief Smallest and second smallest reduced cost of a row.
+ *
+ * t0 and t1 are the CSR positions of the two entries, or -1 if the row has
+ * fewer entries with a reduced cost below INF. Ties are broken towards the
+ * lower position, so t0 is the first minimum and t1 the first minimum of
+ * the remaining entries.
+ */
+template <typename T> struct TwoMinima {
+  T v0{infinity<T>()};
+  T v1{infinity<T>()};
+  Eigen::Index t0{-1};
+  Eigen::Index t1{-1};
+};
+
+/** @brief Inserts reduced cost d at position t into m.
+ *
+ * Orders entries by (cost, position), so candidates can be merged in any
+ * order and still yield the result of a sequential scan.
+ */
+template <typename T>
+void insert_two_minima(TwoMinima<T> &m, T d, Eigen::Index t) noexcept {
+  const auto before = [](T a, Eigen::Index ta, T b, Eigen::Index tb) {
+    return (a < b) || ((a == b) && (ta < tb));
+  };
+  if (before(d, t, m.v0, m.t0)) {
+    m.v1 = m.v0;
+    m.t1 = m.t0;
+    m.v0 = d;
+    m.t0 = t;
+  } else if (before(d, t, m.v1, m.t1)) {
+    m.v1 = d;
+    m.t1 = t;
+  }
+}
+
+/** @brief Two minima of cc[t] - v[kk[t]] over t in [begin, end).
+ */
+template <typename CostsT, typename ColumnsT, typename T>
+[[nodiscard]] TwoMinima<T>
+two_minima_scalar(const CostsT &cc, const ColumnsT &kk, const T *v,
+                  Eigen::Index begin, Eigen::Index end) noexcept {
+  auto m = TwoMinima<T>{};
+  for (auto t = begin; t < end; ++t) {
+    const auto d = cc[t] - v[kk[t]];
+    if (d < m.v1) {
+      if (d >= m.v0) {
+        m.v1 = d;
+        m.t1 = t;
+      } else {
+        m.v1 = m.v0;
+        m.t1 = m.t0;
+        m.v0 = d;
+        m.t0 = t;
+      }
+    }
+  }
+  return m;
+}
+
+/** @brief Lowers v[kk[t]] to cc[t] and sets y[kk[t]] = z where cc[t] is
+ * smaller, for t in [begin, end).
+ *
+ * This is one row of the column reduction. The columns of a row must be
+ * distinct.
+ */
+template <typename CostsT, typename ColumnsT, typename T, typename I>
+void column_minima_scalar(const CostsT &cc, const ColumnsT &kk, T *v, I *y,
+                          I z, Eigen::Index begin, Eigen::Index end) noexcept {
+  for (auto t = begin; t < end; ++t) {
+    const auto j = kk[t];
+    if (cc[t] < v[j]) {
+      v[j] = cc[t];
+      y[j] = z;
+    }
+  }
+}
+
+/** @brief Compacts the entries of cc[begin, end) with a cost of at most
+ * gate, writing their positions to kk and their costs to out in order.
+ *
+ * Returns the number of entries kept. Every position is written before it
+ * is counted, which keeps the loop free of branches, so kk and out need room
+ * for end - begin entries.
+ */
+template <typename T, typename J>
+[[nodiscard]] Eigen::Index gate_row_scalar(const T *cc, Eigen::Index begin,
+                                           Eigen::Index end, double gate,
+                                           J *kk, T *out) noexcept {
+  auto m = Eigen::Index{0};
+  for (auto t = begin; t < end; ++t) {
+    kk[m] = static_cast<J>(t);
+    out[m] = cc[t];
+    m += static_cast<Eigen::Index>(static_cast<double>(cc[t]) <= gate);
+  }
+  return m;
+}
+
+#ifdef ASAP_HAS_X86_SIMD
+
+// The gathers use the masked forms with a zero source, as GCC warns about
+// the undefined source register of the unmasked ones.
+template <typename J>
+__attribute__((target("avx2"))) __m256d gather4_pd(const double *v,
+                                                   const J *kk) noexcept {
+  const auto zero = _mm256_setzero_pd();
+  const auto all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  if constexpr (sizeof(J) == 4) {
+    const auto idx = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kk));
+    return _mm256_mask_i32gather_pd(zero, v, idx, all, 8);
+  } else {
+    const auto idx =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(kk));
+    return _mm256_mask_i64gather_pd(zero, v, idx, all, 8);
+  }
+}
+
+template <typename J>
+__attribute__((target("avx512f"))) __m512d gather8_pd(const double *v,
+                                                      const J *kk) noexcept {
+  const auto zero = _mm512_setzero_pd();
+  if constexpr (sizeof(J) == 4) {
+    const auto idx =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(kk));
+    return _mm512_mask_i32gather_pd(zero, 0xFF, idx, v, 8);
+  } else {
+    const auto idx = _mm512_loadu_si512(kk);
+    return _mm512_mask_i64gather_pd(zero, 0xFF, idx, v, 8);
+  }
+}
+
+/** @brief AVX2 version of two_minima_scalar for double costs.
+ *
+ * Each of the four lanes keeps the two minima of its positions, which are
+ * merged with the scalar tail by (cost, position).
+ */
+template <typename J>
+__attribute__((target("avx2"))) TwoMinima<double>
+two_minima_avx2(const double *cc, const J *kk, const double *v,
+                Eigen::Index begin, Eigen::Index end) noexcept {
+  const auto inf = _mm256_set1_pd(infinity<double>());
+  const auto none = _mm256_set1_epi64x(-1);
+  const auto four = _mm256_set1_epi64x(4);
+  auto b0 = inf;
+  auto b1 = inf;
+  auto p0 = none;
+  auto p1 = none;
+  auto pos = _mm256_setr_epi64x(begin, begin + 1, begin + 2, begin + 3);
+
+  auto t = begin;
+  for (; t + 4 <= end; t += 4) {
+    const auto d =
+        _mm256_sub_pd(_mm256_loadu_pd(cc + t), gather4_pd(v, kk + t));
+    const auto lt0 = _mm256_cmp_pd(d, b0, _CMP_LT_OQ);
+    const auto lt1 = _mm256_cmp_pd(d, b1, _CMP_LT_OQ);
+    const auto m0 = _mm256_castpd_si256(lt0);
+    const auto m1 = _mm256_castpd_si256(lt1);
+    b1 = _mm256_blendv_pd(_mm256_blendv_pd(b1, d, lt1), b0, lt0);
+    p1 = _mm256_blendv_epi8(_mm256_blendv_epi8(p1, pos, m1), p0, m0);
+    b0 = _mm256_blendv_pd(b0, d, lt0);
+    p0 = _mm256_blendv_epi8(p0, pos, m0);
+    pos = _mm256_add_epi64(pos, four);
+  }
+
+  alignas(32) double bb[8];
+  alignas(32) std::int64_t pp[8];
+  _mm256_store_pd(bb, b0);
+  _mm256_store_pd(bb + 4, b1);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(pp), p0);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(pp + 4), p1);
+
+  auto m = TwoMinima<double>{};
+  for (int k = 0; k < 8; ++k) {
+    if (pp[k] != -1) {
+      insert_two_minima(m, bb[k], pp[k]);
+    }
+  }
+  for (; t < end; ++t) {
+    insert_two_minima(m, cc[t] - v[kk[t]], t);
+  }
+  return m;
+}
+
+/** @brief AVX-512 version of two_minima_scalar for double costs.
+ */
+template <typename J>
+__attribute__((target("avx512f"))) TwoMinima<double>
+two_minima_avx512(const double *cc, const J *kk, const double *v,
+                  Eigen::Index begin, Eigen::Index end) noexcept {
+  const auto inf = _mm512_set1_pd(infinity<double>());
+  const auto none = _mm512_set1_epi64(-1);
+  const auto eight = _mm512_set1_epi64(8);
+  auto b0 = inf;
+  auto b1 = inf;
+  auto p0 = none;
+  auto p1 = none;
+  auto pos = _mm512_add_epi64(_mm512_set1_epi64(begin),
+                              _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+
+  auto t = begin;
+  for (; t + 8 <= end; t += 8) {
+    const auto d =
+        _mm512_sub_pd(_mm512_loadu_pd(cc + t), gather8_pd(v, kk + t));
+    const auto lt0 = _mm512_cmp_pd_mask(d, b0, _CMP_LT_OQ);
+    const auto lt1 = _mm512_cmp_pd_mask(d, b1, _CMP_LT_OQ);
+    b1 = _mm512_mask_blend_pd(lt0, _mm512_mask_blend_pd(lt1, b1, d), b0);
+    p1 = _mm512_mask_blend_epi64(lt0, _mm512_mask_blend_epi64(lt1, p1, pos),
+                                 p0);
+    b0 = _mm512_mask_blend_pd(lt0, b0, d);
+    p0 = _mm512_mask_blend_epi64(lt0, p0, pos);
+    pos = _mm512_add_epi64(pos, eight);
+  }
+
+  alignas(64) double bb[16];
+  alignas(64) std::int64_t pp[16];
+  _mm512_store_pd(bb, b0);
+  _mm512_store_pd(bb + 8, b1);
+  _mm512_store_si512(pp, p0);
+  _mm512_store_si512(pp + 8, p1);
+
+  auto m = TwoMinima<double>{};
+  for (int k = 0; k < 16; ++k) {
+    if (pp[k] != -1) {
+      insert_two_minima(m, bb[k], pp[k]);
+    }
+  }
+  for (; t < end; ++t) {
+    insert_two_minima(m, cc[t] - v[kk[t]], t);
+  }
+  return m;
+}
+
+/** @brief AVX2 version of column_minima_scalar for double costs.
+ *
+ * Compares four costs against the gathered duals at once. Lanes that may
+ * improve are rechecked and written back one by one, since AVX2 has no
+ * scatter and most lanes do not improve after the first rows.
+ */
+template <typename J, typename I>
+__attribute__((target("avx2"))) void
+column_minima_avx2(const double *cc, const J *kk, double *v, I *y, I z,
+                   Eigen::Index begin, Eigen::Index end) noexcept {
+  auto t = begin;
+  for (; t + 4 <= end; t += 4) {
+    const auto lt = _mm256_cmp_pd(_mm256_loadu_pd(cc + t),
+                                  gather4_pd(v, kk + t), _CMP_LT_OQ);
+    auto mask = static_cast<unsigned>(_mm256_movemask_pd(lt));
+    while (mask != 0) {
+      const auto s = t + __builtin_ctz(mask);
+      const auto j = kk[s];
+      if (cc[s] < v[j]) {
+        v[j] = cc[s];
+        y[j] = z;
+      }
+      mask &= mask - 1;
+    }
+  }
+  column_minima_scalar(cc, kk, v, y, z, t, end);
+}
+
+/** @brief AVX-512 version of column_minima_scalar for double costs.
+ */
+template <typename J, typename I>
+__attribute__((target("avx512f"))) void
+column_minima_avx512(const double *cc, const J *kk, double *v, I *y, I z,
+                     Eigen::Index begin, Eigen::Index end) noexcept {
+  auto t = begin;
+  for (; t + 8 <= end; t += 8) {
+    auto mask = static_cast<unsigned>(_mm512_cmp_pd_mask(
+        _mm512_loadu_pd(cc + t), gather8_pd(v, kk + t), _CMP_LT_OQ));
+    while (mask != 0) {
+      const auto s = t + __builtin_ctz(mask);
+      const auto j = kk[s];
+      if (cc[s] < v[j]) {
+        v[j] = cc[s];
+        y[j] = z;
+      }
+      mask &= mask - 1;
+    }
+  }
+  column_minima_scalar(cc, kk, v, y, z, t, end);
+}
+
+/** @brief Lane permutations that move the set lanes of a 4-bit mask to the
+ * front of a vector of four 64-bit lanes, as pairs of 32-bit lanes.
+ */
+struct CompressTable {
+  alignas(32) std::int32_t perm[16][8];
+};
+
+[[nodiscard]] constexpr CompressTable make_compress_table() noexcept {
+  auto table = CompressTable{};
+  for (int mask = 0; mask < 16; ++mask) {
+    auto k = 0;
+    for (int lane = 0; lane < 4; ++lane) {
+      if (((mask >> lane) & 1) != 0) {
+        table.perm[mask][2 * k] = 2 * lane;
+        table.perm[mask][2 * k + 1] = 2 * lane + 1;
+        ++k;
+      }
+    }
+  }
+  return table;
+}
+
+inline constexpr auto compress_table = make_compress_table();
+
+/** @brief AVX2 version of gate_row_scalar for double costs.
+ *
+ * AVX2 has no compress instruction, so the kept lanes are moved to the
+ * front by a permutation looked up from the comparison mask, and all four
+ * lanes are stored. Since the output never runs ahead of the input, the
+ * stores stay within the room gate_row_scalar requires.
+ */
+template <typename J>
+__attribute__((target("avx2"))) Eigen::Index
+gate_row_avx2(const double *cc, Eigen::Index n, double gate, J *kk,
+              double *out) noexcept {
+  const auto g = _mm256_set1_pd(gate);
+  const auto four = _mm256_set1_epi64x(4);
+  const auto low = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+  auto pos = _mm256_setr_epi64x(0, 1, 2, 3);
+  auto m = Eigen::Index{0};
+
+  auto t = Eigen::Index{0};
+  for (; t + 4 <= n; t += 4) {
+    const auto c = _mm256_loadu_pd(cc + t);
+    const auto mask = _mm256_movemask_pd(_mm256_cmp_pd(c, g, _CMP_LE_OQ));
+    const auto perm = _mm256_load_si256(
+        reinterpret_cast<const __m256i *>(compress_table.perm[mask]));
+    _mm256_storeu_pd(out + m, _mm256_castps_pd(_mm256_permutevar8x32_ps(
+                                  _mm256_castpd_ps(c), perm)));
+    const auto p = _mm256_permutevar8x32_epi32(pos, perm);
+    if constexpr (sizeof(J) == 4) {
+      _mm_storeu_si128(
+          reinterpret_cast<__m128i *>(kk + m),
+          _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(p, low)));
+    } else {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(kk + m), p);
+    }
+    m += __builtin_popcount(static_cast<unsigned>(mask));
+    pos = _mm256_add_epi64(pos, four);
+  }
+  return m + gate_row_scalar(cc, t, n, gate, kk + m, out + m);
+}
+
+/** @brief AVX-512 version of gate_row_scalar for double costs.
+ *
+ * Compresses into a register and stores all eight lanes, as the compressing
+ * stores are slow on some CPUs.
+ */
+template <typename J>
+__attribute__((target("avx512f"))) Eigen::Index
+gate_row_avx512(const double *cc, Eigen::Index n, double gate, J *kk,
+                double *out) noexcept {
+  const auto g = _mm512_set1_pd(gate);
+  const auto eight = _mm512_set1_epi64(8);
+  auto pos = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  auto m = Eigen::Index{0};
+
+  auto t = Eigen::Index{0};
+  for (; t + 8 <= n; t += 8) {
+    const auto c = _mm512_loadu_pd(cc + t);
+    const auto mask = _mm512_cmp_pd_mask(c, g, _CMP_LE_OQ);
+    _mm512_storeu_pd(out + m, _mm512_maskz_compress_pd(mask, c));
+    const auto p = _mm512_maskz_compress_epi64(mask, pos);
+    if constexpr (sizeof(J) == 4) {
+      // Masked with a zero source for the same reason as the gathers.
+      _mm256_storeu_si256(
+          reinterpret_cast<__m256i *>(kk + m),
+          _mm512_mask_cvtepi64_epi32(_mm256_setzero_si256(), 0xFF, p));
+    } else {
+      _mm512_storeu_si512(kk + m, p);
+    }
+    m += __builtin_popcount(static_cast<unsigned>(mask));
+    pos = _mm512_add_epi64(pos, eight);
+  }
+  return m + gate_row_scalar(cc, t, n, gate, kk + m, out + m);
+}
+
+#endif
+
+/** @brief Two minima of cc[t] - v[kk[t]] using the kernel of level.
+ *
+ * All kernels return the same minima and positions as the scalar kernel.
+ */
+template <typename CostsT, typename ColumnsT, typename T>
+[[nodiscard]] TwoMinima<T> two_minima(SimdLevel level, const CostsT &cc,
+                                      const ColumnsT &kk, const T *v,
+                                      Eigen::Index begin,
+                                      Eigen::Index end) noexcept {
+#ifdef ASAP_HAS_X86_SIMD
+  if constexpr (is_vectorizable_v<CostsT, ColumnsT, T>) {
+    if (level == SimdLevel::Avx512) {
+      return two_minima_avx512(data_of(cc), data_of(kk), v, begin, end);
+    }
+    if (level == SimdLevel::Avx2) {
+      return two_minima_avx2(data_of(cc), data_of(kk), v, begin, end);
+    }
+  }
+#endif
+  static_cast<void>(level);
+  return two_minima_scalar(cc, kk, v, begin, end);
+}
+
+/** @brief One row of the column reduction using the kernel of level.
+ */
+template <typename CostsT, typename ColumnsT, typename T, typename I>
+void column_minima(SimdLevel level, const CostsT &cc, const ColumnsT &kk,
+                   T *v, I *y, I z, Eigen::Index begin,
+                   Eigen::Index end) noexcept {
+#ifdef ASAP_HAS_X86_SIMD
+  if constexpr (is_vectorizable_v<CostsT, ColumnsT, T>) {
+    if (level == SimdLevel::Avx512) {
+      column_minima_avx512(data_of(cc), data_of(kk), v, y, z, begin, end);
+      return;
+    }
+    if (level == SimdLevel::Avx2) {
+      column_minima_avx2(data_of(cc), data_of(kk), v, y, z, begin, end);
+      return;
+    }
+  }
+#endif
+  static_cast<void>(level);
+  column_minima_scalar(cc, kk, v, y, z, begin, end);
+}
+
+/** @brief Compacts the entries of cc[0, n) with a cost of at most gate
+ * using the kernel of level.
+ *
+ * All kernels keep the same entries as the scalar kernel. kk and out need
+ * room for n entries.
+ */
+template <typename T, typename J>
+[[nodiscard]] Eigen::Index gate_row(SimdLevel level, const T *cc,
+                                    Eigen::Index n, double gate, J *kk,
+                                    T *out) noexcept {
+#ifdef ASAP_HAS_X86_SIMD
+  if constexpr (has_simd_kernels_v<T, J>) {
+    if (level == SimdLevel::Avx512) {
+      return gate_row_avx512(cc, n, gate, kk, out);
+    }
+    if (level == SimdLevel::Avx2) {
+      return gate_row_avx2(cc, n, gate, kk, out);
+    }
+  }
+#endif
+  static_cast<void>(level);
+  return gate_row_scalar(cc, 0, n, gate, kk, out);
+}
+
+} // namespace internal
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,179 @@
+#ifndef ASAP_SOLVER_STATS_HPP
+#define ASAP_SOLVER_STATS_HPP
+
+#include "common.hpp"
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace asap {
+
+/** @brief Phases of a LAPJVsp solve.
+ *
+ * Feasibility is the optional maximum cardinality matching, WarmStart the
+ * check of a given start against complementary slackness. Rectangular
+ * problems run a RowReduction in place of the column reduction and reduction
+ * transfer. The augmenting row reduction records one phase per pass.
+ */
+enum class SolverPhase {
+  Feasibility,
+  ColumnReduction,
+  ReductionTransfer,
+  RowReduction,
+  AugmentingRowReduction,
+  WarmStart,
+  Augmentation
+};
+
+[[nodiscard]] constexpr const char *to_string(SolverPhase phase) noexcept {
+  switch (phase) {
+  case SolverPhase::Feasibility:
+    return "feasibility";
+  case SolverPhase::ColumnReduction:
+    return "column_reduction";
+  case SolverPhase::ReductionTransfer:
+    return "reduction_transfer";
+  case SolverPhase::RowReduction:
+    return "row_reduction";
+  case SolverPhase::AugmentingRowReduction:
+    return "augmenting_row_reduction";
+  case SolverPhase::WarmStart:
+    return "warm_start";
+  case SolverPhase::Augmentation:
+    return "augmentation";
+  }
+  return "";
+}
+
+/** @brief Statistics policy that records nothing.
+ *
+ * The default policy of SparseJonkerVolgenantWorkspace. All hooks are empty
+ * inline functions, so an uninstrumented solve compiles to the same code as
+ * one without hooks.
+ */
+struct NoSolverStats {
+  void reset() noexcept {}
+  void begin_phase(SolverPhase) noexcept {}
+  void end_phase(SolverPhase, Eigen::Index) noexcept {}
+  void augmenting_path(Eigen::Index) noexcept {}
+  void relax_edges(Eigen::Index) noexcept {}
+  void min_scan() noexcept {}
+};
+
+/** @brief Wall time and free rows left after one phase of a solve.
+ *
+ * Times are in microseconds since the start of the solve.
+ */
+struct PhaseStats {
+  SolverPhase phase{};
+  double start{};
+  double duration{};
+  Eigen::Index free_rows{};
+};
+
+/** @brief Statistics policy that records the last solve.
+ *
+ * Records the phases with their timings and the free rows left after each,
+ * the number of columns of every augmenting path, the edges relaxed by the
+ * shortest path searches and the number of minimum scans. A minimum scan is
+ * a pass over all columns of the linear scan search or a heap pop of the
+ * heap search. Buffers are kept across solves and allocated by A, rebound to
+ * their element type. A workspace constructs its stats from its own
+ * allocator if A can be converted from it.
+ */
+template <typename A = std::allocator<PhaseStats>> struct BasicSolverStats {
+  using Clock = std::chrono::steady_clock;
+
+  BasicSolverStats() = default;
+
+  explicit BasicSolverStats(const A &alloc) noexcept
+      : phases{alloc}, path_lengths{alloc} {}
+
+  using allocator_type = A;
+
+  void reset() noexcept;
+  void begin_phase(SolverPhase phase) noexcept;
+  void end_phase(SolverPhase phase, Eigen::Index free_rows);
+  void augmenting_path(Eigen::Index length) { path_lengths.push_back(length); }
+  void relax_edges(Eigen::Index edges) noexcept { edge_relaxations += edges; }
+  void min_scan() noexcept { ++min_scans; }
+
+  internal::rebind_vector_t<PhaseStats, A> phases{};
+  internal::rebind_vector_t<Eigen::Index, A> path_lengths{};
+  Eigen::Index edge_relaxations{};
+  Eigen::Index min_scans{};
+
+private:
+  [[nodiscard]] double since_origin() const noexcept;
+
+  Clock::time_point origin_{};
+  double phase_start_{};
+};
+
+using SolverStats = BasicSolverStats<>;
+
+template <typename A> void BasicSolverStats<A>::reset() noexcept {
+  phases.clear();
+  path_lengths.clear();
+  edge_relaxations = 0;
+  min_scans = 0;
+  origin_ = Clock::now();
+  phase_start_ = 0.0;
+}
+
+template <typename A>
+void BasicSolverStats<A>::begin_phase(SolverPhase) noexcept {
+  phase_start_ = since_origin();
+}
+
+template <typename A>
+void BasicSolverStats<A>::end_phase(SolverPhase phase,
+                                    Eigen::Index free_rows) {
+  const auto now = since_origin();
+  phases.push_back({phase, phase_start_, now - phase_start_, free_rows});
+}
+
+template <typename A>
+double BasicSolverStats<A>::since_origin() const noexcept {
+  return std::chrono::duration<double, std::micro>(Clock::now() - origin_)
+      .count();
+}
+
+/** @brief Writes stats in the Chrome trace event format.
+ *
+ * Each phase becomes a complete event with its free rows as argument. The
+ * counters and path lengths follow as a counter event at the end of the
+ * last phase. The output loads into chrome://tracing and Perfetto.
+ */
+template <typename A>
+void write_chrome_trace(std::ostream &os, const BasicSolverStats<A> &stats) {
+  auto end = 0.0;
+  os << "{\"traceEvents\":[";
+  for (const auto &p : stats.phases) {
+    os << "{\"name\":\"" << to_string(p.phase) << "\",\"cat\":\"lapjvsp\","
+       << "\"ph\":\"X\",\"ts\":" << p.start << ",\"dur\":" << p.duration
+       << ",\"pid\":1,\"tid\":1,\"args\":{\"free_rows\":" << p.free_rows
+       << "}},";
+    end = std::max(end, p.start + p.duration);
+  }
+  const auto longest =
+      stats.path_lengths.empty()
+          ? Eigen::Index{0}
+          : *std::max_element(stats.path_lengths.begin(),
+                              stats.path_lengths.end());
+  os << "{\"name\":\"counters\",\"cat\":\"lapjvsp\",\"ph\":\"C\",\"ts\":" << end
+     << ",\"pid\":1,\"tid\":1,\"args\":{"
+     << "\"edge_relaxations\":" << stats.edge_relaxations
+     << ",\"min_scans\":" << stats.min_scans
+     << ",\"augmenting_paths\":" << stats.path_lengths.size()
+     << ",\"longest_augmenting_path\":" << longest << "}}]}";
+}
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef ASAP_SPARSE_ASSIGNMENT_ANALYSIS_HPP
+#define ASAP_SPARSE_ASSIGNMENT_ANALYSIS_HPP
+
+#include "sparse_assignment_decomposition.hpp"
+
+namespace asap {
+
+/** @brief Symbolic analysis of a sparsity pattern and the numeric buffers.
+ *
+ * Like the analyze and factorize steps of a sparse factorization, everything
+ * that only depends on the pattern is computed once by
+ * analyze_sparse_assignment_problem: the CSR layout with rows <= cols
+ * including any transpose, the storage position of every entry in source,
+ * the feasibility of the pattern and its split into connected components.
+ * Each solve then only gathers the costs into this layout and runs LAPJVsp,
+ * on the components in parallel if there are several of them and the
+ * options ask for more than one thread.
+ */
+template <typename T> struct SparseAssignmentAnalysis {
+  CompressedSparseRowMatrix<T> csr{};
+  std::vector<Eigen::Index> source{};
+  std::vector<Eigen::Index> block_source{};
+  std::vector<Eigen::Index> count{};
+  SparseAssignmentDecompositionWorkspace<T> decomposition{};
+  SparseJonkerVolgenantWorkspace<T> solver{};
+
+  // Shape of the analyzed problem and length of its value array.
+  Eigen::Index rows{};
+  Eigen::Index cols{};
+  Eigen::Index values{};
+  // Whether csr is the transpose of the analyzed problem.
+  bool transposed{};
+  bool feasible{};
+  bool analyzed{};
+};
+
+namespace internal {
+
+/** @brief Lays out the pattern of an outer-major storage as CSR.
+ *
+ * The storage has outer vectors [0, outer) whose entries begin(o) <= p <
+ * end(o) lie in inner vector index(p). If the storage has more outer than
+ * inner vectors it is transposed by a counting sort, so the layout always
+ * has rows <= cols. source maps every entry of the layout to its storage
+ * position p, which is all a solve needs to gather new costs.
+ */
+template <typename T, typename Begin, typename End, typename Inner>
+void analyze_storage(Eigen::Index outer, Eigen::Index inner,
+                     bool storage_transposed, Begin &&begin, End &&end,
+                     Inner &&index, SparseAssignmentAnalysis<T> &analysis) {
+  using I = Eigen::Index;
+
+  auto &csr = analysis.csr;
+  auto &source = analysis.source;
+  auto &count = analysis.count;
+
+  auto nnz = I{0};
+  auto values = I{0};
+  for (I o = 0; o < outer; ++o) {
+    nnz += end(o) - begin(o);
+    values = std::max(values, I{end(o)});
+  }
+  csr.val.assign(nnz, T{0});
+  csr.col_ind.resize(nnz);
+  source.resize(nnz);
+  analysis.values = values;
+
+  const auto swap = outer > inner;
+  analysis.transposed = storage_transposed != swap;
+  csr.rows = swap ? inner : outer;
+  csr.cols = swap ? outer : inner;
+  csr.row_ptr.resize(csr.rows + 1);
+  csr.row_ptr[0] = 0;
+  if (!swap) {
+    auto t = I{0};
+    for (I o = 0; o < outer; ++o) {
+      for (I p = begin(o); p < end(o); ++p) {
+        csr.col_ind[t] = index(p);
+        source[t] = p;
+        ++t;
+      }
+      csr.row_ptr[o + 1] = t;
+    }
+    return;
+  }
+
+  // Counting sort by inner index, which keeps the columns of each row of the
+  // transposed layout sorted.
+  count.assign(inner + 1, I{0});
+  for (I o = 0; o < outer; ++o) {
+    for (I p = begin(o); p < end(o); ++p) {
+      ++count[index(p) + 1];
+    }
+  }
+  std::partial_sum(count.begin(), count.end(), count.begin());
+  std::copy(count.begin() + 1, count.end(), csr.row_ptr.begin() + 1);
+  for (I o = 0; o < outer; ++o) {
+    for (I p = begin(o); p < end(o); ++p) {
+      const auto t = count[index(p)]++;
+      csr.col_ind[t] = o;
+      source[t] = p;
+    }
+  }
+}
+
+/** @brief Finds the feasibility and components of the analyzed layout.
+ *
+ * The components are only kept if there is more than one, block_source then
+ * maps every entry of the concatenated blocks to its entry in csr.
+ */
+template <typename T>
+void analyze_structure(SparseAssignmentAnalysis<T> &analysis) {
+  using I = Eigen::Index;
+
+  const auto &csr = analysis.csr;
+  auto &decomposition = analysis.decomposition;
+
+  hopcroft_karp(csr, analysis.solver.matching);
+  analysis.feasible = analysis.solver.matching.matched == csr.rows;
+  analysis.analyzed = true;
+  decomposition.components = 0;
+  if (!analysis.feasible || !decompose(csr, decomposition) ||
+      (decomposition.components < 2)) {
+    decomposition.components = 0;
+    return;
+  }
+
+  auto &block_source = analysis.block_source;
+  block_source.resize(csr.val.size());
+  auto k = I{0};
+  for (const auto i : decomposition.rows) {
+    for (I t = csr.row_ptr[i]; t < csr.row_ptr[i + 1]; ++t) {
+      block_source[k++] = t;
+    }
+  }
+}
+
+/** @brief Marks res invalid, keeping its buffers for later solves.
+ */
+template <typename T> void invalidate_result(Result<T> &res) {
+  res.valid = false;
+  res.row_idx.clear();
+  res.col_idx.clear();
+  res.u.clear();
+  res.v.clear();
+}
+
+/** @brief Solves the analyzed layout with the costs value(p) of storage
+ * position p.
+ */
+template <typename T, typename F>
+void solve_analyzed(F &&value, SparseAssignmentAnalysis<T> &analysis,
+                    Result<T> &res,
+                    const SparseAssignmentDecompositionOptions &options) {
+  using I = Eigen::Index;
+
+  auto &csr = analysis.csr;
+  auto &ws = analysis.decomposition;
+  if (!analysis.feasible) {
+    invalidate_result(res);
+    return;
+  }
+
+  const auto nnz = static_cast<I>(csr.val.size());
+  for (I t = 0; t < nnz; ++t) {
+    csr.val[t] = value(analysis.source[t]);
+  }
+
+  // The analysis already proved the pattern feasible.
+  auto solver_options = options.solver;
+  solver_options.check_feasibility = false;
+
+  // Components only pay off when they are solved in parallel, a single
+  // thread solves the whole layout at once.
+  auto valid = false;
+  if ((ws.components == 0) || (options.num_threads == 1)) {
+    lapjvsp(csr, analysis.solver, solver_options, valid);
+    assign_result(csr, analysis.solver.x, analysis.solver.v,
+                  analysis.transposed, valid, analysis.solver.match, res);
+    return;
+  }
+
+  for (I k = 0; k < nnz; ++k) {
+    ws.blocks.val[k] = csr.val[analysis.block_source[k]];
+  }
+  solve_sparse_assignment_problems(
+      ws.views.begin(), ws.views.end(), ws.batch, ws.results,
+      SparseAssignmentBatchOptions{options.num_threads, solver_options});
+  valid = std::all_of(ws.results.begin(), ws.results.end(),
+                      [](const auto &r) { return r.valid; });
+  if (valid) {
+    ws.v.assign(csr.cols, T{0});
+    stitch(csr, ws);
+  }
+  assign_result(csr, ws.x, ws.v, analysis.transposed, valid, ws.match, res);
+}
+
+} // namespace internal
+
+/** @brief Analyzes the sparsity pattern of sm for repeated solves.
+ *
+ * Only the pattern of sm is read, its costs are ignored. The analysis stays
+ * valid for every matrix with the same shape and storage layout, for example
+ * the same gating with new costs, which is then solved by passing it to
+ * solve_sparse_assignment_problem together with the analysis.
+ */
+template <typename SparseMatrixT>
+std::enable_if_t<is_sparse_matrix_v<SparseMatrixT>>
+analyze_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseAssignmentAnalysis<typename SparseMatrixT::Scalar> &analysis) {
+  const auto *outer = sm.outerIndexPtr();
+  const auto *inner_non_zeros = sm.innerNonZeroPtr();
+  const auto *inner = sm.innerIndexPtr();
+  internal::analyze_storage(
+      sm.outerSize(), sm.innerSize(), is_col_major_v<SparseMatrixT>,
+      [&](Eigen::Index o) { return Eigen::Index{outer[o]}; },
+      [&](Eigen::Index o) {
+        return Eigen::Index{inner_non_zeros ? outer[o] + inner_non_zeros[o]
+                                            : outer[o + 1]};
+      },
+      [&](Eigen::Index p) { return Eigen::Index{inner[p]}; }, analysis);
+  analysis.rows = sm.rows();
+  analysis.cols = sm.cols();
+  internal::analyze_structure(analysis);
+}
+
+template <typename ViewT>
+std::enable_if_t<is_compressed_sparse_row_matrix_view_v<ViewT> ||
+                 is_interleaved_compressed_sparse_row_matrix_view_v<ViewT>>
+analyze_sparse_assignment_problem(
+    const ViewT &csr,
+    SparseAssignmentAnalysis<typename ViewT::Scalar> &analysis) {
+  internal::analyze_storage(
+      csr.rows, csr.cols, false,
+      [&](Eigen::Index o) { return Eigen::Index{csr.row_ptr[o]}; },
+      [&](Eigen::Index o) { return Eigen::Index{csr.row_ptr[o + 1]}; },
+      [&](Eigen::Index p) { return Eigen::Index{csr.col_ind[p]}; }, analysis);
+  analysis.rows = csr.rows;
+  analysis.cols = csr.cols;
+  internal::analyze_structure(analysis);
+}
+
+/** @brief Solves sm with the pattern previously analyzed into analysis.
+ *
+ * The costs are gathered straight from the storage of sm into the analyzed
+ * layout, so no transpose, sort, feasibility check or component search is
+ * repeated. sm must have the analyzed pattern; a different shape or storage
+ * size gives an invalid result.
+ */
+template <typename SparseMatrixT>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseAssignmentAnalysis<typename SparseMatrixT::Scalar> &analysis,
+    Result<typename SparseMatrixT::Scalar> &res,
+    const SparseAssignmentDecompositionOptions &options = {}) {
+  auto fits = analysis.analyzed;
+  if constexpr (is_sparse_matrix_v<SparseMatrixT>) {
+    fits = fits && (sm.rows() == analysis.rows) &&
+           (sm.cols() == analysis.cols) &&
+           (sm.data().size() >= analysis.values);
+  } else {
+    fits = fits && (sm.rows == analysis.rows) && (sm.cols == analysis.cols) &&
+           (sm.row_ptr[sm.rows] >= analysis.values);
+  }
+  if (!fits) {
+    internal::invalidate_result(res);
+    return;
+  }
+  if constexpr (is_sparse_matrix_v<SparseMatrixT>) {
+    const auto *val = sm.valuePtr();
+    internal::solve_analyzed([&](Eigen::Index p) { return val[p]; }, analysis,
+                             res, options);
+  } else {
+    internal::solve_analyzed([&](Eigen::Index p) { return sm.val[p]; },
+                             analysis, res, options);
+  }
+}
+
+/** @brief Solves the analyzed pattern with the costs in values.
+ *
+ * values holds the costs in the storage order of the analyzed matrix, that
+ * is values[p] is the cost at position p of its value array.
+ */
+template <typename Derived>
+void solve_sparse_assignment_problem(
+    const Eigen::DenseBase<Derived> &values,
+    SparseAssignmentAnalysis<typename Derived::Scalar> &analysis,
+    Result<typename Derived::Scalar> &res,
+    const SparseAssignmentDecompositionOptions &options = {}) {
+  if (!analysis.analyzed || (values.size() < analysis.values)) {
+    internal::invalidate_result(res);
+    return;
+  }
+  internal::solve_analyzed([&](Eigen::Index p) { return values.coeff(p); },
+                           analysis, res, options);
+}
+
+} // namespace asap
+
+#endif
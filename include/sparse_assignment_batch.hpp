@@ -0,0 +1,125 @@
+#ifndef ASAP_SPARSE_ASSIGNMENT_BATCH_HPP
+#define ASAP_SPARSE_ASSIGNMENT_BATCH_HPP
+
+#include "sparse_jonker_volgenant_solver.hpp"
+#include "thread_pool.hpp"
+
+#include <iterator>
+
+namespace asap {
+
+struct SparseAssignmentBatchOptions {
+  std::size_t num_threads{0};
+  SparseJonkerVolgenantOptions solver{};
+};
+
+/** @brief Owns the thread pool and one LAPJVsp workspace per thread.
+ *
+ * Like the single problem workspaces, a batch workspace only grows, so
+ * repeated batches of similar problems do not touch the heap.
+ */
+template <typename T> struct SparseAssignmentBatchWorkspace {
+  void reset(std::size_t n, std::size_t num_threads);
+
+  std::unique_ptr<ThreadPool> pool{};
+  std::vector<SparseJonkerVolgenantWorkspace<T>> solver{};
+  std::vector<std::size_t> order{};
+  std::vector<Eigen::Index> non_zeros{};
+};
+
+template <typename T>
+void SparseAssignmentBatchWorkspace<T>::reset(std::size_t n,
+                                              std::size_t num_threads) {
+  internal::reset_thread_pool(pool, num_threads);
+  if (solver.size() < pool->size()) {
+    solver.resize(pool->size());
+  }
+  order.resize(n);
+  non_zeros.resize(n);
+}
+
+namespace internal {
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<is_sparse_matrix_v<SparseMatrixT>, Eigen::Index>
+non_zeros(const SparseMatrixT &sm) {
+  return sm.nonZeros();
+}
+
+template <typename T, typename I>
+[[nodiscard]] Eigen::Index
+non_zeros(const CompressedSparseRowMatrixView<T, I> &csr) {
+  return csr.row_ptr[csr.rows] - csr.row_ptr[0];
+}
+
+template <typename T, typename I>
+[[nodiscard]] Eigen::Index
+non_zeros(const InterleavedCompressedSparseRowMatrixView<T, I> &csr) {
+  return csr.row_ptr[csr.rows] - csr.row_ptr[0];
+}
+
+} // namespace internal
+
+/** @brief Solves the independent problems in [first, last) in parallel.
+ *
+ * res[k] receives the result of problem first[k]. The problems are handed
+ * out to the threads of the pool one at a time in order of decreasing
+ * non-zeros, so large problems start first and threads that run out of
+ * work pick up the remaining small ones. Each thread solves with its own
+ * workspace. A concatenated block-CSR is solved by passing one
+ * CompressedSparseRowMatrixView per block into the shared buffers.
+ */
+template <typename RandomIt>
+std::enable_if_t<is_sparse_assignment_problem_v<
+    typename std::iterator_traits<RandomIt>::value_type>>
+solve_sparse_assignment_problems(
+    RandomIt first, RandomIt last,
+    SparseAssignmentBatchWorkspace<
+        typename std::iterator_traits<RandomIt>::value_type::Scalar> &ws,
+    std::vector<
+        Result<typename std::iterator_traits<RandomIt>::value_type::Scalar>>
+        &res,
+    const SparseAssignmentBatchOptions &options = {}) {
+  const auto n = static_cast<std::size_t>(std::distance(first, last));
+  ws.reset(n, options.num_threads);
+  res.resize(n);
+
+  for (std::size_t k = 0; k < n; ++k) {
+    ws.order[k] = k;
+    ws.non_zeros[k] = internal::non_zeros(first[k]);
+  }
+  std::sort(ws.order.begin(), ws.order.end(),
+            [&nnz = ws.non_zeros](std::size_t lhs, std::size_t rhs) {
+              return (nnz[lhs] > nnz[rhs]) ||
+                     ((nnz[lhs] == nnz[rhs]) && (lhs < rhs));
+            });
+
+  ws.pool->parallel_for(
+      n, 1, [&](std::size_t begin, std::size_t end, std::size_t thread) {
+        for (auto k = begin; k < end; ++k) {
+          const auto p = ws.order[k];
+          solve_sparse_assignment_problem(first[p], ws.solver[thread], res[p],
+                                          options.solver);
+        }
+      });
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<
+    is_sparse_assignment_problem_v<SparseMatrixT>,
+    std::vector<Result<typename SparseMatrixT::Scalar>>>
+solve_sparse_assignment_problems(
+    const std::vector<SparseMatrixT> &problems,
+    const SparseAssignmentBatchOptions &options = {}) {
+  using ScalarT = typename SparseMatrixT::Scalar;
+
+  auto ws = SparseAssignmentBatchWorkspace<ScalarT>{};
+  auto res = std::vector<Result<ScalarT>>{};
+  solve_sparse_assignment_problems(problems.begin(), problems.end(), ws, res,
+                                   options);
+  return res;
+}
+
+} // namespace asap
+
+#endif
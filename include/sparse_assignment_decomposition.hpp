@@ -0,0 +1,283 @@
+#ifndef ASAP_SPARSE_ASSIGNMENT_DECOMPOSITION_HPP
+#define ASAP_SPARSE_ASSIGNMENT_DECOMPOSITION_HPP
+
+#include "sparse_assignment_batch.hpp"
+
+namespace asap {
+
+/** @brief Configures the solve by connected components.
+ *
+ * Components are solved by LAPJVsp with the given options on num_threads
+ * threads, where 0 selects the number of hardware threads.
+ */
+struct SparseAssignmentDecompositionOptions {
+  std::size_t num_threads{1};
+  SparseJonkerVolgenantOptions solver{};
+};
+
+/** @brief Owns all buffers needed to split a problem into its components.
+ *
+ * Rows and columns are the nodes and non-zeros the edges of the bipartite
+ * graph. Nodes [0, rows) are rows and nodes [rows, rows + cols) columns.
+ */
+template <typename T> struct SparseAssignmentDecompositionWorkspace {
+  void reset(Eigen::Index nr, Eigen::Index nc);
+
+  CompressedSparseRowMatrix<T> csr{};
+  std::vector<Eigen::Index> parent{};
+  std::vector<Eigen::Index> size{};
+  std::vector<Eigen::Index> label{};
+  std::vector<Eigen::Index> local{};
+  std::vector<Eigen::Index> row_begin{};
+  std::vector<Eigen::Index> col_begin{};
+  std::vector<Eigen::Index> rows{};
+  std::vector<Eigen::Index> cols{};
+  CompressedSparseRowMatrix<T> blocks{};
+  std::vector<CompressedSparseRowMatrixView<T, Eigen::Index>> views{};
+  SparseAssignmentBatchWorkspace<T> batch{};
+  std::vector<Result<T>> results{};
+  std::vector<Eigen::Index> x{};
+  std::vector<T> v{};
+  std::vector<Eigen::Index> match{};
+
+  // Number of components with at least one row of the last solve.
+  Eigen::Index components{};
+};
+
+template <typename T>
+void SparseAssignmentDecompositionWorkspace<T>::reset(Eigen::Index nr,
+                                                      Eigen::Index nc) {
+  parent.resize(nr + nc);
+  std::iota(parent.begin(), parent.end(), Eigen::Index{0});
+  size.assign(nr + nc, Eigen::Index{1});
+  label.assign(nr + nc, Eigen::Index{-1});
+  local.resize(nr + nc);
+  rows.resize(nr);
+  cols.resize(nc);
+  x.assign(nr, Eigen::Index{-1});
+  v.assign(nc, T{0});
+  components = 0;
+}
+
+namespace internal {
+
+/** @brief Finds the root of node a, halving the path on the way.
+ */
+[[nodiscard]] inline Eigen::Index find_root(std::vector<Eigen::Index> &parent,
+                                            Eigen::Index a) {
+  while (parent[a] != a) {
+    parent[a] = parent[parent[a]];
+    a = parent[a];
+  }
+  return a;
+}
+
+/** @brief Splits csr into the independent problems of its components.
+ *
+ * Components are found by union-find with union by size and path halving in
+ * near-linear time. Every component with at least one row becomes a block of
+ * the concatenated block-CSR ws.blocks with component-local column indices,
+ * addressed by one view in ws.views. ws.rows and ws.cols list the original
+ * rows and columns of each component. Returns false as soon as a component
+ * has more rows than columns, which makes the problem infeasible.
+ */
+template <typename MatrixT, typename T>
+[[nodiscard]] bool decompose(const MatrixT &csr,
+                             SparseAssignmentDecompositionWorkspace<T> &ws) {
+  using I = Eigen::Index;
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = I{csr.rows};
+  const auto nc = I{csr.cols};
+  auto &parent = ws.parent;
+  auto &size = ws.size;
+  auto &label = ws.label;
+  auto &local = ws.local;
+  auto &row_begin = ws.row_begin;
+  auto &col_begin = ws.col_begin;
+
+  ws.reset(nr, nc);
+
+  for (I i = 0; i < nr; ++i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      auto a = find_root(parent, i);
+      auto b = find_root(parent, nr + kk[t]);
+      if (a == b) {
+        continue;
+      }
+      if (size[a] < size[b]) {
+        std::swap(a, b);
+      }
+      parent[b] = a;
+      size[a] += size[b];
+    }
+  }
+
+  // Label components in order of their first row, columns without rows are
+  // left unlabelled. local temporarily holds the component of every node.
+  auto n_components = I{0};
+  for (I a = 0; a < nr + nc; ++a) {
+    const auto root = find_root(parent, a);
+    if ((label[root] == -1) && (a < nr)) {
+      label[root] = n_components;
+      ++n_components;
+    }
+    local[a] = label[root];
+  }
+  ws.components = n_components;
+
+  row_begin.assign(n_components + 1, I{0});
+  col_begin.assign(n_components + 1, I{0});
+  for (I i = 0; i < nr; ++i) {
+    ++row_begin[local[i] + 1];
+  }
+  for (I j = 0; j < nc; ++j) {
+    if (local[nr + j] != -1) {
+      ++col_begin[local[nr + j] + 1];
+    }
+  }
+  for (I c = 0; c < n_components; ++c) {
+    if (row_begin[c + 1] > col_begin[c + 1]) {
+      return false;
+    }
+    row_begin[c + 1] += row_begin[c];
+    col_begin[c + 1] += col_begin[c];
+  }
+
+  // Counting sort of rows and columns by component, label is reused as the
+  // insertion cursor of each component.
+  std::copy(row_begin.begin(), row_begin.end() - 1, label.begin());
+  for (I i = 0; i < nr; ++i) {
+    const auto k = label[local[i]]++;
+    ws.rows[k] = i;
+    local[i] = k - row_begin[local[i]];
+  }
+  std::copy(col_begin.begin(), col_begin.end() - 1, label.begin());
+  for (I j = 0; j < nc; ++j) {
+    if (local[nr + j] == -1) {
+      continue;
+    }
+    const auto k = label[local[nr + j]]++;
+    ws.cols[k] = j;
+    local[nr + j] = k - col_begin[local[nr + j]];
+  }
+
+  auto &blocks = ws.blocks;
+  blocks.rows = nr;
+  blocks.cols = nc;
+  blocks.val.resize(first[nr] - first[0]);
+  blocks.col_ind.resize(first[nr] - first[0]);
+  blocks.row_ptr.resize(nr + 1);
+  blocks.row_ptr[0] = 0;
+  auto nnz = I{0};
+  for (I k = 0; k < nr; ++k) {
+    const auto i = ws.rows[k];
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      blocks.val[nnz] = cc[t];
+      blocks.col_ind[nnz] = local[nr + kk[t]];
+      ++nnz;
+    }
+    blocks.row_ptr[k + 1] = nnz;
+  }
+
+  ws.views.clear();
+  for (I c = 0; c < n_components; ++c) {
+    ws.views.emplace_back(blocks.val.data(), blocks.col_ind.data(),
+                          blocks.row_ptr.data() + row_begin[c],
+                          row_begin[c + 1] - row_begin[c],
+                          col_begin[c + 1] - col_begin[c]);
+  }
+  return true;
+}
+
+/** @brief Maps the component results back to the rows and columns of csr.
+ *
+ * Fills the row assignment ws.x and the column duals ws.v. On rectangular
+ * problems positive duals of square components are shifted down to zero,
+ * the dual of the unassigned columns, so they certify optimality of the
+ * stitched assignment.
+ */
+template <typename MatrixT, typename T>
+void stitch(const MatrixT &csr,
+            SparseAssignmentDecompositionWorkspace<T> &ws) {
+  using I = Eigen::Index;
+
+  const auto nr = I{csr.rows};
+  const auto nc = I{csr.cols};
+
+  for (I c = 0; c < ws.components; ++c) {
+    const auto &res = ws.results[c];
+    const auto row_offset = ws.row_begin[c];
+    const auto col_offset = ws.col_begin[c];
+    const auto n_rows = ws.row_begin[c + 1] - row_offset;
+    const auto n_cols = ws.col_begin[c + 1] - col_offset;
+
+    for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+      ws.x[ws.rows[row_offset + res.row_idx[k]]] =
+          ws.cols[col_offset + res.col_idx[k]];
+    }
+    auto shift = T{0};
+    if ((nr < nc) && (n_rows == n_cols)) {
+      shift = std::max(*std::max_element(res.v.begin(), res.v.end()),
+                       shift);
+    }
+    for (I l = 0; l < n_cols; ++l) {
+      ws.v[ws.cols[col_offset + l]] = res.v[l] - shift;
+    }
+  }
+}
+
+} // namespace internal
+
+/** @brief Solves the sparse assignment problem component by component.
+ *
+ * Problems whose bipartite graph falls apart into many components are split
+ * into independent problems that are solved, optionally in parallel, and
+ * stitched back into one result with the original indices. Components with
+ * more rows than columns are detected before any of them is solved.
+ */
+template <typename SparseMatrixT>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseAssignmentDecompositionWorkspace<typename SparseMatrixT::Scalar> &ws,
+    Result<typename SparseMatrixT::Scalar> &res,
+    const SparseAssignmentDecompositionOptions &options = {}) {
+  internal::visit_compressed_sparse_row_matrix(
+      sm, ws.csr, [&](const auto &csr, bool transposed) {
+        auto valid = internal::decompose(csr, ws);
+        if (valid) {
+          solve_sparse_assignment_problems(
+              ws.views.begin(), ws.views.end(), ws.batch, ws.results,
+              SparseAssignmentBatchOptions{options.num_threads,
+                                           options.solver});
+          valid = std::all_of(ws.results.begin(), ws.results.end(),
+                              [](const auto &r) { return r.valid; });
+        }
+        if (valid) {
+          internal::stitch(csr, ws);
+        }
+        internal::assign_result(csr, ws.x, ws.v, transposed, valid, ws.match,
+                                res);
+      });
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<
+    is_sparse_assignment_problem_v<SparseMatrixT>,
+    Result<typename std::decay_t<SparseMatrixT>::Scalar>>
+solve_sparse_assignment_problem(
+    SparseMatrixT &&sm, const SparseAssignmentDecompositionOptions &options) {
+  using ScalarT = typename std::decay_t<SparseMatrixT>::Scalar;
+
+  auto ws = SparseAssignmentDecompositionWorkspace<ScalarT>{};
+  auto res = Result<ScalarT>{};
+  solve_sparse_assignment_problem(sm, ws, res, options);
+  return res;
+}
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,555 @@
+#ifndef ASAP_SPARSE_ASSIGNMENT_K_BEST_HPP
+#define ASAP_SPARSE_ASSIGNMENT_K_BEST_HPP
+
+#include "common.hpp"
+#include "sparse_assignment_problem.hpp"
+#include "sparse_jonker_volgenant_solver_impl.hpp"
+
+#include <tuple>
+
+namespace asap {
+
+/** @brief The k best assignments of a sparse assignment problem.
+ *
+ * assignments[n] is the n-th best assignment with total cost costs[n], in
+ * order of non-decreasing cost. Its duals certify optimality within the
+ * subproblem of the Murty partition it was found in, which for n = 0 is the
+ * whole problem. Fewer than k assignments are returned if the problem has
+ * fewer, and none if it is infeasible.
+ */
+template <typename T = double, typename I = Eigen::Index> struct KBestResult {
+  std::vector<Result<T, I>> assignments{};
+  std::vector<T> costs{};
+};
+
+namespace internal {
+
+/** @brief A solved subproblem of the Murty partition.
+ *
+ * The rows [0, fixed) keep the columns of x_edge, the CSR edges in excluded
+ * are removed, and x_edge and v are an optimal assignment and column duals
+ * of the remaining problem. On rectangular problems order lists the columns
+ * by decreasing dual.
+ */
+template <typename T, typename I> struct KBestNode {
+  T cost{};
+  I fixed{};
+  std::vector<I> x_edge{};
+  std::vector<T> v{};
+  std::vector<I> excluded{};
+  std::vector<I> order{};
+};
+
+/** @brief A subproblem of the Murty partition that is not materialized yet.
+ *
+ * The child of node that fixes the rows [0, row) and excludes the edge of row
+ * in node. cost is a lower bound on its optimal cost unless exact is set.
+ */
+template <typename T, typename I> struct KBestCandidate {
+  T cost{};
+  I node{};
+  I row{};
+  bool exact{};
+};
+
+} // namespace internal
+
+/** @brief Owns all buffers needed to enumerate the k best assignments.
+ *
+ * nodes holds the solved subproblems of the last enumeration, at most k, and
+ * queue its unsolved children. The search buffers are reused across solves.
+ */
+template <typename T, typename I = Eigen::Index>
+struct SparseAssignmentKBestWorkspace {
+  void reset(Eigen::Index nr, Eigen::Index nc, Eigen::Index nnz);
+
+  CompressedSparseRowMatrix<T, I> csr{};
+  SparseJonkerVolgenantWorkspace<T, I> solver{};
+  std::vector<internal::KBestNode<T, I>> nodes{};
+  std::vector<internal::KBestCandidate<T, I>> queue{};
+  std::vector<I> x{};
+  std::vector<I> x_edge{};
+  std::vector<I> y{};
+  std::vector<I> y_edge{};
+  std::vector<T> u{};
+  std::vector<T> v{};
+  std::vector<T> d{};
+  std::vector<T> col_min{};
+  std::vector<bool> ok{};
+  std::vector<bool> fixed{};
+  std::vector<bool> excluded{};
+  std::vector<I> lab{};
+  std::vector<I> lab_edge{};
+  std::vector<I> scanned{};
+  std::vector<I> touched{};
+  std::vector<std::pair<T, I>> heap{};
+  std::vector<I> match{};
+
+  // Number of subproblems solved by a single augmentation in the last solve.
+  Eigen::Index augmentations{};
+};
+
+template <typename T, typename I>
+void SparseAssignmentKBestWorkspace<T, I>::reset(Eigen::Index nr,
+                                                 Eigen::Index nc,
+                                                 Eigen::Index nnz) {
+  queue.clear();
+  x.assign(nr, I{-1});
+  x_edge.assign(nr, I{-1});
+  y.assign(nc, I{-1});
+  y_edge.assign(nc, I{-1});
+  u.assign(nr, T{0});
+  v.assign(nc, T{0});
+  d.assign(nc, internal::infinity<T>());
+  col_min.assign(nc, internal::infinity<T>());
+  ok.assign(nc, false);
+  fixed.assign(nc, false);
+  excluded.assign(nnz, false);
+  lab.assign(nc, I{-1});
+  lab_edge.assign(nc, I{-1});
+  scanned.clear();
+  touched.clear();
+  heap.clear();
+  augmentations = 0;
+}
+
+namespace internal {
+
+/** @brief Reassigns the free row i0 along a shortest augmenting path.
+ *
+ * ws.x, ws.y, ws.x_edge, ws.y_edge and ws.v hold an optimal assignment of
+ * all other rows with feasible duals, in which column target has just been
+ * released by i0. Fixed columns and excluded edges are skipped. Returns
+ * false if no augmenting path exists.
+ *
+ * On rectangular problems the other unassigned columns stand for the dummy
+ * rows that pad the problem to a square one. Each dummy row reaches every
+ * column at the difference of its dual to the maximal dual. Once the first
+ * unassigned column is settled, the columns reached through the dummy rows
+ * are therefore merged into the search in the order of decreasing duals,
+ * given by order. The path may thus release an assigned column in exchange
+ * for an unassigned one, which a single augmentation of the rectangular
+ * problem would miss.
+ */
+template <typename MatrixT, typename T, typename I>
+[[nodiscard]] bool k_best_augment(const MatrixT &csr,
+                                  SparseAssignmentKBestWorkspace<T, I> &ws,
+                                  const std::vector<I> &order, I i0,
+                                  I target) {
+  static constexpr auto INF = infinity<T>();
+  static constexpr auto DUMMY = I{-2};
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nc = static_cast<I>(csr.cols);
+  auto &x = ws.x;
+  auto &x_edge = ws.x_edge;
+  auto &y = ws.y;
+  auto &y_edge = ws.y_edge;
+  auto &v = ws.v;
+  auto &d = ws.d;
+  auto &ok = ws.ok;
+  auto &lab = ws.lab;
+  auto &lab_edge = ws.lab_edge;
+  auto &scanned = ws.scanned;
+  auto &touched = ws.touched;
+  auto &heap = ws.heap;
+
+  // Min-heap on the reduced distance that prefers target on ties.
+  const auto later = [target](const auto &lhs, const auto &rhs) {
+    return (lhs.first > rhs.first) ||
+           ((lhs.first == rhs.first) && (lhs.second != target) &&
+            (rhs.second == target));
+  };
+  const auto reach = [&](I j, T dj, I i, I t) {
+    if (d[j] == INF) {
+      touched.push_back(j);
+    }
+    d[j] = dj;
+    lab[j] = i;
+    lab_edge[j] = t;
+  };
+  const auto relax = [&](I i, T h) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      const auto j = static_cast<I>(kk[t]);
+      if (!ok[j] && !ws.fixed[j] && !ws.excluded[t]) {
+        const auto dj = cc[t] - v[j] - h;
+        if (dj < d[j]) {
+          reach(j, dj, i, t);
+          heap.emplace_back(dj, j);
+          std::push_heap(heap.begin(), heap.end(), later);
+        }
+      }
+    }
+  };
+  const auto reset = [&]() {
+    for (const auto j : touched) {
+      d[j] = INF;
+      ok[j] = false;
+    }
+    touched.clear();
+    scanned.clear();
+    heap.clear();
+  };
+  // Unassigned columns share the maximal dual, so reaching further ones
+  // through the dummy rows never shortens a path.
+  const auto skip = [&](I k) {
+    return ok[k] || ws.fixed[k] || ((y[k] == -1) && (k != target));
+  };
+
+  // Distance and column at which the search reached the dummy rows, if it
+  // did, and the position of the next column they reach in order.
+  auto dummy = INF;
+  auto dummy_col = I{-1};
+  auto next = std::size_t{0};
+  relax(i0, T{0});
+
+  while (true) {
+    auto j = I{-1};
+    auto min_diff = INF;
+    if (dummy != INF) {
+      while ((next < order.size()) && skip(order[next])) {
+        ++next;
+      }
+      if (next < order.size()) {
+        const auto k = order[next];
+        const auto dk = dummy + v[dummy_col] - v[k];
+        if (heap.empty() || (dk <= heap.front().first)) {
+          ++next;
+          if (dk < d[k]) {
+            reach(k, dk, DUMMY, dummy_col);
+          }
+          j = k;
+          min_diff = d[k];
+        }
+      }
+    }
+    if (j == -1) {
+      if (heap.empty()) {
+        break;
+      }
+      std::pop_heap(heap.begin(), heap.end(), later);
+      std::tie(min_diff, j) = heap.back();
+      heap.pop_back();
+      if (ok[j] || (min_diff > d[j])) {
+        continue;
+      }
+    }
+
+    if (j == target) {
+      for (const auto k : scanned) {
+        v[k] += (d[k] - min_diff);
+      }
+      // All unassigned columns are at distance dummy through the dummy rows.
+      if (dummy != INF) {
+        for (I k = 0; k < nc; ++k) {
+          if ((y[k] == -1) && (k != target)) {
+            v[k] += (dummy - min_diff);
+          }
+        }
+      }
+      auto jp = target;
+      while (true) {
+        if (lab[jp] == DUMMY) {
+          // A dummy row takes jp, its path continues at the dummy's column.
+          y[jp] = -1;
+          y_edge[jp] = -1;
+          jp = lab_edge[jp];
+          continue;
+        }
+        const auto i = lab[jp];
+        const auto prev = x[i];
+        y[jp] = i;
+        y_edge[jp] = lab_edge[jp];
+        x[i] = jp;
+        x_edge[i] = lab_edge[jp];
+        if (i == i0) {
+          break;
+        }
+        jp = prev;
+      }
+      reset();
+      return true;
+    }
+    ok[j] = true;
+    if (y[j] != -1) {
+      scanned.push_back(j);
+      relax(y[j], cc[y_edge[j]] - v[j] - min_diff);
+    } else if (dummy == INF) {
+      dummy = min_diff;
+      dummy_col = j;
+    }
+  }
+
+  reset();
+  return false;
+}
+
+/** @brief Solves the child of ws.nodes[node] that fixes the rows [0, row).
+ *
+ * Starts from the assignment and duals of the node with row released and its
+ * edge excluded, which stay optimal and feasible for all other rows, so a
+ * single augmentation solves the child. On success the child's assignment is
+ * left in ws.x and ws.x_edge, its duals in ws.v, and its cost is returned
+ * through cost.
+ */
+template <typename MatrixT, typename T, typename I>
+[[nodiscard]] bool k_best_solve_child(const MatrixT &csr,
+                                      SparseAssignmentKBestWorkspace<T, I> &ws,
+                                      I node, I row, T &cost) {
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = static_cast<I>(csr.rows);
+  const auto &parent = ws.nodes[node];
+
+  std::copy(parent.x_edge.begin(), parent.x_edge.end(), ws.x_edge.begin());
+  std::copy(parent.v.begin(), parent.v.end(), ws.v.begin());
+  std::fill(ws.y.begin(), ws.y.end(), I{-1});
+  std::fill(ws.fixed.begin(), ws.fixed.end(), false);
+  for (I i = 0; i < nr; ++i) {
+    const auto j = static_cast<I>(kk[ws.x_edge[i]]);
+    ws.x[i] = j;
+    ws.y[j] = i;
+    ws.y_edge[j] = ws.x_edge[i];
+    ws.fixed[j] = (i < row);
+  }
+  for (const auto t : parent.excluded) {
+    ws.excluded[t] = true;
+  }
+  ws.excluded[ws.x_edge[row]] = true;
+
+  const auto target = ws.x[row];
+  ws.y[target] = -1;
+  ws.y_edge[target] = -1;
+  ++ws.augmentations;
+  const auto found = k_best_augment(csr, ws, parent.order, row, target);
+
+  for (const auto t : parent.excluded) {
+    ws.excluded[t] = false;
+  }
+  ws.excluded[parent.x_edge[row]] = false;
+  if (!found) {
+    return false;
+  }
+  cost = T{0};
+  for (I i = 0; i < nr; ++i) {
+    cost += cc[ws.x_edge[i]];
+  }
+  return true;
+}
+
+/** @brief Stores the assignment in ws as solved node and queues its children.
+ *
+ * The child for row r >= fixed excludes the edge of r and is queued with a
+ * lower bound on its cost. Every augmenting path from r leaves r through
+ * another edge of r and enters the released column through an edge of
+ * another unfixed row or, on rectangular problems, of a dummy row, so the
+ * bound adds the minimal reduced costs of both to the cost of the node.
+ * Children without such edges are infeasible and not queued.
+ */
+template <typename MatrixT, typename T, typename I>
+void k_best_add_node(const MatrixT &csr,
+                     SparseAssignmentKBestWorkspace<T, I> &ws, T cost, I fixed,
+                     I parent) {
+  static constexpr auto INF = infinity<T>();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = static_cast<I>(csr.rows);
+  const auto nc = static_cast<I>(csr.cols);
+  const auto index = static_cast<I>(ws.nodes.size());
+  auto &u = ws.u;
+  auto &col_min = ws.col_min;
+
+  auto &node = ws.nodes.emplace_back();
+  node.cost = cost;
+  node.fixed = fixed;
+  node.x_edge.assign(ws.x_edge.begin(), ws.x_edge.begin() + nr);
+  node.v.assign(ws.v.begin(), ws.v.begin() + nc);
+  if (parent != -1) {
+    const auto &p = ws.nodes[parent];
+    node.excluded = p.excluded;
+    node.excluded.push_back(p.x_edge[fixed]);
+  }
+  const auto &v = node.v;
+
+  // Dual of the unassigned columns, which all share the maximal dual.
+  auto v_free = INF;
+  if (nr < nc) {
+    node.order.resize(nc);
+    std::iota(node.order.begin(), node.order.end(), I{0});
+    std::stable_sort(node.order.begin(), node.order.end(),
+                     [&v](I lhs, I rhs) { return v[lhs] > v[rhs]; });
+    for (I j = 0; j < nc; ++j) {
+      if (ws.y[j] == -1) {
+        v_free = v[j];
+        break;
+      }
+    }
+  }
+
+  for (I i = 0; i < nr; ++i) {
+    u[i] = cc[node.x_edge[i]] - v[kk[node.x_edge[i]]];
+  }
+  std::fill(col_min.begin(), col_min.end(), INF);
+  for (I i = fixed; i < nr; ++i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      if (t != node.x_edge[i]) {
+        const auto j = kk[t];
+        col_min[j] = std::min(col_min[j], cc[t] - u[i] - v[j]);
+      }
+    }
+  }
+
+  const auto later = [](const auto &lhs, const auto &rhs) {
+    return (lhs.cost > rhs.cost) ||
+           ((lhs.cost == rhs.cost) && !lhs.exact && rhs.exact);
+  };
+  for (I r = fixed; r < nr; ++r) {
+    const auto tr = node.x_edge[r];
+    const auto jr = static_cast<I>(kk[tr]);
+    auto leave = INF;
+    for (I t = first[r]; t < first[r + 1]; ++t) {
+      if (t != tr) {
+        leave = std::min(leave, cc[t] - u[r] - v[kk[t]]);
+      }
+    }
+    auto enter = col_min[jr];
+    if (v_free != INF) {
+      enter = std::min(enter, v_free - v[jr]);
+    }
+    if ((leave != INF) && (enter != INF)) {
+      const auto bound =
+          cost + std::max(leave, T{0}) + std::max(enter, T{0});
+      ws.queue.push_back({bound, index, r, false});
+      std::push_heap(ws.queue.begin(), ws.queue.end(), later);
+    }
+  }
+}
+
+/** @brief Enumerates the k best assignments of csr by Murty's partitioning.
+ *
+ * The optimum is found by LAPJVsp. Each solved subproblem is partitioned
+ * into one child per unfixed row, and children are only solved once their
+ * lower bound reaches the top of the queue. A child that is cheaper than
+ * all queued bounds is the next best assignment right away, otherwise it is
+ * queued again with its exact cost and solved a second time when it is
+ * popped. The nodes of the partition thus only store the solved
+ * subproblems, while the queue holds the children in O(1) each.
+ */
+template <typename MatrixT, typename T, typename I>
+void k_best(const MatrixT &csr, Eigen::Index k,
+            SparseAssignmentKBestWorkspace<T, I> &ws,
+            const SparseJonkerVolgenantOptions &options, bool transposed,
+            KBestResult<T, I> &res) {
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = static_cast<I>(csr.rows);
+  const auto nc = static_cast<I>(csr.cols);
+
+  ws.reset(nr, nc, static_cast<Eigen::Index>(first[nr]));
+  ws.nodes.clear();
+  res.costs.clear();
+  auto found = std::size_t{0};
+  const auto emit = [&](T cost) {
+    if (res.assignments.size() <= found) {
+      res.assignments.emplace_back();
+    }
+    assign_result(csr, ws.x, ws.v, transposed, true, ws.match,
+                  res.assignments[found]);
+    res.costs.push_back(cost);
+    ++found;
+  };
+
+  auto valid = false;
+  if (k > 0) {
+    lapjvsp(csr, ws.solver, options, valid);
+  }
+  if (valid) {
+    auto cost = T{0};
+    for (I i = 0; i < nr; ++i) {
+      const auto j = ws.solver.x[i];
+      auto t = static_cast<I>(first[i]);
+      while (kk[t] != j) {
+        ++t;
+      }
+      ws.x[i] = j;
+      ws.x_edge[i] = t;
+      ws.y[j] = i;
+      cost += cc[t];
+    }
+    std::copy(ws.solver.v.begin(), ws.solver.v.begin() + nc, ws.v.begin());
+    emit(cost);
+    k_best_add_node(csr, ws, cost, I{0}, I{-1});
+  }
+
+  const auto later = [](const auto &lhs, const auto &rhs) {
+    return (lhs.cost > rhs.cost) ||
+           ((lhs.cost == rhs.cost) && !lhs.exact && rhs.exact);
+  };
+  while ((static_cast<Eigen::Index>(found) < k) && !ws.queue.empty()) {
+    std::pop_heap(ws.queue.begin(), ws.queue.end(), later);
+    const auto candidate = ws.queue.back();
+    ws.queue.pop_back();
+
+    auto cost = T{0};
+    if (!k_best_solve_child(csr, ws, candidate.node, candidate.row, cost)) {
+      continue;
+    }
+    if (!candidate.exact && !ws.queue.empty() &&
+        (ws.queue.front().cost < cost)) {
+      ws.queue.push_back({cost, candidate.node, candidate.row, true});
+      std::push_heap(ws.queue.begin(), ws.queue.end(), later);
+      continue;
+    }
+    emit(cost);
+    k_best_add_node(csr, ws, cost, candidate.row, candidate.node);
+  }
+  res.assignments.resize(found);
+}
+
+} // namespace internal
+
+/** @brief Finds the k best assignments of a sparse assignment problem.
+ *
+ * Murty's algorithm partitions the remaining assignments after each solution
+ * by fixing a prefix of its rows and excluding the edge of the next row.
+ * Every child starts from the assignment and duals of its parent, so it is
+ * solved by a single shortest augmenting path instead of a full solve.
+ * options configure the LAPJVsp solve of the optimum; with a positive
+ * epsilon all costs are accurate up to rows * epsilon.
+ */
+template <typename SparseMatrixT, typename I>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+solve_k_best_sparse_assignment_problem(
+    const SparseMatrixT &sm, Eigen::Index k,
+    SparseAssignmentKBestWorkspace<typename SparseMatrixT::Scalar, I> &ws,
+    KBestResult<typename SparseMatrixT::Scalar, I> &res,
+    const SparseJonkerVolgenantOptions &options = {}) {
+  internal::visit_compressed_sparse_row_matrix(
+      sm, ws.csr, [&](const auto &csr, bool transposed) {
+        internal::k_best(csr, k, ws, options, transposed, res);
+      });
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<
+    is_sparse_assignment_problem_v<SparseMatrixT>,
+    KBestResult<typename std::decay_t<SparseMatrixT>::Scalar>>
+solve_k_best_sparse_assignment_problem(
+    SparseMatrixT &&sm, Eigen::Index k,
+    const SparseJonkerVolgenantOptions &options = {}) {
+  using ScalarT = typename std::decay_t<SparseMatrixT>::Scalar;
+
+  auto ws = SparseAssignmentKBestWorkspace<ScalarT>{};
+  auto res = KBestResult<ScalarT>{};
+  solve_k_best_sparse_assignment_problem(sm, k, ws, res, options);
+  return res;
+}
+
+} // namespace asap
+
+#endif
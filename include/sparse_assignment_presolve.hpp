@@ -0,0 +1,442 @@
+#ifndef ASAP_SPARSE_ASSIGNMENT_PRESOLVE_HPP
+#define ASAP_SPARSE_ASSIGNMENT_PRESOLVE_HPP
+
+#include "sparse_jonker_volgenant_solver.hpp"
+
+namespace asap {
+
+/** @brief Configures the presolve in front of LAPJVsp.
+ *
+ * Forced assignments are always fixed. prune_dominated additionally drops
+ * dominated edges of problems with more columns than rows. The reduced
+ * problem is solved by LAPJVsp with the solver options.
+ */
+struct SparseAssignmentPresolveOptions {
+  bool prune_dominated{true};
+  SparseJonkerVolgenantOptions solver{};
+};
+
+/** @brief Owns all buffers needed to presolve, solve and postsolve a problem.
+ *
+ * Edges are addressed by their position in the CSR form of the problem and
+ * listed by column in col_edge and col_row. removed holds the forced step
+ * that removed each edge, -1 for edges of the reduced problem and -2 for
+ * pruned edges. steps lists the (row, edge) of every forced assignment.
+ */
+template <typename T> struct SparseAssignmentPresolveWorkspace {
+  void reset(Eigen::Index nr, Eigen::Index nc, Eigen::Index nnz);
+
+  CompressedSparseRowMatrix<T> csr{};
+  std::vector<Eigen::Index> row_degree{};
+  std::vector<Eigen::Index> col_degree{};
+  std::vector<Eigen::Index> col_ptr{};
+  std::vector<Eigen::Index> col_edge{};
+  std::vector<Eigen::Index> col_row{};
+  std::vector<Eigen::Index> removed{};
+  std::vector<Eigen::Index> row_queue{};
+  std::vector<Eigen::Index> col_queue{};
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> steps{};
+  std::vector<Eigen::Index> x{};
+  std::vector<Eigen::Index> x_edge{};
+  std::vector<Eigen::Index> y{};
+  std::vector<T> u{};
+  std::vector<T> v{};
+  std::vector<Eigen::Index> rows{};
+  std::vector<Eigen::Index> cols{};
+  std::vector<Eigen::Index> local{};
+  std::vector<Eigen::Index> edges{};
+  CompressedSparseRowMatrix<T> reduced{};
+  SparseJonkerVolgenantWorkspace<T> solver{};
+  std::vector<Eigen::Index> match{};
+
+  // Number of assignments fixed by the presolve of the last solve.
+  Eigen::Index forced{};
+  // Number of dominated edges dropped by the presolve of the last solve.
+  Eigen::Index pruned{};
+  // Shape of the reduced problem passed on to LAPJVsp.
+  Eigen::Index reduced_rows{};
+  Eigen::Index reduced_cols{};
+  Eigen::Index reduced_non_zeros{};
+};
+
+template <typename T>
+void SparseAssignmentPresolveWorkspace<T>::reset(Eigen::Index nr,
+                                                 Eigen::Index nc,
+                                                 Eigen::Index nnz) {
+  row_degree.assign(nr, Eigen::Index{0});
+  col_degree.assign(nc, Eigen::Index{0});
+  col_ptr.assign(nc + 1, Eigen::Index{0});
+  col_edge.resize(nnz);
+  col_row.resize(nnz);
+  removed.assign(nnz, Eigen::Index{-1});
+  row_queue.clear();
+  col_queue.clear();
+  steps.clear();
+  x.assign(nr, Eigen::Index{-1});
+  x_edge.assign(nr, Eigen::Index{-1});
+  y.assign(nc, Eigen::Index{-1});
+  u.assign(nr, T{0});
+  v.assign(nc, T{0});
+  rows.clear();
+  cols.clear();
+  local.assign(nc, Eigen::Index{-1});
+  edges.clear();
+  forced = 0;
+  pruned = 0;
+  reduced_rows = 0;
+  reduced_cols = 0;
+  reduced_non_zeros = 0;
+}
+
+namespace internal {
+
+/** @brief Fixes forced assignments and drops dominated edges of csr.
+ *
+ * A row with a single edge has to take it, and so has the single row of a
+ * column of a square problem, where every column is assigned. Fixing an
+ * assignment removes its row and column with all their edges, which may
+ * force further rows and columns. On problems with more columns than rows a
+ * column reached by a single row is private to it: any other edge of the row
+ * that costs more can be exchanged for the private column without raising
+ * the cost, so it is dropped. Returns false as soon as a row or, on square
+ * problems, a column has no edge left, which makes the problem infeasible.
+ */
+template <typename MatrixT, typename T>
+[[nodiscard]] bool presolve(const MatrixT &csr,
+                            SparseAssignmentPresolveWorkspace<T> &ws,
+                            const SparseAssignmentPresolveOptions &options) {
+  using I = Eigen::Index;
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = I{csr.rows};
+  const auto nc = I{csr.cols};
+  const auto base = I{first[0]};
+  const auto square = (nr == nc);
+  const auto prune = options.prune_dominated && !square;
+  auto &row_degree = ws.row_degree;
+  auto &col_degree = ws.col_degree;
+  auto &col_ptr = ws.col_ptr;
+  auto &removed = ws.removed;
+  auto &row_queue = ws.row_queue;
+  auto &col_queue = ws.col_queue;
+
+  ws.reset(nr, nc, I{first[nr]} - base);
+
+  // Counting sort of the edges by column.
+  for (I i = 0; i < nr; ++i) {
+    row_degree[i] = first[i + 1] - first[i];
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      ++col_ptr[kk[t] + 1];
+    }
+  }
+  for (I j = 0; j < nc; ++j) {
+    col_degree[j] = col_ptr[j + 1];
+    col_ptr[j + 1] += col_ptr[j];
+  }
+  std::copy(col_ptr.begin(), col_ptr.end() - 1, ws.local.begin());
+  for (I i = 0; i < nr; ++i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      const auto k = ws.local[kk[t]]++;
+      ws.col_edge[k] = t;
+      ws.col_row[k] = i;
+    }
+  }
+
+  const auto drop = [&](I t, I step) {
+    removed[t - base] = step;
+    if (--col_degree[kk[t]] <= 1) {
+      col_queue.push_back(kk[t]);
+    }
+  };
+  const auto assign = [&](I i, I t) {
+    const auto j = static_cast<I>(kk[t]);
+    const auto step = static_cast<I>(ws.steps.size());
+    ws.steps.emplace_back(i, t);
+    ws.x[i] = j;
+    ws.x_edge[i] = t;
+    ws.y[j] = i;
+    for (I s = first[i]; s < first[i + 1]; ++s) {
+      if (removed[s - base] == -1) {
+        drop(s, step);
+      }
+    }
+    row_degree[i] = 0;
+    for (I k = col_ptr[j]; k < col_ptr[j + 1]; ++k) {
+      if (removed[ws.col_edge[k] - base] == -1) {
+        removed[ws.col_edge[k] - base] = step;
+        if (--row_degree[ws.col_row[k]] <= 1) {
+          row_queue.push_back(ws.col_row[k]);
+        }
+      }
+    }
+    col_degree[j] = 0;
+  };
+  // Returns the only edge of column j left, -1 if there is none.
+  const auto single_edge = [&](I j) {
+    for (I k = col_ptr[j]; k < col_ptr[j + 1]; ++k) {
+      if (removed[ws.col_edge[k] - base] == -1) {
+        return k;
+      }
+    }
+    return I{-1};
+  };
+
+  // Rows are revisited once they are down to a single edge or, through
+  // their column, once they gain a private column.
+  for (I i = nr; i > 0; --i) {
+    if (row_degree[i - 1] <= 1) {
+      row_queue.push_back(i - 1);
+    }
+  }
+  for (I j = 0; j < nc; ++j) {
+    if ((col_degree[j] == 1) || (square && (col_degree[j] == 0))) {
+      col_queue.push_back(j);
+    }
+  }
+
+  while (!row_queue.empty() || !col_queue.empty()) {
+    if (!col_queue.empty()) {
+      const auto j = col_queue.back();
+      col_queue.pop_back();
+      if ((ws.y[j] != -1) || (col_degree[j] > 1)) {
+        continue;
+      }
+      if (square && (col_degree[j] == 0)) {
+        return false;
+      }
+      const auto k = single_edge(j);
+      if (k == -1) {
+        continue;
+      }
+      if (square) {
+        assign(ws.col_row[k], ws.col_edge[k]);
+      } else if (prune) {
+        row_queue.push_back(ws.col_row[k]);
+      }
+      continue;
+    }
+
+    const auto i = row_queue.back();
+    row_queue.pop_back();
+    if (ws.x[i] != -1) {
+      continue;
+    }
+    if (prune && (row_degree[i] > 1)) {
+      auto tp = I{-1};
+      for (I t = first[i]; t < first[i + 1]; ++t) {
+        if ((removed[t - base] == -1) && (col_degree[kk[t]] == 1) &&
+            ((tp == -1) || (cc[t] < cc[tp]))) {
+          tp = t;
+        }
+      }
+      for (I t = first[i]; (tp != -1) && (t < first[i + 1]); ++t) {
+        if ((removed[t - base] == -1) && (t != tp) &&
+            ((cc[t] > cc[tp]) || (col_degree[kk[t]] == 1))) {
+          drop(t, I{-2});
+          --row_degree[i];
+          ++ws.pruned;
+        }
+      }
+    }
+    if (row_degree[i] == 0) {
+      return false;
+    }
+    if (row_degree[i] == 1) {
+      for (I t = first[i]; t < first[i + 1]; ++t) {
+        if (removed[t - base] == -1) {
+          assign(i, t);
+          break;
+        }
+      }
+    }
+  }
+  ws.forced = static_cast<I>(ws.steps.size());
+  return true;
+}
+
+/** @brief Copies the rows, columns and edges left by the presolve.
+ *
+ * Columns without edges are left out, they stay unassigned. ws.rows and
+ * ws.cols map the rows and columns of ws.reduced back to csr and ws.edges
+ * its entries. Returns false if fewer columns than rows are left.
+ */
+template <typename MatrixT, typename T>
+[[nodiscard]] bool compact(const MatrixT &csr,
+                           SparseAssignmentPresolveWorkspace<T> &ws) {
+  using I = Eigen::Index;
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = I{csr.rows};
+  const auto nc = I{csr.cols};
+  const auto base = I{first[0]};
+
+  for (I i = 0; i < nr; ++i) {
+    if (ws.x[i] == -1) {
+      ws.rows.push_back(i);
+    }
+  }
+  for (I j = 0; j < nc; ++j) {
+    ws.local[j] = -1;
+    if ((ws.y[j] == -1) && (ws.col_degree[j] > 0)) {
+      ws.local[j] = static_cast<I>(ws.cols.size());
+      ws.cols.push_back(j);
+    }
+  }
+  ws.reduced_rows = static_cast<I>(ws.rows.size());
+  ws.reduced_cols = static_cast<I>(ws.cols.size());
+  if (ws.reduced_rows > ws.reduced_cols) {
+    return false;
+  }
+
+  auto &reduced = ws.reduced;
+  reduced.rows = ws.reduced_rows;
+  reduced.cols = ws.reduced_cols;
+  reduced.val.clear();
+  reduced.col_ind.clear();
+  reduced.row_ptr.assign(1, I{0});
+  for (const auto i : ws.rows) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      if (ws.removed[t - base] == -1) {
+        reduced.val.push_back(cc[t]);
+        reduced.col_ind.push_back(ws.local[kk[t]]);
+        ws.edges.push_back(t);
+      }
+    }
+    reduced.row_ptr.push_back(static_cast<I>(reduced.val.size()));
+  }
+  ws.reduced_non_zeros = static_cast<I>(reduced.val.size());
+  return true;
+}
+
+/** @brief Maps the solution of the reduced problem back to csr.
+ *
+ * Fills the row assignment ws.x and column duals ws.v of csr. The reduced
+ * duals are kept, shifted to at most zero on problems with more columns than
+ * rows, where the columns left unassigned keep a zero dual. The private
+ * column of a row is raised to zero if the row takes it, which keeps the
+ * dropped edges of the row feasible. The forced steps are then undone in
+ * reverse: the column of a forced row takes the largest dual, at most zero,
+ * that keeps its other edges feasible, and the row of a forced column the
+ * largest one.
+ */
+template <typename MatrixT, typename T>
+void postsolve(const MatrixT &csr, SparseAssignmentPresolveWorkspace<T> &ws) {
+  using I = Eigen::Index;
+
+  static constexpr auto INF = infinity<T>();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto base = I{first[0]};
+  const auto square = (csr.rows == csr.cols);
+  const auto &reduced = ws.reduced;
+  auto &u = ws.u;
+  auto &v = ws.v;
+
+  auto shift = T{0};
+  if (!square && (ws.reduced_cols > 0)) {
+    shift = *std::max_element(ws.solver.v.begin(),
+                              ws.solver.v.begin() + ws.reduced_cols);
+  }
+  for (I l = 0; l < ws.reduced_cols; ++l) {
+    v[ws.cols[l]] = ws.solver.v[l] - shift;
+  }
+  for (I k = 0; k < ws.reduced_rows; ++k) {
+    const auto i = ws.rows[k];
+    const auto l = ws.solver.x[k];
+    for (I t = reduced.row_ptr[k]; t < reduced.row_ptr[k + 1]; ++t) {
+      if (reduced.col_ind[t] == l) {
+        ws.x_edge[i] = ws.edges[t];
+        break;
+      }
+    }
+    const auto j = ws.cols[l];
+    ws.x[i] = j;
+    ws.y[j] = i;
+    if (!square && (ws.col_degree[j] == 1)) {
+      v[j] = T{0};
+    }
+    u[i] = cc[ws.x_edge[i]] - v[j];
+  }
+
+  for (auto s = static_cast<I>(ws.steps.size()); s > 0; --s) {
+    const auto [i, t0] = ws.steps[s - 1];
+    const auto j = static_cast<I>(kk[t0]);
+    auto row_bound = INF;
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      if ((t != t0) && (ws.removed[t - base] == s - 1)) {
+        row_bound = std::min(row_bound, cc[t] - v[kk[t]]);
+      }
+    }
+    if (row_bound != INF) {
+      u[i] = row_bound;
+      v[j] = cc[t0] - u[i];
+      continue;
+    }
+    auto col_bound = T{0};
+    for (I k = ws.col_ptr[j]; k < ws.col_ptr[j + 1]; ++k) {
+      const auto t = ws.col_edge[k];
+      if ((t != t0) && (ws.removed[t - base] == s - 1)) {
+        col_bound = std::min(col_bound, cc[t] - u[ws.col_row[k]]);
+      }
+    }
+    v[j] = col_bound;
+    u[i] = cc[t0] - v[j];
+  }
+}
+
+} // namespace internal
+
+/** @brief Solves the sparse assignment problem after a presolve.
+ *
+ * Gated problems often have rows or columns with a single edge and edges
+ * that cannot be part of any optimal assignment. The presolve fixes the
+ * former and drops the latter until no more apply, and LAPJVsp only solves
+ * the compacted remainder. The result refers to the rows and columns of sm
+ * and its duals certify optimality of the whole problem. ws reports the
+ * number of forced assignments, pruned edges and the reduced shape.
+ */
+template <typename SparseMatrixT>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseAssignmentPresolveWorkspace<typename SparseMatrixT::Scalar> &ws,
+    Result<typename SparseMatrixT::Scalar> &res,
+    const SparseAssignmentPresolveOptions &options = {}) {
+  internal::visit_compressed_sparse_row_matrix(
+      sm, ws.csr, [&](const auto &csr, bool transposed) {
+        auto valid =
+            internal::presolve(csr, ws, options) && internal::compact(csr, ws);
+        if (valid && (ws.reduced_rows > 0)) {
+          internal::lapjvsp(ws.reduced, ws.solver, options.solver, valid);
+        }
+        if (valid) {
+          internal::postsolve(csr, ws);
+        }
+        internal::assign_result(csr, ws.x, ws.v, transposed, valid, ws.match,
+                                res);
+      });
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<
+    is_sparse_assignment_problem_v<SparseMatrixT>,
+    Result<typename std::decay_t<SparseMatrixT>::Scalar>>
+solve_sparse_assignment_problem(
+    SparseMatrixT &&sm, const SparseAssignmentPresolveOptions &options) {
+  using ScalarT = typename std::decay_t<SparseMatrixT>::Scalar;
+
+  auto ws = SparseAssignmentPresolveWorkspace<ScalarT>{};
+  auto res = Result<ScalarT>{};
+  solve_sparse_assignment_problem(sm, ws, res, options);
+  return res;
+}
+
+} // namespace asap
+
+#endif
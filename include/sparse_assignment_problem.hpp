@@ -0,0 +1,331 @@
+#ifndef ASAP_SPARSE_ASSIGNMENT_PROBLEM_HPP
+#define ASAP_SPARSE_ASSIGNMENT_PROBLEM_HPP
+
+#include "compressed_sparse_row_matrix.hpp"
+#include "cost_traits.hpp"
+
+namespace asap {
+
+/** @brief Assignment and duals of a solved sparse assignment problem.
+ *
+ * Row r is assigned to column col_idx[k] for r = row_idx[k], sorted by row.
+ * u and v are finite row and column duals with c(r, c) - u[r] - v[c] >= 0 for
+ * all entries and equality on the assignment, so u and v certify optimality.
+ * A result can be passed back as warm start for a slightly changed problem.
+ * Indices have the index type I of the workspace that produced the result.
+ * All arrays are allocated by A, rebound to their element type.
+ */
+template <typename T = double, typename I = Eigen::Index,
+          typename A = std::allocator<T>>
+struct Result {
+  Result() = default;
+
+  explicit Result(const A &alloc) noexcept
+      : row_idx{alloc}, col_idx{alloc}, u{alloc}, v{alloc} {}
+
+  using allocator_type = A;
+
+  internal::rebind_vector_t<I, A> row_idx{};
+  internal::rebind_vector_t<I, A> col_idx{};
+  internal::rebind_vector_t<T, A> u{};
+  internal::rebind_vector_t<T, A> v{};
+  bool valid{};
+};
+
+template <typename T>
+static constexpr auto is_sparse_assignment_problem_v =
+    is_sparse_matrix_v<T> || is_compressed_sparse_row_matrix_view_v<T> ||
+    is_interleaved_compressed_sparse_row_matrix_view_v<T>;
+
+namespace internal {
+
+/** @brief Invokes f(csr, transposed) with a CSR form of sm with rows <= cols.
+ *
+ * Compressed matrices whose storage already is such a CSR form are passed as
+ * views without copying their entries. All other matrices are copied or
+ * transposed into buffer. If transposed is set, csr is the transpose of sm.
+ */
+template <typename SparseMatrixT, typename T, typename I, typename A,
+          typename F>
+std::enable_if_t<is_row_major_v<SparseMatrixT>>
+visit_compressed_sparse_row_matrix(const SparseMatrixT &sm,
+                                   CompressedSparseRowMatrix<T, I, A> &buffer,
+                                   F &&f) {
+  if (sm.rows() > sm.cols()) {
+    buffer.assign_transpose(sm);
+    f(buffer, true);
+  } else if (sm.isCompressed()) {
+    f(CompressedSparseRowMatrixView{sm}, false);
+  } else {
+    buffer.assign(sm);
+    f(buffer, false);
+  }
+}
+
+/** @brief Invokes f(csr, transposed) with a CSR form of sm with rows <= cols.
+ *
+ * The compressed column storage of sm is the CSR representation of its
+ * transpose. Matrices with rows >= cols are therefore passed as a view of
+ * their transpose, wide matrices are transposed into buffer by a single
+ * counting sort.
+ */
+template <typename SparseMatrixT, typename T, typename I, typename A,
+          typename F>
+std::enable_if_t<is_col_major_v<SparseMatrixT>>
+visit_compressed_sparse_row_matrix(const SparseMatrixT &sm,
+                                   CompressedSparseRowMatrix<T, I, A> &buffer,
+                                   F &&f) {
+  if (sm.rows() < sm.cols()) {
+    buffer.assign(sm);
+    f(buffer, false);
+  } else if (sm.isCompressed()) {
+    f(CompressedSparseRowMatrixView{sm.valuePtr(), sm.innerIndexPtr(),
+                                    sm.outerIndexPtr(), sm.cols(), sm.rows()},
+      true);
+  } else {
+    buffer.assign_transpose(sm);
+    f(buffer, true);
+  }
+}
+
+/** @brief Invokes f(csr, transposed) with a CSR form of sm with rows <= cols.
+ *
+ * Views with rows <= cols are passed on directly, taller views are
+ * transposed into buffer first.
+ */
+template <typename T, typename I, typename A, typename J, typename F>
+void visit_compressed_sparse_row_matrix(
+    const CompressedSparseRowMatrixView<T, J> &csr,
+    CompressedSparseRowMatrix<T, I, A> &buffer, F &&f) {
+  if (csr.rows > csr.cols) {
+    buffer.assign_transpose(csr);
+    f(buffer, true);
+  } else {
+    f(csr, false);
+  }
+}
+
+/** @brief Invokes f(csr, transposed) with a CSR form of sm with rows <= cols.
+ *
+ * Interleaved views with rows <= cols are passed on directly, taller views
+ * are transposed into the separate arrays of buffer first.
+ */
+template <typename T, typename I, typename A, typename J, typename F>
+void visit_compressed_sparse_row_matrix(
+    const InterleavedCompressedSparseRowMatrixView<T, J> &csr,
+    CompressedSparseRowMatrix<T, I, A> &buffer, F &&f) {
+  if (csr.rows > csr.cols) {
+    buffer.assign_transpose(csr);
+    f(buffer, true);
+  } else {
+    f(csr, false);
+  }
+}
+
+/** @brief Replaces unbounded duals by finite ones.
+ *
+ * Row reduction lowers the dual of a column by the gap between the two
+ * smallest reduced costs of a row, which is unbounded if no other entry of
+ * the row is reachable. Such a row only has entries in columns with an
+ * unbounded dual, so these columns are constrained by the entries of all
+ * other rows from above, c(i, j) - u[i], and among each other by
+ * v[j] - v[x[i]] <= c(i, j) - c(i, x[i]) for the entries of their assigned
+ * rows. The largest solution of these difference constraints is found by
+ * label correcting, which terminates since an optimal assignment has no
+ * negative alternating cycle. Every column is also capped at the dual of
+ * the unassigned columns and at the cost of its assigned entry, so columns
+ * without any bound get a finite dual. Uses match as scratch buffer.
+ */
+template <typename MatrixT, typename T, typename I, typename XA,
+          typename MA, typename RA, typename CA>
+void bound_duals(const MatrixT &csr, const std::vector<I, XA> &x,
+                 std::vector<I, MA> &match, std::vector<T, RA> &row_dual,
+                 std::vector<T, CA> &col_dual) {
+  static constexpr auto INF = infinity<T>();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto rows = static_cast<I>(csr.rows);
+  const auto cols = static_cast<I>(csr.cols);
+
+  // match holds the assigned row of every unbounded column, -1 for bounded
+  // assigned columns and -2 for unassigned columns.
+  match.assign(cols, I{-2});
+  auto unbounded = I{0};
+  for (I i = 0; i < rows; ++i) {
+    const auto j = x[i];
+    match[j] = (col_dual[j] <= -INF / 2) ? i : I{-1};
+    unbounded += (match[j] == i) ? 1 : 0;
+  }
+  if (unbounded == 0) {
+    return;
+  }
+
+  const auto assigned_cost = [&](I i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      if (kk[t] == x[i]) {
+        return cc[t];
+      }
+    }
+    return T{0};
+  };
+
+  auto level = INF;
+  for (I j = 0; j < cols; ++j) {
+    if (match[j] == -2) {
+      level = std::min(level, col_dual[j]);
+    }
+  }
+  for (I j = 0; j < cols; ++j) {
+    if (match[j] >= 0) {
+      col_dual[j] = std::min(level, assigned_cost(match[j]));
+    }
+  }
+  for (I i = 0; i < rows; ++i) {
+    if (match[x[i]] >= 0) {
+      continue;
+    }
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      const auto j = static_cast<I>(kk[t]);
+      if (match[j] >= 0) {
+        col_dual[j] = std::min(col_dual[j], cc[t] - row_dual[i]);
+      }
+    }
+  }
+
+  auto changed = true;
+  for (I pass = 0; changed && (pass < unbounded); ++pass) {
+    changed = false;
+    for (I a = 0; a < cols; ++a) {
+      const auto i = match[a];
+      if (i < 0) {
+        continue;
+      }
+      const auto u = assigned_cost(i) - col_dual[a];
+      for (I t = first[i]; t < first[i + 1]; ++t) {
+        const auto j = static_cast<I>(kk[t]);
+        if ((j != a) && (match[j] >= 0) && (cc[t] - u < col_dual[j])) {
+          col_dual[j] = cc[t] - u;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  for (I j = 0; j < cols; ++j) {
+    if (match[j] >= 0) {
+      row_dual[match[j]] = assigned_cost(match[j]) - col_dual[j];
+    }
+  }
+}
+
+/** @brief Writes the solution of a CSR problem to res.
+ *
+ * x assigns the rows of csr and v holds its column duals, the row duals are
+ * recovered from the assigned edges and bounded to finite values. If
+ * transposed is set, csr is the transpose of the original problem, so rows
+ * and columns as well as row and column duals swap roles. The assignment is
+ * mapped back to the original row-sorted order in O(rows + cols) using match
+ * as scratch buffer.
+ */
+template <typename MatrixT, typename T, typename I, typename XA,
+          typename VA, typename MA, typename A>
+void assign_result(const MatrixT &csr, const std::vector<I, XA> &x,
+                   const std::vector<T, VA> &v, bool transposed, bool valid,
+                   std::vector<I, MA> &match, Result<T, I, A> &res) {
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto rows = static_cast<I>(csr.rows);
+  const auto cols = static_cast<I>(csr.cols);
+
+  res.valid = valid;
+  if (!valid) {
+    res.row_idx.clear();
+    res.col_idx.clear();
+    res.u.clear();
+    res.v.clear();
+    return;
+  }
+
+  auto &row_dual = transposed ? res.v : res.u;
+  auto &col_dual = transposed ? res.u : res.v;
+  row_dual.resize(rows);
+  col_dual.assign(v.begin(), v.begin() + cols);
+  for (I i = 0; i < rows; ++i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      if (kk[t] == x[i]) {
+        row_dual[i] = cc[t] - v[x[i]];
+        break;
+      }
+    }
+  }
+  bound_duals(csr, x, match, row_dual, col_dual);
+
+  res.row_idx.resize(rows);
+  res.col_idx.resize(rows);
+  if (transposed) {
+    // Scatter the matched columns by row to obtain the row-sorted assignment.
+    match.assign(cols, I{-1});
+    for (I c = 0; c < rows; ++c) {
+      match[x[c]] = c;
+    }
+    auto k = I{0};
+    for (I r = 0; r < cols; ++r) {
+      if (match[r] != -1) {
+        res.row_idx[k] = r;
+        res.col_idx[k] = match[r];
+        ++k;
+      }
+    }
+  } else {
+    std::iota(res.row_idx.begin(), res.row_idx.end(), 0);
+    std::copy(x.begin(), x.begin() + rows, res.col_idx.begin());
+  }
+}
+
+/** @brief Reads a warm start for a CSR problem from res.
+ *
+ * The inverse of assign_result: fills the row assignment x and the column
+ * duals v of csr. Returns false and leaves x and v untouched if res is not a
+ * valid result of a problem of the same shape or if any of its duals is
+ * unbounded, since an unbounded column dual would make every entry added to
+ * that column unreachable. The caller then falls back to a cold start.
+ */
+template <typename T, typename I, typename A, typename XA, typename VA>
+[[nodiscard]] bool assign_start(const Result<T, I, A> &res, Eigen::Index rows,
+                                Eigen::Index cols, bool transposed,
+                                std::vector<I, XA> &x, std::vector<T, VA> &v) {
+  static constexpr auto INF = infinity<T>();
+
+  const auto &row_dual = transposed ? res.v : res.u;
+  const auto &col_dual = transposed ? res.u : res.v;
+  if (!res.valid || (static_cast<I>(row_dual.size()) != rows) ||
+      (static_cast<I>(col_dual.size()) != cols) ||
+      (res.row_idx.size() != res.col_idx.size())) {
+    return false;
+  }
+  const auto unbounded = [](T d) { return (d >= INF / 2) || (d <= -INF / 2); };
+  if (std::any_of(res.u.begin(), res.u.end(), unbounded) ||
+      std::any_of(res.v.begin(), res.v.end(), unbounded)) {
+    return false;
+  }
+
+  std::fill(x.begin(), x.begin() + rows, I{-1});
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    const auto i = transposed ? res.col_idx[k] : res.row_idx[k];
+    const auto j = transposed ? res.row_idx[k] : res.col_idx[k];
+    if ((i >= 0) && (i < rows)) {
+      x[i] = j;
+    }
+  }
+  std::copy(col_dual.begin(), col_dual.end(), v.begin());
+  return true;
+}
+
+} // namespace internal
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef ASAP_SPARSE_AUCTION_OPTIONS_HPP
+#define ASAP_SPARSE_AUCTION_OPTIONS_HPP
+
+#include "sparse_jonker_volgenant_options.hpp"
+
+#include <cstddef>
+
+namespace asap {
+
+/** @brief Configures the epsilon-scaling auction.
+ *
+ * Unassigned rows bid in parallel on num_threads threads, where 0 selects
+ * the number of hardware threads. Each scaling phase divides epsilon by
+ * scaling_factor until epsilon_final is reached.
+ *
+ * If exact is set, the auction result is completed to an optimal assignment
+ * by shortest augmenting paths using the given augmentation engine.
+ * Otherwise the auction result is returned as is and its cost exceeds the
+ * optimum by at most rows * epsilon_final.
+ *
+ * A non-positive epsilon_final is chosen from the range C of the costs. With
+ * the exact finish it is C / (rows + 1), which already leaves few rows to
+ * augment. Without it is C / (100 * rows), so the cost exceeds the optimum by
+ * at most 1% of C. Integer costs never go below an epsilon_final of 1.
+ *
+ * Auctions on infeasible problems only stop once a dual falls below a limit,
+ * which may take many rounds. If check_feasibility is set, such problems are
+ * rejected up front by a maximum cardinality matching.
+ */
+struct SparseAuctionOptions {
+  std::size_t num_threads{0};
+  double scaling_factor{4.0};
+  double epsilon_final{0.0};
+  bool exact{true};
+  bool check_feasibility{false};
+  AugmentationStrategy augmentation{AugmentationStrategy::Heap};
+};
+
+} // namespace asap
+
+#endif
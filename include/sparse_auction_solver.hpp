@@ -0,0 +1,58 @@
+#ifndef ASAP_SPARSE_AUCTION_SOLVER_HPP
+#define ASAP_SPARSE_AUCTION_SOLVER_HPP
+
+#include "common.hpp"
+#include "sparse_assignment_problem.hpp"
+#include "sparse_auction_solver_impl.hpp"
+
+namespace asap {
+
+/** @brief Solves the sparse assignment problem by a parallel auction.
+ *
+ * Accepts the same inputs as the LAPJVsp solver. The thread pool and all
+ * buffers of ws, as well as the buffers of res, are reused across solves.
+ * Without the exact finish the duals in res are only epsilon-feasible.
+ */
+template <typename SparseMatrixT>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseAuctionWorkspace<typename SparseMatrixT::Scalar> &ws,
+    Result<typename SparseMatrixT::Scalar> &res,
+    const SparseAuctionOptions &options = {}) {
+  internal::visit_compressed_sparse_row_matrix(
+      sm, ws.jv.csr, [&](const auto &csr, bool transposed) {
+        auto valid = false;
+        internal::auction(csr, ws, options, valid);
+        internal::assign_result(csr, ws.jv.x, ws.jv.v, transposed, valid,
+                                ws.jv.match, res);
+      });
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>,
+                               Result<typename SparseMatrixT::Scalar>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseAuctionWorkspace<typename SparseMatrixT::Scalar> &ws,
+    const SparseAuctionOptions &options = {}) {
+  auto res = Result<typename SparseMatrixT::Scalar>{};
+  solve_sparse_assignment_problem(sm, ws, res, options);
+  return res;
+}
+
+template <typename SparseMatrixT>
+[[nodiscard]] std::enable_if_t<
+    is_sparse_assignment_problem_v<SparseMatrixT>,
+    Result<typename std::decay_t<SparseMatrixT>::Scalar>>
+solve_sparse_assignment_problem(SparseMatrixT &&sm,
+                                const SparseAuctionOptions &options) {
+  using ScalarT = typename std::decay_t<SparseMatrixT>::Scalar;
+
+  auto ws = SparseAuctionWorkspace<ScalarT>{};
+  return solve_sparse_assignment_problem(sm, ws, options);
+}
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,242 @@
+#ifndef ASAP_SPARSE_AUCTION_SOLVER_IMPL_HPP
+#define ASAP_SPARSE_AUCTION_SOLVER_IMPL_HPP
+
+#include "sparse_auction_options.hpp"
+#include "sparse_auction_workspace.hpp"
+#include "sparse_jonker_volgenant_solver_impl.hpp"
+
+namespace asap {
+
+namespace internal {
+
+/** @brief Solves the sparse assignment problem using an auction.
+ *
+ * Rows are bidders and columns are objects. Every round all unassigned rows
+ * bid in parallel (Jacobi bidding) for the column of minimal reduced cost
+ * c - v and lower its dual v by the difference to the second best column
+ * plus epsilon. Conflicting bids are resolved sequentially in favour of the
+ * lowest resulting dual. Square problems run epsilon-scaling phases [1] that
+ * keep the duals of the previous phase, rectangular problems run a single
+ * phase from zero duals so that unassigned columns keep the maximal dual and
+ * the result stays epsilon-optimal [2].
+ *
+ * The duals are stored with the sign convention of LAPJVsp in ws.jv, so the
+ * exact finish hands the result to lapjvsp_warm_start without conversion.
+ * The same happens if a dual falls below a limit that feasible problems never
+ * reach, in which case the shortest augmenting path phase decides
+ * feasibility.
+ *
+ * Source index:
+ * [1] Dimitri P. Bertsekas and David A. Castanon:
+ *     Parallel synchronous and asynchronous implementations of the auction
+ *     algorithm.
+ *     Parallel Computing 17:707-732, 1991.
+ * [2] Dimitri P. Bertsekas and David A. Castanon:
+ *     A forward/reverse auction algorithm for asymmetric assignment problems.
+ *     Computational Optimization and Applications 1:277-297, 1992.
+ */
+template <typename MatrixT, typename T>
+void auction(const MatrixT &csr, SparseAuctionWorkspace<T> &ws,
+             const SparseAuctionOptions &options, bool &valid);
+
+/** @brief Runs one auction phase from an empty assignment.
+ *
+ * Returns false if the phase was aborted because a dual fell below the
+ * feasibility limit or bids stopped making progress in floating point.
+ */
+template <typename MatrixT, typename T>
+[[nodiscard]] bool auction_phase(const MatrixT &csr,
+                                 SparseAuctionWorkspace<T> &ws, T eps,
+                                 T c_range);
+
+template <typename MatrixT, typename T>
+void auction(const MatrixT &csr, SparseAuctionWorkspace<T> &ws,
+             const SparseAuctionOptions &options, bool &valid) {
+  using I = Eigen::Index;
+
+  const auto &first = csr.row_ptr;
+  const auto &cc = csr.val;
+  const auto nr = I{csr.rows};
+  const auto nc = I{csr.cols};
+
+  ws.reset(nr, nc, options.num_threads);
+  valid = true;
+  if (nr == 0) {
+    return;
+  }
+
+  for (I i = 0; i < nr; ++i) {
+    if (first[i] == first[i + 1]) {
+      valid = false;
+      return;
+    }
+  }
+  if (options.check_feasibility) {
+    hopcroft_karp(csr, ws.jv.matching);
+    if (ws.jv.matching.matched < nr) {
+      valid = false;
+      return;
+    }
+  }
+
+  auto c_min = cc[first[0]];
+  auto c_max = cc[first[0]];
+  for (I t = first[0] + 1; t < first[nr]; ++t) {
+    c_min = std::min(c_min, cc[t]);
+    c_max = std::max(c_max, cc[t]);
+  }
+  const auto c_range = (c_max > c_min) ? T(c_max - c_min) : T{1};
+
+  auto eps_final = T(options.epsilon_final);
+  if (!(eps_final > T{0})) {
+    eps_final = options.exact ? T(c_range / T(nr + 1))
+                              : T(c_range / T(100 * nr));
+  }
+  if constexpr (std::numeric_limits<T>::is_integer) {
+    eps_final = std::max(eps_final, T{1});
+  }
+
+  auto eps = eps_final;
+  if ((nr == nc) && (options.scaling_factor > 1.0)) {
+    eps = std::max(T(c_range / options.scaling_factor), eps_final);
+  }
+
+  auto jv_options = SparseJonkerVolgenantOptions{options.augmentation};
+  jv_options.num_threads = options.num_threads;
+  while (true) {
+    if (!auction_phase(csr, ws, eps, c_range)) {
+      lapjvsp_warm_start(csr, ws.jv, jv_options, valid);
+      return;
+    }
+    if (eps <= eps_final) {
+      break;
+    }
+    eps = std::max(T(eps / options.scaling_factor), eps_final);
+  }
+
+  if (options.exact) {
+    lapjvsp_warm_start(csr, ws.jv, jv_options, valid);
+  }
+}
+
+template <typename MatrixT, typename T>
+bool auction_phase(const MatrixT &csr, SparseAuctionWorkspace<T> &ws, T eps,
+                   T c_range) {
+  using I = Eigen::Index;
+
+  static constexpr auto INF = infinity<T>();
+  static constexpr auto grain = std::size_t{128};
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = I{csr.rows};
+  auto &x = ws.jv.x;
+  auto &y = ws.jv.y;
+  auto &v = ws.jv.v;
+  auto &unassigned = ws.unassigned;
+  auto &next_unassigned = ws.next_unassigned;
+  auto &bid_col = ws.bid_col;
+  auto &bid_val = ws.bid_val;
+  auto &best_val = ws.best_val;
+  auto &best_row = ws.best_row;
+  auto &touched = ws.touched;
+
+  std::fill(x.begin(), x.end(), I{-1});
+  std::fill(y.begin(), y.end(), I{-1});
+  std::iota(unassigned.begin(), unassigned.begin() + nr, 0);
+
+  // Evaluated in double and clamped to -INF, so the limit cannot overflow
+  // integer costs on large problems.
+  const auto v_min = static_cast<double>(*std::min_element(v.begin(), v.end()));
+  const auto v_limit = static_cast<T>(
+      std::max(v_min - 2.0 * static_cast<double>(nr + 1) *
+                           static_cast<double>(c_range + eps),
+               -static_cast<double>(INF)));
+
+  const auto bid = [&](std::size_t begin, std::size_t end, std::size_t) {
+    for (auto k = begin; k < end; ++k) {
+      const auto i = unassigned[k];
+      auto j1 = I{-1};
+      auto c1 = T{0};
+      auto w1 = INF;
+      auto w2 = INF;
+      for (I t = first[i]; t < first[i + 1]; ++t) {
+        const auto j = I{kk[t]};
+        const auto w = cc[t] - v[j];
+        if (w < w1) {
+          w2 = w1;
+          w1 = w;
+          j1 = j;
+          c1 = cc[t];
+        } else if (w < w2) {
+          w2 = w;
+        }
+      }
+      // A single edge is bid on as if the second best column cost c_range
+      // more, which bounds the dual decrease for the feasibility limit.
+      if (w2 == INF) {
+        w2 = w1 + c_range;
+      }
+      bid_col[k] = j1;
+      bid_val[k] = c1 - w2 - eps;
+    }
+  };
+
+  auto n_unassigned = nr;
+  auto in_progress = true;
+  while ((n_unassigned > 0) && in_progress) {
+    ++ws.rounds;
+    ws.bids += n_unassigned;
+
+    ws.pool->parallel_for(static_cast<std::size_t>(n_unassigned), grain, bid);
+
+    // Keep the lowest dual bid per column, ties go to the earlier bid.
+    auto n_touched = I{0};
+    for (I k = 0; k < n_unassigned; ++k) {
+      const auto j = bid_col[k];
+      if (best_row[j] == -1) {
+        touched[n_touched] = j;
+        ++n_touched;
+      } else if (!(bid_val[k] < best_val[j])) {
+        continue;
+      }
+      best_row[j] = unassigned[k];
+      best_val[j] = bid_val[k];
+    }
+
+    auto n_next = I{0};
+    for (I k = 0; k < n_touched; ++k) {
+      const auto j = touched[k];
+      const auto i = best_row[j];
+      best_row[j] = -1;
+      if (y[j] != -1) {
+        in_progress = in_progress && (best_val[j] < v[j]);
+        x[y[j]] = -1;
+        next_unassigned[n_next] = y[j];
+        ++n_next;
+      }
+      y[j] = i;
+      x[i] = j;
+      v[j] = best_val[j];
+      in_progress = in_progress && !(v[j] < v_limit);
+    }
+    for (I k = 0; k < n_unassigned; ++k) {
+      if (x[unassigned[k]] == -1) {
+        next_unassigned[n_next] = unassigned[k];
+        ++n_next;
+      }
+    }
+
+    std::swap(unassigned, next_unassigned);
+    n_unassigned = n_next;
+  }
+
+  return in_progress;
+}
+
+} // namespace internal
+
+} // namespace asap
+
+#endif
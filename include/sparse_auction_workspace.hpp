@@ -0,0 +1,52 @@
+#ifndef ASAP_SPARSE_AUCTION_WORKSPACE_HPP
+#define ASAP_SPARSE_AUCTION_WORKSPACE_HPP
+
+#include "sparse_jonker_volgenant_workspace.hpp"
+#include "thread_pool.hpp"
+
+namespace asap {
+
+/** @brief Owns the thread pool and all buffers needed by the auction.
+ *
+ * The assignment and the column duals live in the embedded LAPJVsp
+ * workspace, so the exact finish continues from the auction result in place.
+ * The thread pool is kept across solves and only recreated if the requested
+ * number of threads changes.
+ */
+template <typename T> struct SparseAuctionWorkspace {
+  void reset(Eigen::Index nr, Eigen::Index nc, std::size_t num_threads);
+
+  SparseJonkerVolgenantWorkspace<T> jv{};
+  std::unique_ptr<ThreadPool> pool{};
+  std::vector<Eigen::Index> unassigned{};
+  std::vector<Eigen::Index> next_unassigned{};
+  std::vector<Eigen::Index> bid_col{};
+  std::vector<T> bid_val{};
+  std::vector<T> best_val{};
+  std::vector<Eigen::Index> best_row{};
+  std::vector<Eigen::Index> touched{};
+
+  // Number of bidding rounds and bids of the last solve.
+  Eigen::Index rounds{};
+  Eigen::Index bids{};
+};
+
+template <typename T>
+void SparseAuctionWorkspace<T>::reset(Eigen::Index nr, Eigen::Index nc,
+                                      std::size_t num_threads) {
+  internal::reset_thread_pool(pool, num_threads);
+  jv.reset(nr, nc);
+  unassigned.resize(nr);
+  next_unassigned.resize(nr);
+  bid_col.resize(nr);
+  bid_val.resize(nr);
+  best_val.resize(nc);
+  best_row.assign(nc, Eigen::Index{-1});
+  touched.resize(nr);
+  rounds = 0;
+  bids = 0;
+}
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef ASAP_SPARSE_JONKER_VOLGENANT_OPTIONS_HPP
+#define ASAP_SPARSE_JONKER_VOLGENANT_OPTIONS_HPP
+
+#include <cstddef>
+
+namespace asap {
+
+/** @brief Selects the shortest augmenting path engine of LAPJVsp.
+ *
+ * LinearScan is the original LAPJVsp search. Each augmentation resets and
+ * scans all columns, which is fast for small or dense problems.
+ *
+ * Heap only resets the columns touched by the previous search and selects the
+ * next column from a binary heap over reached columns. Each augmentation is
+ * proportional to the explored part of the graph, which pays off for large
+ * and very sparse problems.
+ *
+ * Parallel runs the heap searches of a batch of free rows on num_threads
+ * threads against the same duals and commits their augmentations in order. A
+ * search whose tree reached a column changed by an earlier commit of its
+ * batch is redone sequentially, so the result is identical to Heap. The
+ * batch size adapts to the share of such conflicts. This pays off for large
+ * problems with many free rows whose trees rarely overlap.
+ */
+enum class AugmentationStrategy { LinearScan, Heap, Parallel };
+
+/** @brief Selects how LAPJVsp obtains its initial assignment.
+ *
+ * ColumnReduction runs the column reduction, reduction transfer and
+ * augmenting row reduction phases of LAPJVsp. Rectangular problems, which
+ * leave columns unassigned, run a row reduction instead of the first two.
+ *
+ * Matching starts from a maximum cardinality matching found by Hopcroft-Karp
+ * and keeps the matched edges that are tight under the column minima.
+ */
+enum class InitialAssignment { ColumnReduction, Matching };
+
+/** @brief Configures LAPJVsp.
+ *
+ * If check_feasibility is set, a maximum cardinality matching is computed
+ * first and problems without a full row assignment are rejected in
+ * O(E sqrt(V)) before any weighted phase runs. The Matching initialization
+ * implies this check.
+ *
+ * Floating point reduced costs within epsilon of each other are treated as
+ * tied, which keeps rounding noise from splitting ties and causing extra
+ * scans and dual updates. The result is then optimal up to rows * epsilon.
+ * Integer costs always compare exactly and ignore epsilon.
+ *
+ * If vectorize is set, the column reduction and the augmenting row reduction
+ * scan rows with AVX2 or AVX-512 kernels, selected at runtime by the CPU.
+ * The kernels give the same results as the scalar loops, which are used on
+ * other CPUs, for costs other than double or if vectorize is cleared.
+ *
+ * num_threads only applies to the Parallel augmentation, where 0 selects the
+ * number of hardware threads.
+ */
+struct SparseJonkerVolgenantOptions {
+  AugmentationStrategy augmentation{AugmentationStrategy::LinearScan};
+  bool check_feasibility{false};
+  InitialAssignment initialization{InitialAssignment::ColumnReduction};
+  double epsilon{0.0};
+  bool vectorize{true};
+  std::size_t num_threads{0};
+};
+
+} // namespace asap
+
+#endif
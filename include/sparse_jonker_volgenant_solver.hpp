@@ -2,49 +2,120 @@
 #define ASAP_SPARSE_JONKER_VOLGENANT_SOLVER_HPP
 
 #include "common.hpp"
+#include "sparse_assignment_problem.hpp"
 #include "sparse_jonker_volgenant_solver_impl.hpp"
 
 namespace asap {
 
-struct Result {
-  std::vector<Eigen::Index> row_idx{};
-  std::vector<Eigen::Index> col_idx{};
-  bool valid{};
-};
+/** @brief Solves the sparse assignment problem reusing the buffers of ws.
+ *
+ * sm is a row- or column-major Eigen::SparseMatrix or a
+ * CompressedSparseRowMatrixView. The assignment and the duals are written to
+ * res whose buffers are reused as well, so repeated solves of problems no
+ * larger than previous ones are free of heap allocations. Compressed inputs
+ * whose storage has no more outer than inner vectors are solved in place
+ * without copying their entries. The index type of the workspace, for
+ * example std::int32_t, is carried through to the indices of res, and so is
+ * its allocator A: with a std::pmr::polymorphic_allocator both ws and res
+ * draw all their buffers from one std::pmr::memory_resource.
+ */
+template <typename SparseMatrixT, typename I, typename S, typename A>
+std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseJonkerVolgenantWorkspace<typename SparseMatrixT::Scalar, I, S, A> &ws,
+    Result<typename SparseMatrixT::Scalar, I, A> &res,
+    const SparseJonkerVolgenantOptions &options = {}) {
+  internal::visit_compressed_sparse_row_matrix(
+      sm, ws.csr, [&](const auto &csr, bool transposed) {
+        auto valid = false;
+        internal::lapjvsp(csr, ws, options, valid);
+        internal::assign_result(csr, ws.x, ws.v, transposed, valid, ws.match,
+                                res);
+      });
+}
+
+template <typename SparseMatrixT, typename I, typename S, typename A>
+[[nodiscard]] std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>,
+                               Result<typename SparseMatrixT::Scalar, I, A>>
+solve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseJonkerVolgenantWorkspace<typename SparseMatrixT::Scalar, I, S, A> &ws,
+    const SparseJonkerVolgenantOptions &options = {}) {
+  auto res = Result<typename SparseMatrixT::Scalar, I, A>{ws.get_allocator()};
+  solve_sparse_assignment_problem(sm, ws, res, options);
+  return res;
+}
 
 template <typename SparseMatrixT>
-[[nodiscard]] std::enable_if_t<is_row_major_v<SparseMatrixT>, Result>
-solve_sparse_assignment_problem(SparseMatrixT &&sm) {
-  using ScalarT = typename SparseMatrixT::Scalar;
+[[nodiscard]] std::enable_if_t<
+    is_sparse_assignment_problem_v<SparseMatrixT>,
+    Result<typename std::decay_t<SparseMatrixT>::Scalar>>
+solve_sparse_assignment_problem(
+    SparseMatrixT &&sm, const SparseJonkerVolgenantOptions &options = {}) {
+  using ScalarT = typename std::decay_t<SparseMatrixT>::Scalar;
 
-  const auto transpose = sm.rows() > sm.cols();
+  auto ws = SparseJonkerVolgenantWorkspace<ScalarT>{};
+  return solve_sparse_assignment_problem(sm, ws, options);
+}
 
-  auto csr = (transpose) ? CompressedSparseRowMatrix<ScalarT>{sm.transpose()}
-                         : CompressedSparseRowMatrix<ScalarT>{std::forward<SparseMatrixT>(sm)};
+namespace internal {
 
-  auto a = std::vector<Eigen::Index>(std::min(csr.rows, csr.cols));
-  std::iota(a.begin(), a.end(), 0);
+/** @brief Re-solves sm in place of the previous result res.
+ */
+template <typename SparseMatrixT, typename I, typename S, typename A>
+void resolve_into(
+    const SparseMatrixT &sm,
+    SparseJonkerVolgenantWorkspace<typename SparseMatrixT::Scalar, I, S, A> &ws,
+    Result<typename SparseMatrixT::Scalar, I, A> &res,
+    const SparseJonkerVolgenantOptions &options) {
+  visit_compressed_sparse_row_matrix(
+      sm, ws.csr, [&](const auto &csr, bool transposed) {
+        auto valid = false;
+        ws.reset(csr.rows, csr.cols);
+        if (assign_start(res, csr.rows, csr.cols, transposed, ws.x, ws.v)) {
+          lapjvsp_warm_start(csr, ws, options, valid);
+        } else {
+          lapjvsp(csr, ws, options, valid);
+        }
+        assign_result(csr, ws.x, ws.v, transposed, valid, ws.match, res);
+      });
+}
 
-  auto valid = bool{};
-  auto b = internal::lapjvsp(csr.row_ptr, csr.col_ind, csr.val,
-                             csr.rows, csr.cols, valid);
+} // namespace internal
 
-  if (transpose) {
-    const auto idx = internal::argsort(b);
-    internal::reorder(idx, a);
-    internal::reorder(idx, b);
+/** @brief Re-solves the sparse assignment problem starting from start.
+ *
+ * start holds the assignment and duals of a previous solve of a problem of
+ * the same shape, for example the previous frame of a tracker. Assignments
+ * that are no longer optimal under the previous duals are dropped and only
+ * their rows are augmented again, so small changes of the costs need few
+ * augmentations. Falls back to a full solve if start is invalid or of a
+ * different shape.
+ *
+ * start is taken by value, so a start passed as lvalue is never changed.
+ * Moving the previous result in reuses its buffers across frames:
+ *
+ *   res = asap::resolve_sparse_assignment_problem(sm, ws, std::move(res));
+ */
+template <typename SparseMatrixT, typename I, typename S, typename A>
+[[nodiscard]] std::enable_if_t<is_sparse_assignment_problem_v<SparseMatrixT>,
+                               Result<typename SparseMatrixT::Scalar, I, A>>
+resolve_sparse_assignment_problem(
+    const SparseMatrixT &sm,
+    SparseJonkerVolgenantWorkspace<typename SparseMatrixT::Scalar, I, S, A> &ws,
+    Result<typename SparseMatrixT::Scalar, I, A> start,
+    const SparseJonkerVolgenantOptions &options = {}) {
+  if (A(start.u.get_allocator()) == ws.get_allocator()) {
+    internal::resolve_into(sm, ws, start, options);
+    return start;
   }
-
-  return (transpose) ? Result{std::move(b), std::move(a), valid}
-                     : Result{std::move(a), std::move(b), valid};
-}
-
-template <typename SparseMatrixT>
-[[nodiscard]] std::enable_if_t<is_col_major_v<SparseMatrixT>, Result>
-solve_sparse_assignment_problem(SparseMatrixT &&sm) {
-  auto sm_row_major = static_cast<
-      Eigen::SparseMatrix<typename SparseMatrixT::Scalar, Eigen::RowMajor>>(sm);
-  return solve_sparse_assignment_problem(std::move(sm_row_major));
+  // A copied start holds the default memory resource, the result takes the
+  // one of the workspace.
+  auto res = Result<typename SparseMatrixT::Scalar, I, A>{ws.get_allocator()};
+  res = start;
+  internal::resolve_into(sm, ws, res, options);
+  return res;
 }
 
 } // namespace asap
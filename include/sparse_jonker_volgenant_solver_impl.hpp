@@ -1,7 +1,11 @@
 #ifndef ASAP_SPARSE_JONKER_VOLGENANT_SOLVER_IMPL_HPP
 #define ASAP_SPARSE_JONKER_VOLGENANT_SOLVER_IMPL_HPP
 
-#include "compressed_sparse_row_matrix.hpp"
+#include "cost_traits.hpp"
+#include "hopcroft_karp_impl.hpp"
+#include "simd_kernels.hpp"
+#include "sparse_jonker_volgenant_options.hpp"
+#include "sparse_jonker_volgenant_workspace.hpp"
 
 namespace asap {
 
@@ -29,40 +33,170 @@ namespace internal {
  * [4] https://docs.scipy.org/doc/scipy/reference/generated/
  *     scipy.sparse.csgraph.min_weight_full_bipartite_matching.html/
  */
-template <template <typename, typename> typename Container, typename T,
-          typename I, typename TA = std::allocator<T>,
-          typename IA = std::allocator<I>>
-[[nodiscard]] auto lapjvsp(const Container<I, IA> &first,
-                           const Container<I, IA> &kk,
-                           const Container<T, TA> &cc, I nr, I nc, bool &valid);
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp(const MatrixT &csr, SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+             const SparseJonkerVolgenantOptions &options, bool &valid);
 
-template <template <typename, typename> typename Container, typename T,
-          typename I, typename TA = std::allocator<T>,
-          typename IA = std::allocator<I>>
-[[nodiscard]] auto lapjvsp_single_l(
-    I l, I nc, Container<T, TA> &d, Container<bool, std::allocator<bool>> &ok,
-    const Container<I, IA> &free, const Container<I, IA> &first,
-    const Container<I, IA> &kk, const Container<T, TA> &cc, Container<T, TA> &v,
-    Container<I, IA> &lab, Container<I, IA> &todo, Container<I, IA> &y,
-    Container<I, IA> &x, I td1, bool &valid);
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+[[nodiscard]] I lapjvsp_single_l(I l, const MatrixT &csr,
+                                 SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                                 I td1, T eps, bool &valid);
+
+/** @brief Runs two augmenting row reduction passes over free[0..lp).
+ *
+ * Returns the number of rows left free, which are moved to the front of
+ * free. Best and second best reduced costs within options.epsilon count as
+ * tied, so rounding noise does not trigger vanishing dual decreases. The two
+ * minima of each row are found by the vectorized kernels if enabled. Duals
+ * only decrease and assigned columns stay assigned, so on rectangular
+ * problems the unassigned columns keep the maximal dual. The duals of an
+ * infeasible problem are unbounded, so rows displacing each other around a
+ * column set too small for them would lower its duals forever. A pass
+ * therefore stops after lp plus the number of non-zeros steps and leaves
+ * its remaining rows free for the augmentation, which detects that.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+[[nodiscard]] I lapjvsp_augmenting_row_reduction(
+    I lp, const MatrixT &csr, SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+    const SparseJonkerVolgenantOptions &options, bool &valid);
+
+/** @brief Augments the free rows free[0..l0) along shortest paths.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_augment(I l0, const MatrixT &csr,
+                     SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                     const SparseJonkerVolgenantOptions &options, bool &valid);
+
+/** @brief Completes a given partial assignment to an optimal one.
+ *
+ * On entry ws.x holds a row to column assignment and ws.v column duals, for
+ * example from a previous solve or an auction. Assignments to missing edges,
+ * to already claimed columns or violating complementary slackness are
+ * dropped, and only the unassigned rows are augmented. The closer the input
+ * is to an optimal primal-dual pair, the fewer rows are left to augment.
+ * The free rows first pass augmenting row reduction.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_warm_start(const MatrixT &csr,
+                        SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                        const SparseJonkerVolgenantOptions &options,
+                        bool &valid);
 
+/** @brief Starts from the maximum cardinality matching in ws.matching.
+ *
+ * The column duals are initialized to the column minima. Matched edges that
+ * are not tight under these duals are dropped by lapjvsp_warm_start and their
+ * rows are augmented again.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_matching_start(const MatrixT &csr,
+                            SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                            const SparseJonkerVolgenantOptions &options,
+                            bool &valid);
+
+/** @brief Augments free row free[l] using a heap-based Dijkstra search.
+ *
+ * Expects d to be INF and ok to be false for all columns on entry and
+ * restores this state for the touched columns before returning.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_single_l_heap(I l, const MatrixT &csr,
+                           SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                           bool &valid);
+
+/** @brief Augments free[0..l0) by speculative heap searches on a pool.
+ *
+ * Each round searches from a batch of free rows concurrently against the
+ * current duals and assignment, and records the augmentations found. They
+ * are then committed in the order of free. A commit changes only the duals
+ * of the scanned columns and the assignment of the columns on its path,
+ * which are stamped with the round. A search that reached a stamped column
+ * read state that has since changed and is redone on the calling thread.
+ * Every other search only read unchanged state and equals the search the
+ * Heap augmentation runs at this point, so the result is the same. The
+ * batch halves after rounds with more than half conflicts and doubles
+ * otherwise.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_augment_parallel(I l0, const MatrixT &csr,
+                              SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                              const SparseJonkerVolgenantOptions &options,
+                              bool &valid);
+
+/** @brief Searches from row i0 and records the augmentation into aug.
+ *
+ * Leaves the buffers of search restored for the next search.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_speculate(I i0, const MatrixT &csr,
+                       const SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                       SpeculativeSearch<T, I, A> &search,
+                       SpeculativeAugmentation<T, I, A> &aug);
+
+/** @brief Dijkstra search for a shortest augmenting path from row i0.
+ *
+ * Reads the duals and the assignment of ws and writes only to the search
+ * buffers d, ok, lab, lab_edge, todo, touched and heap of search, which may
+ * be ws itself. Returns the free column reached, or -1 if there is none. The
+ * todo[0..scanned) columns were scanned at distances below min_diff.
+ */
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A, typename Search>
+[[nodiscard]] I
+lapjvsp_search_heap(I i0, const MatrixT &csr,
+                    const SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                    Search &search, I &scanned, T &min_diff);
+
+/** @brief Applies the augmentation found by lapjvsp_search_heap to ws.
+ */
+template <typename T, typename I, typename S, typename A,
+          typename Search>
+void lapjvsp_commit_heap(I i0, I j, I scanned, T min_diff,
+                         const Search &search,
+                         SparseJonkerVolgenantWorkspace<T, I, S, A> &ws);
+
+/** @brief Restores d to INF and ok to false for the touched columns.
+ */
+template <typename Search> void lapjvsp_reset_search(Search &search);
+
+/** @brief Flips the alternating path ending in column j back to row i0.
+ *
+ * Column j is reached from row lab[j] through CSR edge lab_edge[j], which
+ * becomes its matched edge y_edge[j]. Returns the number of columns on the
+ * path.
+ */
 template <template <typename, typename> typename Container, typename I,
           typename IA = std::allocator<I>>
-void lapjvsp_update_assignments(const Container<I, IA> &lab,
-                                Container<I, IA> &y, Container<I, IA> &x, I &j,
-                                I i0);
+I lapjvsp_update_assignments(const Container<I, IA> &lab,
+                                const Container<I, IA> &lab_edge,
+                                Container<I, IA> &y, Container<I, IA> &y_edge,
+                                Container<I, IA> &x, I &j, I i0);
 template <template <typename, typename> typename Container, typename T,
           typename I, typename TA = std::allocator<T>,
           typename IA = std::allocator<I>>
 void lapjvsp_update_dual(I nc, const Container<T, TA> &d, Container<T, TA> &v,
                          const Container<I, IA> &todo, I last, T min_diff);
 
-template <template <typename, typename> typename Container, typename T,
-          typename I, typename TA, typename IA>
-auto lapjvsp(const Container<I, IA> &first, const Container<I, IA> &kk,
-             const Container<T, TA> &cc, I nr, I nc, bool &valid) {
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp(const MatrixT &csr, SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+             const SparseJonkerVolgenantOptions &options, bool &valid) {
+  static constexpr auto INF = infinity<T>();
 
-  static constexpr auto INF = std::numeric_limits<T>::max();
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = static_cast<I>(csr.rows);
+  const auto nc = static_cast<I>(csr.cols);
 
   auto l0 = I{0};
   auto jp = I{0};
@@ -70,53 +204,62 @@ auto lapjvsp(const Container<I, IA> &first, const Container<I, IA> &kk,
   auto lp = I{0};
   auto j1 = I{0};
   auto tp = I{0};
-  auto j0p = I{0};
-  auto j1p = I{0};
-  auto l0p = I{0};
-  auto h = I{0};
-  auto i0 = I{0};
-  auto td1 = I{0};
-  auto min_diff = T{0.0};
-  auto v0 = T{0.0};
-  auto vj = T{0.0};
-  auto dj = T{0.0};
-  auto v = Container<T, TA>(nc, T{0.0});
-  auto x = Container<I, IA>(nr, I{-1});
-  auto y = Container<I, IA>(nc, I{-1});
-  auto u = Container<T, TA>(nr, T{0.0});
-  auto d = Container<T, TA>(nc, T{0.0});
-  auto ok = Container<bool, std::allocator<bool>>(nc, false);
-  auto xinv = Container<bool, std::allocator<bool>>(nr, false);
-  auto free = Container<I, IA>(nr, I{-1});
-  auto todo = Container<I, IA>(nc, I{-1});
-  auto lab = Container<I, IA>(nc, I{0});
+  auto min_diff = T{0};
 
+  ws.reset(nr, nc);
+  auto &v = ws.v;
+  auto &x = ws.x;
+  auto &y = ws.y;
+  auto &u = ws.u;
+  auto &xinv = ws.xinv;
+  auto &free = ws.free;
+
+  valid = true;
+
+  if (options.check_feasibility ||
+      (options.initialization == InitialAssignment::Matching)) {
+    ws.stats.begin_phase(SolverPhase::Feasibility);
+    hopcroft_karp(csr, ws.matching);
+    ws.stats.end_phase(SolverPhase::Feasibility, nr - ws.matching.matched);
+    if (ws.matching.matched < nr) {
+      valid = false;
+      return;
+    }
+  }
+  if (options.initialization == InitialAssignment::Matching) {
+    lapjvsp_matching_start(csr, ws, options, valid);
+    return;
+  }
+
+  const auto simd =
+      options.vectorize ? detect_simd_level() : SimdLevel::Scalar;
   if (nr == nc) {
+    ws.stats.begin_phase(SolverPhase::ColumnReduction);
+    auto assigned = I{0};
     for (I z = 0; z < nc; ++z) {
       v[z] = INF;
     }
     for (I z = 0; z < nr; ++z) {
-      for (I t = first[z]; t < first[z + 1]; ++t) {
-        jp = kk[t];
-        if (cc[t] < v[jp]) {
-          v[jp] = cc[t];
-          y[jp] = z;
-        }
-      }
+      column_minima(simd, cc, kk, v.data(), y.data(), z, first[z],
+                    first[z + 1]);
     }
     for (I z = nc - 1; z >= 0; --z) {
       i = y[z];
       if (i == -1) {
         valid = false;
-        return Container<I, IA>{};
+        return;
       }
       if (x[i] == -1) {
         x[i] = z;
+        ++assigned;
       } else {
         y[z] = -1;
         xinv[i] = true;
       }
     }
+    ws.stats.end_phase(SolverPhase::ColumnReduction, nr - assigned);
+
+    ws.stats.begin_phase(SolverPhase::ReductionTransfer);
     lp = 0;
     for (I z = 0; z < nr; ++z) {
       if (xinv[z]) {
@@ -131,100 +274,348 @@ auto lapjvsp(const Container<I, IA> &first, const Container<I, IA> &kk,
             if (cc[t] - v[jp] < min_diff) {
               min_diff = cc[t] - v[jp];
             }
+          } else {
+            tp = t;
           }
         }
         u[z] = min_diff;
-        tp = first[z];
-        while (kk[tp] != j1) {
-          ++tp;
-        }
         v[j1] = cc[tp] - min_diff;
       } else {
         free[lp] = z;
         ++lp;
       }
     }
-    for (I _ = 0; _ < 2; ++_) {
-      h = 0;
-      l0p = lp;
-      lp = 0;
-      while (h < l0p) {
-        i = free[h];
-        ++h;
-        j0p = -1;
-        j1p = -1;
-        v0 = INF;
-        vj = INF;
-        for (I t = first[i]; t < first[i + 1]; ++t) {
-          jp = kk[t];
-          dj = cc[t] - v[jp];
-          if (dj < vj) {
-            if (dj >= v0) {
-              vj = dj;
-              j1p = jp;
-            } else {
-              vj = v0;
-              v0 = dj;
-              j1p = j0p;
-              j0p = jp;
-            }
-          }
-        }
-        if (j0p < 0) {
-          valid = false;
-          return Container<I, IA>{};
+    ws.stats.end_phase(SolverPhase::ReductionTransfer, lp);
+  } else {
+    // The nc - nr columns left unassigned must keep the maximal dual of 0, so
+    // column reduction does not apply. Each row instead takes its cheapest
+    // column if that is still free, and the dual of the column drops by the
+    // gap to the second cheapest one. This keeps all columns at or below 0,
+    // with the free ones at 0, and all assigned edges tight.
+    ws.stats.begin_phase(SolverPhase::RowReduction);
+    const auto eps = tolerance<T>(options.epsilon);
+    lp = 0;
+    for (I z = 0; z < nr; ++z) {
+      const auto m =
+          two_minima(simd, cc, kk, v.data(), first[z], first[z + 1]);
+      if (m.t0 == -1) {
+        valid = false;
+        return;
+      }
+      j1 = static_cast<I>(kk[m.t0]);
+      if (y[j1] != -1) {
+        free[lp] = z;
+        ++lp;
+        continue;
+      }
+      x[z] = j1;
+      y[j1] = z;
+      u[z] = m.v1;
+      if ((m.v0 < m.v1) && !is_tie(m.v0, m.v1, eps)) {
+        v[j1] += (m.v0 - m.v1);
+      }
+    }
+    ws.stats.end_phase(SolverPhase::RowReduction, lp);
+  }
+  l0 = lapjvsp_augmenting_row_reduction(lp, csr, ws, options, valid);
+  if (!valid) {
+    return;
+  }
+  ws.stats.begin_phase(SolverPhase::Augmentation);
+  lapjvsp_augment(l0, csr, ws, options, valid);
+  ws.stats.end_phase(SolverPhase::Augmentation, valid ? I{0} : l0);
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+I lapjvsp_augmenting_row_reduction(
+    I lp, const MatrixT &csr, SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+    const SparseJonkerVolgenantOptions &options, bool &valid) {
+  const auto eps = tolerance<T>(options.epsilon);
+  const auto simd =
+      options.vectorize ? detect_simd_level() : SimdLevel::Scalar;
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  auto &v = ws.v;
+  auto &x = ws.x;
+  auto &y = ws.y;
+  auto &u = ws.u;
+  auto &free = ws.free;
+
+  auto i = I{0};
+  auto j0p = I{0};
+  auto j1p = I{0};
+  auto l0p = I{0};
+  auto h = I{0};
+  auto i0 = I{0};
+  auto v0 = T{0};
+  auto vj = T{0};
+
+  for (I _ = 0; _ < 2; ++_) {
+    ws.stats.begin_phase(SolverPhase::AugmentingRowReduction);
+    h = 0;
+    l0p = lp;
+    lp = 0;
+    auto steps = l0p + static_cast<I>(first[csr.rows] - first[0]);
+    while (h < l0p) {
+      if (--steps < 0) {
+        while (h < l0p) {
+          free[lp] = free[h];
+          ++lp;
+          ++h;
         }
+        break;
+      }
+      i = free[h];
+      ++h;
+      const auto m =
+          two_minima(simd, cc, kk, v.data(), first[i], first[i + 1]);
+      v0 = m.v0;
+      vj = m.v1;
+      j0p = (m.t0 == -1) ? I{-1} : static_cast<I>(kk[m.t0]);
+      j1p = (m.t1 == -1) ? I{-1} : static_cast<I>(kk[m.t1]);
+      if (j0p < 0) {
+        valid = false;
+        return I{};
+      }
+      i0 = y[j0p];
+      u[i] = vj;
+      const auto decrease = (v0 < vj) && !is_tie(v0, vj, eps);
+      if (decrease) {
+        v[j0p] += (v0 - vj);
+      } else if ((i0 != -1) && (j1p != -1)) {
+        j0p = j1p;
         i0 = y[j0p];
-        u[i] = vj;
-        if (v0 < vj) {
-          v[j0p] += (v0 - vj);
-        } else if (i0 != -1) {
-          j0p = j1p;
-          i0 = y[j0p];
-        }
-        x[i] = j0p;
-        y[j0p] = i;
-        if (i0 != -1) {
-          if (v0 < vj) {
-            --h;
-            free[h] = i0;
-          } else {
-            free[lp] = i0;
-            ++lp;
-          }
+      }
+      x[i] = j0p;
+      y[j0p] = i;
+      if (i0 != -1) {
+        if (decrease) {
+          --h;
+          free[h] = i0;
+        } else {
+          free[lp] = i0;
+          ++lp;
         }
       }
     }
-    l0 = lp;
-  } else {
-    l0 = nr;
-    for (I z = 0; z < nr; ++z) {
-      free[z] = z;
+    ws.stats.end_phase(SolverPhase::AugmentingRowReduction, lp);
+  }
+  return lp;
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_augment(I l0, const MatrixT &csr,
+                     SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                     const SparseJonkerVolgenantOptions &options,
+                     bool &valid) {
+
+  static constexpr auto INF = infinity<T>();
+
+  ws.augmentations = l0;
+  if (l0 == 0) {
+    return;
+  }
+
+  // The searches read the cost of matched edges through y_edge, which is
+  // kept up to date by every augmentation from here on. x may still hold
+  // stale entries for free rows, so the matched edges are taken from y.
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  for (I j = 0; j < static_cast<I>(csr.cols); ++j) {
+    const auto i = ws.y[j];
+    if (i == -1) {
+      continue;
+    }
+    auto t = static_cast<I>(first[i]);
+    while (kk[t] != j) {
+      ++t;
     }
+    ws.y_edge[j] = t;
   }
-  td1 = -1;
+
+  if (options.augmentation != AugmentationStrategy::LinearScan) {
+    std::fill(ws.d.begin(), ws.d.end(), INF);
+    std::fill(ws.ok.begin(), ws.ok.end(), false);
+    if (options.augmentation == AugmentationStrategy::Parallel) {
+      lapjvsp_augment_parallel(l0, csr, ws, options, valid);
+      return;
+    }
+    for (I l = 0; l < l0; ++l) {
+      lapjvsp_single_l_heap(l, csr, ws, valid);
+      if (!valid) {
+        return;
+      }
+    }
+    return;
+  }
+  const auto eps = tolerance<T>(options.epsilon);
+  auto td1 = I{-1};
   for (I l = 0; l < l0; ++l) {
-    td1 = lapjvsp_single_l(l, nc, d, ok, free, first, kk, cc, v, lab, todo, y,
-                           x, td1, valid);
+    td1 = lapjvsp_single_l(l, csr, ws, td1, eps, valid);
     if (!valid) {
-      return Container<I, IA>{};
+      return;
     }
   }
-  return x;
 }
 
-template <template <typename, typename> typename Container, typename T,
-          typename I, typename TA, typename IA>
-auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
-                      Container<bool, std::allocator<bool>> &ok,
-                      const Container<I, IA> &free,
-                      const Container<I, IA> &first, const Container<I, IA> &kk,
-                      const Container<T, TA> &cc, Container<T, TA> &v,
-                      Container<I, IA> &lab, Container<I, IA> &todo,
-                      Container<I, IA> &y, Container<I, IA> &x, I td1,
-                      bool &valid) {
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_warm_start(const MatrixT &csr,
+                        SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                        const SparseJonkerVolgenantOptions &options,
+                        bool &valid) {
+  static constexpr auto INF = infinity<T>();
 
-  static constexpr auto INF = std::numeric_limits<T>::max();
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = static_cast<I>(csr.rows);
+  const auto nc = static_cast<I>(csr.cols);
+  auto &v = ws.v;
+  auto &x = ws.x;
+  auto &y = ws.y;
+  auto &free = ws.free;
+  const auto eps = tolerance<T>(options.epsilon);
+
+  valid = true;
+  ws.stats.begin_phase(SolverPhase::WarmStart);
+
+  // Keep only assignments to distinct columns.
+  std::fill(y.begin(), y.end(), I{-1});
+  for (I i = 0; i < nr; ++i) {
+    const auto j = x[i];
+    if ((j < 0) || (j >= nc) || (y[j] != -1)) {
+      x[i] = -1;
+      continue;
+    }
+    y[j] = i;
+  }
+
+  // Shortest augmenting paths on rectangular problems require all unassigned
+  // columns to carry the maximal dual.
+  if (nr < nc) {
+    const auto v_max = *std::max_element(v.begin(), v.end());
+    for (I j = 0; j < nc; ++j) {
+      v[j] = (y[j] == -1) ? T{0} : v[j] - v_max;
+    }
+  }
+
+  // Drop assignments to missing edges and assignments that violate
+  // complementary slackness. Dropping leaves the duals untouched, except on
+  // rectangular problems where the released column is raised to the maximal
+  // dual, which may in turn invalidate other assignments.
+  auto changed = true;
+  while (changed) {
+    changed = false;
+    for (I i = 0; i < nr; ++i) {
+      const auto j1 = x[i];
+      if (j1 == -1) {
+        continue;
+      }
+      auto min_diff = INF;
+      auto c1 = T{0};
+      auto found = false;
+      for (I t = first[i]; t < first[i + 1]; ++t) {
+        const auto j = static_cast<I>(kk[t]);
+        if (j == j1) {
+          c1 = cc[t];
+          found = true;
+        } else if (cc[t] - v[j] < min_diff) {
+          min_diff = cc[t] - v[j];
+        }
+      }
+      if (!found ||
+          ((min_diff != INF) && (c1 - v[j1] - min_diff > eps))) {
+        x[i] = -1;
+        y[j1] = -1;
+        if (nr < nc) {
+          v[j1] = T{0};
+          changed = true;
+        }
+      }
+    }
+  }
+
+  auto l0 = I{0};
+  for (I i = 0; i < nr; ++i) {
+    if (x[i] == -1) {
+      free[l0] = i;
+      ++l0;
+    }
+  }
+  ws.stats.end_phase(SolverPhase::WarmStart, l0);
+
+  // Like a cold start, most free rows are handed back cheaply by augmenting
+  // row reduction before searching for shortest paths.
+  l0 = lapjvsp_augmenting_row_reduction(l0, csr, ws, options, valid);
+  if (!valid) {
+    return;
+  }
+
+  ws.stats.begin_phase(SolverPhase::Augmentation);
+  lapjvsp_augment(l0, csr, ws, options, valid);
+  ws.stats.end_phase(SolverPhase::Augmentation, valid ? I{0} : l0);
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_matching_start(const MatrixT &csr,
+                            SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                            const SparseJonkerVolgenantOptions &options,
+                            bool &valid) {
+  static constexpr auto INF = infinity<T>();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nr = static_cast<I>(csr.rows);
+  auto &v = ws.v;
+
+  ws.stats.begin_phase(SolverPhase::ColumnReduction);
+  std::copy(ws.matching.x.begin(), ws.matching.x.begin() + nr, ws.x.begin());
+  std::fill(v.begin(), v.end(), INF);
+  for (I i = 0; i < nr; ++i) {
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      v[kk[t]] = std::min(v[kk[t]], cc[t]);
+    }
+  }
+  for (auto &vj : v) {
+    if (vj == INF) {
+      vj = T{0};
+    }
+  }
+  ws.stats.end_phase(SolverPhase::ColumnReduction,
+                     nr - ws.matching.matched);
+
+  lapjvsp_warm_start(csr, ws, options, valid);
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+I lapjvsp_single_l(I l, const MatrixT &csr,
+                   SparseJonkerVolgenantWorkspace<T, I, S, A> &ws, I td1, T eps,
+                   bool &valid) {
+
+  static constexpr auto INF = infinity<T>();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto nc = static_cast<I>(csr.cols);
+  const auto &free = ws.free;
+  auto &d = ws.d;
+  auto &ok = ws.ok;
+  auto &v = ws.v;
+  auto &lab = ws.lab;
+  auto &lab_edge = ws.lab_edge;
+  auto &todo = ws.todo;
+  auto &y = ws.y;
+  auto &y_edge = ws.y_edge;
+  auto &x = ws.x;
 
   valid = true;
 
@@ -235,10 +626,10 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
   auto j0 = I{0};
   auto i = I{0};
   auto tp = I{0};
-  auto min_diff = T{0.0};
-  auto dj = T{0.0};
-  auto h = T{0.0};
-  auto vj = T{0.0};
+  auto min_diff = T{0};
+  auto dj = T{0};
+  auto h = T{0};
+  auto vj = T{0};
 
   for (I jp = 0; jp < nc; ++jp) {
     d[jp] = INF;
@@ -247,11 +638,13 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
   min_diff = INF;
   i0 = free[l];
 
+  ws.stats.relax_edges(first[i0 + 1] - first[i0]);
   for (I t = first[i0]; t < first[i0 + 1]; ++t) {
     j = kk[t];
     dj = cc[t] - v[j];
     d[j] = dj;
     lab[j] = i0;
+    lab_edge[j] = t;
     if (dj <= min_diff) {
       if (dj < min_diff) {
         td1 = -1;
@@ -264,7 +657,8 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
   for (I hp = 0; hp < td1 + 1; ++hp) {
     j = todo[hp];
     if (y[j] == -1) {
-      lapjvsp_update_assignments(lab, y, x, j, i0);
+      ws.stats.augmenting_path(
+          lapjvsp_update_assignments(lab, lab_edge, y, y_edge, x, j, i0));
       return td1;
     }
     ok[j] = true;
@@ -282,12 +676,10 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
     i = y[j0];
     todo[td2] = j0;
     --td2;
-    tp = first[i];
-    while (kk[tp] != j0) {
-      ++tp;
-    }
+    tp = y_edge[j0];
     h = cc[tp] - v[j0] - min_diff;
 
+    ws.stats.relax_edges(first[i + 1] - first[i]);
     for (I t = first[i]; t < first[i + 1]; ++t) {
       j = kk[t];
       if (!ok[j]) {
@@ -295,10 +687,12 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
         if (vj < d[j]) {
           d[j] = vj;
           lab[j] = i;
-          if (vj == min_diff) {
+          lab_edge[j] = t;
+          if (is_tie(vj, min_diff, eps)) {
             if (y[j] == -1) {
               lapjvsp_update_dual(nc, d, v, todo, last, min_diff);
-              lapjvsp_update_assignments(lab, y, x, j, i0);
+              ws.stats.augmenting_path(lapjvsp_update_assignments(
+                  lab, lab_edge, y, y_edge, x, j, i0));
               return td1;
             }
             ++td1;
@@ -310,6 +704,7 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
     }
 
     if (td1 == -1) {
+      ws.stats.min_scan();
       min_diff = INF;
       last = td2 + 1;
 
@@ -327,7 +722,8 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
         j = todo[hp];
         if (y[j] == -1) {
           lapjvsp_update_dual(nc, d, v, todo, last, min_diff);
-          lapjvsp_update_assignments(lab, y, x, j, i0);
+          ws.stats.augmenting_path(
+              lapjvsp_update_assignments(lab, lab_edge, y, y_edge, x, j, i0));
           return td1;
         }
         ok[j] = true;
@@ -336,21 +732,272 @@ auto lapjvsp_single_l(I l, I nc, Container<T, TA> &d,
   }
 }
 
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_single_l_heap(I l, const MatrixT &csr,
+                           SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                           bool &valid) {
+  const auto i0 = ws.free[l];
+  auto scanned = I{0};
+  auto min_diff = T{0};
+  const auto j = lapjvsp_search_heap(i0, csr, ws, ws, scanned, min_diff);
+  valid = (j != -1);
+  if (valid) {
+    lapjvsp_commit_heap(i0, j, scanned, min_diff, ws, ws);
+  }
+  lapjvsp_reset_search(ws);
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_augment_parallel(I l0, const MatrixT &csr,
+                              SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                              const SparseJonkerVolgenantOptions &options,
+                              bool &valid) {
+
+  static constexpr auto INF = infinity<T>();
+
+  const auto nc = static_cast<I>(csr.cols);
+  auto &stamp = ws.stamp;
+
+  reset_thread_pool(ws.pool, options.num_threads);
+  const auto threads = static_cast<I>(ws.pool->size());
+  const auto max_batch = std::min(l0, I{64} * threads);
+  resize_with_allocator(ws.searches, static_cast<std::size_t>(threads),
+                        ws.get_allocator());
+  for (auto &search : ws.searches) {
+    search.d.assign(nc, INF);
+    search.ok.assign(nc, false);
+    search.lab.resize(nc);
+    search.lab_edge.resize(nc);
+    search.todo.resize(nc);
+  }
+  resize_with_allocator(ws.speculations, static_cast<std::size_t>(max_batch),
+                        ws.get_allocator());
+  stamp.assign(nc, I{-1});
+
+  valid = true;
+
+  auto batch = std::min(I{4} * threads, max_batch);
+  auto round = I{0};
+  for (I l = 0; l < l0; ++round) {
+    batch = std::min(batch, l0 - l);
+    ws.pool->parallel_for(
+        static_cast<std::size_t>(batch), 1,
+        [&](std::size_t begin, std::size_t end, std::size_t thread) {
+          auto &search = ws.searches[thread];
+          for (auto k = begin; k < end; ++k) {
+            lapjvsp_speculate(ws.free[l + static_cast<I>(k)], csr,
+                              std::as_const(ws), search,
+                              ws.speculations[k]);
+          }
+        });
+    for (auto &search : ws.searches) {
+      ws.stats.relax_edges(search.stats.edges);
+      for (Eigen::Index k = 0; k < search.stats.scans; ++k) {
+        ws.stats.min_scan();
+      }
+      search.stats = SearchCounters{};
+    }
+
+    auto conflicts = I{0};
+    for (I k = 0; k < batch; ++k) {
+      const auto &aug = ws.speculations[static_cast<std::size_t>(k)];
+      const auto stale =
+          std::any_of(aug.touched.begin(), aug.touched.end(),
+                      [&](const auto j) { return stamp[j] == round; });
+      if (stale) {
+        ++conflicts;
+        auto scanned = I{0};
+        auto min_diff = T{0};
+        const auto j =
+            lapjvsp_search_heap(aug.row, csr, ws, ws, scanned, min_diff);
+        valid = (j != -1);
+        if (valid) {
+          for (I t = 0; t < scanned; ++t) {
+            stamp[ws.todo[t]] = round;
+          }
+          stamp[j] = round;
+          lapjvsp_commit_heap(aug.row, j, scanned, min_diff, ws, ws);
+        }
+        lapjvsp_reset_search(ws);
+      } else {
+        valid = (aug.end != -1);
+        if (valid) {
+          for (const auto &[j, dv] : aug.duals) {
+            ws.v[j] += dv;
+            stamp[j] = round;
+          }
+          for (const auto &[j, i, t] : aug.path) {
+            ws.lab[j] = i;
+            ws.lab_edge[j] = t;
+          }
+          stamp[aug.end] = round;
+          auto j = aug.end;
+          ws.stats.augmenting_path(lapjvsp_update_assignments(
+              ws.lab, ws.lab_edge, ws.y, ws.y_edge, ws.x, j, aug.row));
+        }
+      }
+      if (!valid) {
+        ws.conflicts += conflicts;
+        return;
+      }
+    }
+
+    l += batch;
+    ws.conflicts += conflicts;
+    batch = (I{2} * conflicts > batch) ? std::max(batch / I{2}, I{1})
+                                       : std::min(I{2} * batch, max_batch);
+  }
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A>
+void lapjvsp_speculate(I i0, const MatrixT &csr,
+                       const SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                       SpeculativeSearch<T, I, A> &search,
+                       SpeculativeAugmentation<T, I, A> &aug) {
+  auto scanned = I{0};
+  auto min_diff = T{0};
+  aug.row = i0;
+  aug.end = lapjvsp_search_heap(i0, csr, ws, search, scanned, min_diff);
+  aug.touched.assign(search.touched.begin(), search.touched.end());
+  aug.duals.clear();
+  aug.path.clear();
+  if (aug.end != -1) {
+    for (I k = 0; k < scanned; ++k) {
+      const auto j = search.todo[k];
+      aug.duals.emplace_back(j, search.d[j] - min_diff);
+    }
+    // Walks the path back to i0 like lapjvsp_update_assignments does.
+    auto j = aug.end;
+    while (true) {
+      const auto i = search.lab[j];
+      aug.path.emplace_back(j, i, search.lab_edge[j]);
+      if (i == i0) {
+        break;
+      }
+      j = ws.x[i];
+    }
+  }
+  lapjvsp_reset_search(search);
+}
+
+template <typename MatrixT, typename T, typename I, typename S,
+          typename A, typename Search>
+I lapjvsp_search_heap(I i0, const MatrixT &csr,
+                      const SparseJonkerVolgenantWorkspace<T, I, S, A> &ws,
+                      Search &search, I &scanned, T &min_diff) {
+
+  static constexpr auto INF = infinity<T>();
+
+  const auto &first = csr.row_ptr;
+  const auto &kk = csr.col_ind;
+  const auto &cc = csr.val;
+  const auto &v = ws.v;
+  const auto &y = ws.y;
+  const auto &y_edge = ws.y_edge;
+  auto &d = search.d;
+  auto &ok = search.ok;
+  auto &lab = search.lab;
+  auto &lab_edge = search.lab_edge;
+  auto &todo = search.todo;
+  auto &touched = search.touched;
+  auto &heap = search.heap;
+
+  // Min-heap on the reduced distance that prefers unassigned columns on ties
+  // so that, like the linear scan, a search ends as early as possible.
+  const auto later = [&y](const auto &lhs, const auto &rhs) {
+    return (lhs.first > rhs.first) ||
+           ((lhs.first == rhs.first) && (y[lhs.second] != -1) &&
+            (y[rhs.second] == -1));
+  };
+  const auto relax = [&](I i, T h) {
+    search.stats.relax_edges(first[i + 1] - first[i]);
+    for (I t = first[i]; t < first[i + 1]; ++t) {
+      const auto j = static_cast<I>(kk[t]);
+      if (!ok[j]) {
+        const auto dj = cc[t] - v[j] - h;
+        if (dj < d[j]) {
+          if (d[j] == INF) {
+            touched.push_back(j);
+          }
+          d[j] = dj;
+          lab[j] = i;
+          lab_edge[j] = t;
+          heap.emplace_back(dj, j);
+          std::push_heap(heap.begin(), heap.end(), later);
+        }
+      }
+    }
+  };
+
+  scanned = I{0};
+  relax(i0, T{0});
+
+  while (!heap.empty()) {
+    search.stats.min_scan();
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const auto [dj, j] = heap.back();
+    heap.pop_back();
+    if (ok[j] || (dj > d[j])) {
+      continue;
+    }
+    if (y[j] == -1) {
+      min_diff = dj;
+      return j;
+    }
+    ok[j] = true;
+    todo[scanned] = j;
+    ++scanned;
+
+    relax(y[j], cc[y_edge[j]] - v[j] - dj);
+  }
+  return I{-1};
+}
+
+template <typename T, typename I, typename S, typename A,
+          typename Search>
+void lapjvsp_commit_heap(I i0, I j, I scanned, T min_diff,
+                         const Search &search,
+                         SparseJonkerVolgenantWorkspace<T, I, S, A> &ws) {
+  for (I k = 0; k < scanned; ++k) {
+    const auto jk = search.todo[k];
+    ws.v[jk] += (search.d[jk] - min_diff);
+  }
+  ws.stats.augmenting_path(lapjvsp_update_assignments(
+      search.lab, search.lab_edge, ws.y, ws.y_edge, ws.x, j, i0));
+}
+
+template <typename Search> void lapjvsp_reset_search(Search &search) {
+  using T = typename decltype(search.d)::value_type;
+  for (const auto j : search.touched) {
+    search.d[j] = infinity<T>();
+    search.ok[j] = false;
+  }
+  search.touched.clear();
+  search.heap.clear();
+}
+
 template <template <typename, typename> typename Container, typename I,
           typename IA>
-void lapjvsp_update_assignments(const Container<I, IA> &lab,
-                                Container<I, IA> &y, Container<I, IA> &x, I &j,
-                                I i0) {
+I lapjvsp_update_assignments(const Container<I, IA> &lab,
+                                const Container<I, IA> &lab_edge,
+                                Container<I, IA> &y, Container<I, IA> &y_edge,
+                                Container<I, IA> &x, I &j, I i0) {
   auto i = I{0};
   auto k = I{0};
+  auto length = I{0};
   while (true) {
     i = lab[j];
     y[j] = i;
+    y_edge[j] = lab_edge[j];
     k = j;
     j = x[i];
     x[i] = k;
+    ++length;
     if (i == i0) {
-      return;
+      return length;
     }
   }
 }
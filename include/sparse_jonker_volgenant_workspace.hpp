@@ -0,0 +1,188 @@
+#ifndef ASAP_SPARSE_JONKER_VOLGENANT_WORKSPACE_HPP
+#define ASAP_SPARSE_JONKER_VOLGENANT_WORKSPACE_HPP
+
+#include "compressed_sparse_row_matrix.hpp"
+#include "hopcroft_karp_workspace.hpp"
+#include "solver_stats.hpp"
+#include "thread_pool.hpp"
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace asap {
+
+namespace internal {
+
+/** @brief Counts the work of a search that runs off the calling thread.
+ */
+struct SearchCounters {
+  void relax_edges(Eigen::Index n) noexcept { edges += n; }
+  void min_scan() noexcept { ++scans; }
+
+  Eigen::Index edges{};
+  Eigen::Index scans{};
+};
+
+/** @brief Buffers of a shortest augmenting path search on a pool thread.
+ *
+ * The members mirror the search buffers of the workspace, so the heap search
+ * runs unchanged on either.
+ */
+template <typename T, typename I, typename A = std::allocator<T>>
+struct SpeculativeSearch {
+  SpeculativeSearch() = default;
+
+  explicit SpeculativeSearch(const A &alloc) noexcept
+      : d{alloc}, ok{alloc}, lab{alloc}, lab_edge{alloc}, todo{alloc},
+        touched{alloc}, heap{alloc} {}
+
+  rebind_vector_t<T, A> d{};
+  rebind_vector_t<bool, A> ok{};
+  rebind_vector_t<I, A> lab{};
+  rebind_vector_t<I, A> lab_edge{};
+  rebind_vector_t<I, A> todo{};
+  rebind_vector_t<I, A> touched{};
+  rebind_vector_t<std::pair<T, I>, A> heap{};
+  SearchCounters stats{};
+};
+
+/** @brief Augmentation found by a speculative search, not yet committed.
+ *
+ * end is the free column reached from the free row, -1 if there is none.
+ * touched holds all columns the search reached, duals the dual increments
+ * of the scanned columns and path the (column, row, edge) labels of the
+ * columns on the augmenting path.
+ */
+template <typename T, typename I, typename A = std::allocator<T>>
+struct SpeculativeAugmentation {
+  SpeculativeAugmentation() = default;
+
+  explicit SpeculativeAugmentation(const A &alloc) noexcept
+      : touched{alloc}, duals{alloc}, path{alloc} {}
+
+  I row{};
+  I end{};
+  rebind_vector_t<I, A> touched{};
+  rebind_vector_t<std::pair<I, T>, A> duals{};
+  rebind_vector_t<std::tuple<I, I, I>, A> path{};
+};
+
+/** @brief Resizes vec to n elements, constructing new ones from alloc.
+ *
+ * Unlike resize, the elements do not need to be allocator-aware for their
+ * buffers to come from the allocator of the workspace.
+ */
+template <typename Vector, typename A>
+void resize_with_allocator(Vector &vec, std::size_t n, const A &alloc) {
+  if (vec.size() > n) {
+    vec.erase(vec.begin() + static_cast<std::ptrdiff_t>(n), vec.end());
+  }
+  while (vec.size() < n) {
+    vec.emplace_back(alloc);
+  }
+}
+
+/** @brief Statistics policy S, on the allocator of the workspace if it takes
+ * one that converts from A.
+ */
+template <typename S, typename A> S make_stats(const A &alloc) {
+  if constexpr (std::is_constructible_v<S, const A &>) {
+    return S(alloc);
+  } else {
+    return S{};
+  }
+}
+
+} // namespace internal
+
+/** @brief Owns all buffers needed by LAPJVsp.
+ *
+ * A workspace can be reused across any number of solves. Buffers are only
+ * ever grown, so once a workspace has seen the largest problem of a sequence
+ * further solves do not touch the heap. The index type I of the assignment
+ * and search state can be narrowed to 32 bits for problems with less than
+ * 2^31 rows, columns and non-zeros. The statistics policy S receives the
+ * hooks of the solver, SolverStats records the last solve into stats while
+ * the default NoSolverStats compiles the hooks away. All buffers are
+ * allocated by A, rebound to their element type, so a
+ * std::pmr::polymorphic_allocator places them in one memory resource. This
+ * includes the buffers of stats if its allocator converts from A.
+ */
+template <typename T, typename I = Eigen::Index, typename S = NoSolverStats,
+          typename A = std::allocator<T>>
+struct SparseJonkerVolgenantWorkspace {
+  SparseJonkerVolgenantWorkspace() = default;
+
+  explicit SparseJonkerVolgenantWorkspace(const A &alloc) noexcept
+      : csr{alloc}, v{alloc}, u{alloc}, d{alloc}, x{alloc}, y{alloc},
+        free{alloc}, todo{alloc}, lab{alloc}, lab_edge{alloc}, y_edge{alloc},
+        ok{alloc}, xinv{alloc}, match{alloc}, touched{alloc}, heap{alloc},
+        matching{alloc}, searches{alloc}, speculations{alloc}, stamp{alloc},
+        stats{internal::make_stats<S>(alloc)} {}
+
+  void reset(Eigen::Index nr, Eigen::Index nc);
+
+  /** @brief Allocator of the buffers, for results that should share it.
+   */
+  [[nodiscard]] A get_allocator() const noexcept {
+    return A(v.get_allocator());
+  }
+
+  using allocator_type = A;
+
+  CompressedSparseRowMatrix<T, I, A> csr{};
+  internal::rebind_vector_t<T, A> v{};
+  internal::rebind_vector_t<T, A> u{};
+  internal::rebind_vector_t<T, A> d{};
+  internal::rebind_vector_t<I, A> x{};
+  internal::rebind_vector_t<I, A> y{};
+  internal::rebind_vector_t<I, A> free{};
+  internal::rebind_vector_t<I, A> todo{};
+  internal::rebind_vector_t<I, A> lab{};
+  internal::rebind_vector_t<I, A> lab_edge{};
+  internal::rebind_vector_t<I, A> y_edge{};
+  internal::rebind_vector_t<bool, A> ok{};
+  internal::rebind_vector_t<bool, A> xinv{};
+  internal::rebind_vector_t<I, A> match{};
+  internal::rebind_vector_t<I, A> touched{};
+  internal::rebind_vector_t<std::pair<T, I>, A> heap{};
+  HopcroftKarpWorkspace<T, A> matching{};
+  std::unique_ptr<ThreadPool> pool{};
+  internal::rebind_vector_t<internal::SpeculativeSearch<T, I, A>, A>
+      searches{};
+  internal::rebind_vector_t<internal::SpeculativeAugmentation<T, I, A>, A>
+      speculations{};
+  internal::rebind_vector_t<I, A> stamp{};
+  S stats{};
+
+  // Number of free rows left to the shortest augmenting path phase.
+  Eigen::Index augmentations{};
+  // Number of speculative searches of the Parallel augmentation that were
+  // redone sequentially because an earlier commit changed their tree.
+  Eigen::Index conflicts{};
+};
+
+template <typename T, typename I, typename S, typename A>
+void SparseJonkerVolgenantWorkspace<T, I, S, A>::reset(Eigen::Index nr,
+                                                       Eigen::Index nc) {
+  v.assign(nc, T{0});
+  x.assign(nr, I{-1});
+  y.assign(nc, I{-1});
+  u.assign(nr, T{0});
+  d.assign(nc, T{0});
+  ok.assign(nc, false);
+  xinv.assign(nr, false);
+  free.assign(nr, I{-1});
+  todo.assign(nc, I{-1});
+  lab.assign(nc, I{0});
+  lab_edge.assign(nc, I{-1});
+  y_edge.assign(nc, I{-1});
+  augmentations = 0;
+  conflicts = 0;
+  stats.reset();
+}
+
+} // namespace asap
+
+#endif
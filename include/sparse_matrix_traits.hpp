@@ -6,14 +6,26 @@
 
 namespace asap {
 
+namespace internal {
+
+template <typename T, int Options>
+struct is_sparse_matrix : std::false_type {};
+
+template <typename Scalar, int Options>
+struct is_sparse_matrix<Eigen::SparseMatrix<Scalar, Options>, Options>
+    : std::true_type {};
+
+} // namespace internal
+
 template <typename T>
 static constexpr auto is_row_major_v =
-    std::is_same_v<std::decay_t<T>,
-                   Eigen::SparseMatrix<typename T::Scalar, Eigen::RowMajor>>;
+    internal::is_sparse_matrix<std::decay_t<T>, Eigen::RowMajor>::value;
 template <typename T>
 static constexpr auto is_col_major_v =
-    std::is_same_v<std::decay_t<T>,
-                   Eigen::SparseMatrix<typename T::Scalar, Eigen::ColMajor>>;
+    internal::is_sparse_matrix<std::decay_t<T>, Eigen::ColMajor>::value;
+template <typename T>
+static constexpr auto is_sparse_matrix_v =
+    is_row_major_v<T> || is_col_major_v<T>;
 
 } // namespace asap
 
@@ -0,0 +1,174 @@
+#ifndef ASAP_THREAD_POOL_HPP
+#define ASAP_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace asap {
+
+/** @brief Fixed-size pool of threads executing parallel loops.
+ *
+ * The calling thread takes part in every loop, so a pool of size n starts
+ * n - 1 worker threads and a pool of size 1 runs everything inline. Loop
+ * bodies are passed by reference and dispatched without allocating, which
+ * keeps repeated loops free of heap allocations.
+ */
+class ThreadPool {
+public:
+  explicit ThreadPool(std::size_t num_threads);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /** @brief Number of threads taking part in a loop, including the caller.
+   */
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  /** @brief Calls f(begin, end, thread) for consecutive chunks of [0, n).
+   *
+   * Chunks hold at most grain indices and are claimed dynamically by the
+   * threads of the pool, so threads that finish early take over remaining
+   * chunks. thread is the index of the executing thread in [0, size()), with
+   * 0 being the caller, and can be used to select per-thread buffers.
+   * Returns once all chunks are processed. f must not throw.
+   */
+  template <typename F>
+  void parallel_for(std::size_t n, std::size_t grain, F &&f);
+
+private:
+  void work(std::size_t thread);
+  void run_chunks(std::size_t thread);
+
+  std::vector<std::thread> workers_{};
+  std::mutex mutex_{};
+  std::condition_variable start_{};
+  std::condition_variable done_{};
+  std::atomic<std::size_t> next_{};
+  std::size_t n_{};
+  std::size_t grain_{};
+  std::size_t busy_{};
+  std::size_t generation_{};
+  bool stop_{};
+  void *task_{};
+  void (*invoke_)(void *, std::size_t, std::size_t, std::size_t){};
+};
+
+inline ThreadPool::ThreadPool(std::size_t num_threads) {
+  const auto num_workers = std::max(num_threads, std::size_t{1}) - 1;
+  workers_.reserve(num_workers);
+  for (std::size_t t = 0; t < num_workers; ++t) {
+    workers_.emplace_back([this, t]() { work(t + 1); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    const auto lock = std::lock_guard<std::mutex>{mutex_};
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+inline std::size_t ThreadPool::size() const noexcept {
+  return workers_.size() + 1;
+}
+
+template <typename F>
+void ThreadPool::parallel_for(std::size_t n, std::size_t grain, F &&f) {
+  grain = std::max(grain, std::size_t{1});
+  if (workers_.empty() || (n <= grain)) {
+    if (n > 0) {
+      f(std::size_t{0}, n, std::size_t{0});
+    }
+    return;
+  }
+
+  using FunctionT = std::remove_reference_t<F>;
+  {
+    const auto lock = std::lock_guard<std::mutex>{mutex_};
+    task_ = const_cast<void *>(static_cast<const void *>(&f));
+    invoke_ = [](void *task, std::size_t begin, std::size_t end,
+                 std::size_t thread) {
+      (*static_cast<FunctionT *>(task))(begin, end, thread);
+    };
+    n_ = n;
+    grain_ = grain;
+    next_.store(0, std::memory_order_relaxed);
+    busy_ = workers_.size();
+    ++generation_;
+  }
+  start_.notify_all();
+
+  run_chunks(0);
+
+  auto lock = std::unique_lock<std::mutex>{mutex_};
+  done_.wait(lock, [this]() { return busy_ == 0; });
+}
+
+inline void ThreadPool::work(std::size_t thread) {
+  auto generation = std::size_t{0};
+  while (true) {
+    {
+      auto lock = std::unique_lock<std::mutex>{mutex_};
+      start_.wait(lock,
+                  [&]() { return stop_ || (generation_ != generation); });
+      if (stop_) {
+        return;
+      }
+      generation = generation_;
+    }
+
+    run_chunks(thread);
+
+    {
+      const auto lock = std::lock_guard<std::mutex>{mutex_};
+      --busy_;
+      if (busy_ == 0) {
+        done_.notify_one();
+      }
+    }
+  }
+}
+
+inline void ThreadPool::run_chunks(std::size_t thread) {
+  while (true) {
+    const auto begin = next_.fetch_add(grain_, std::memory_order_relaxed);
+    if (begin >= n_) {
+      return;
+    }
+    invoke_(task_, begin, std::min(begin + grain_, n_), thread);
+  }
+}
+
+namespace internal {
+
+/** @brief Recreates pool unless it already has num_threads threads.
+ *
+ * A num_threads of 0 selects the number of hardware threads.
+ */
+inline void reset_thread_pool(std::unique_ptr<ThreadPool> &pool,
+                              std::size_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::max(std::thread::hardware_concurrency(), 1U);
+  }
+  if (!pool || (pool->size() != num_threads)) {
+    pool = std::make_unique<ThreadPool>(num_threads);
+  }
+}
+
+} // namespace internal
+
+} // namespace asap
+
+#endif
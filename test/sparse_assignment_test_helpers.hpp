@@ -0,0 +1,66 @@
+#ifndef ASAP_TEST_SPARSE_ASSIGNMENT_TEST_HELPERS_HPP
+#define ASAP_TEST_SPARSE_ASSIGNMENT_TEST_HELPERS_HPP
+
+#include <eigen3/Eigen/SparseCore>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace asap {
+
+namespace test {
+
+/** @brief Seeded random problem with nnz_per_row random entries per row.
+ *
+ * Entries on the diagonal guarantee that a full matching exists. Costs are
+ * integral in [0, 99] or, unless integral is set, real in [0, 100). Costs of
+ * duplicate entries are resolved by keeping the last one.
+ */
+template <typename SparseMatrixT =
+              Eigen::SparseMatrix<double, Eigen::RowMajor>>
+SparseMatrixT make_random_sparse_matrix(Eigen::Index rows, Eigen::Index cols,
+                                        Eigen::Index nnz_per_row,
+                                        unsigned seed, bool integral = true) {
+  auto gen = std::mt19937{seed};
+  auto col_dist = std::uniform_int_distribution<Eigen::Index>{0, cols - 1};
+  auto int_cost_dist = std::uniform_int_distribution<int>{0, 99};
+  auto real_cost_dist = std::uniform_real_distribution<double>{0.0, 100.0};
+  const auto cost = [&]() {
+    return integral ? static_cast<double>(int_cost_dist(gen))
+                    : real_cost_dist(gen);
+  };
+
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index k = 0; k < std::min(rows, cols); ++k) {
+    triplets.emplace_back(k, k, cost());
+  }
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index k = 0; k < nnz_per_row; ++k) {
+      triplets.emplace_back(r, col_dist(gen), cost());
+    }
+  }
+
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](const auto &, const auto &b) { return b; });
+  return sm;
+}
+
+/** @brief Cost of the assignment in res under the costs of sm.
+ */
+template <typename SparseMatrixT, typename ResultT>
+double assignment_cost(const SparseMatrixT &sm, const ResultT &res) {
+  auto cost = 0.0;
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    cost += static_cast<double>(sm.coeff(res.row_idx[k], res.col_idx[k]));
+  }
+  return cost;
+}
+
+} // namespace test
+
+} // namespace asap
+
+#endif
@@ -0,0 +1,156 @@
+#include "../include/compressed_sparse_row_builder.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+std::vector<Eigen::Triplet<double>> make_triplets(Eigen::Index rows,
+                                                  Eigen::Index cols,
+                                                  int seed) {
+  auto gen = std::mt19937{static_cast<std::mt19937::result_type>(seed)};
+  auto cost = std::uniform_int_distribution<int>{1, 30};
+  auto coin = std::uniform_int_distribution<int>{0, 9};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if ((r % cols == c) || (coin(gen) < 3)) {
+        triplets.emplace_back(r, c, cost(gen));
+      }
+    }
+  }
+  std::shuffle(triplets.begin(), triplets.end(), gen);
+  return triplets;
+}
+
+SparseMatrixT make_sparse_matrix(
+    Eigen::Index rows, Eigen::Index cols,
+    const std::vector<Eigen::Triplet<double>> &triplets) {
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+} // namespace
+
+TEST(CompressedSparseRowBuilder, TripletsMatchEigen) {
+  const auto triplets = make_triplets(40, 50, 1);
+  auto expected = asap::CompressedSparseRowMatrix<double>{};
+  expected.assign(make_sparse_matrix(40, 50, triplets));
+
+  auto builder = asap::CompressedSparseRowBuilder<double>{};
+  builder.reset(40, 50);
+  for (const auto &t : triplets) {
+    builder.add(t.row(), t.col(), t.value());
+  }
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  builder.build(csr);
+
+  EXPECT_EQ(csr.rows, 40);
+  EXPECT_EQ(csr.cols, 50);
+  EXPECT_EQ(csr.row_ptr, expected.row_ptr);
+  EXPECT_EQ(csr.col_ind, expected.col_ind);
+  EXPECT_EQ(csr.val, expected.val);
+}
+
+TEST(CompressedSparseRowBuilder, GateTopKAndDuplicates) {
+  auto options = asap::CompressedSparseRowBuilderOptions{};
+  options.gate = 10.0;
+  options.top_k = 2;
+  auto builder =
+      asap::CompressedSparseRowBuilder<double, std::int32_t>{options};
+  builder.reset(3, 5);
+  builder.add(0, 4, 3.0);
+  builder.add(0, 1, 11.0);
+  builder.add(0, 2, 3.0);
+  builder.add(0, 0, 5.0);
+  builder.add(0, 4, 1.0);
+  builder.add(2, 3, 10.0);
+  builder.add(2, 3, 12.0);
+  builder.add(1, 1, 20.0);
+  auto csr = asap::CompressedSparseRowMatrix<double, std::int32_t>{};
+  builder.build(csr);
+
+  EXPECT_EQ(csr.row_ptr, (std::vector<std::int32_t>{0, 2, 2, 3}));
+  EXPECT_EQ(csr.col_ind, (std::vector<std::int32_t>{2, 4, 3}));
+  EXPECT_EQ(csr.val, (std::vector<double>{3.0, 1.0, 10.0}));
+}
+
+TEST(CompressedSparseRowBuilder, CallbackMatchesTriplets) {
+  auto options = asap::CompressedSparseRowBuilderOptions{};
+  options.gate = 25.0;
+  options.top_k = 4;
+  const auto triplets = make_triplets(30, 30, 2);
+
+  auto builder = asap::CompressedSparseRowBuilder<double>{options};
+  builder.reset(30, 30);
+  for (const auto &t : triplets) {
+    builder.add(t.row(), t.col(), t.value());
+  }
+  auto expected = asap::CompressedSparseRowMatrix<double>{};
+  builder.build(expected);
+
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  auto scratch = std::vector<asap::Edge<double, Eigen::Index>>{};
+  asap::build_compressed_sparse_row_matrix(
+      30, 30,
+      [&](Eigen::Index r, const auto &emit) {
+        for (const auto &t : triplets) {
+          if (t.row() == r) {
+            emit(t.col(), t.value());
+          }
+        }
+      },
+      csr, scratch, options);
+
+  EXPECT_EQ(csr.row_ptr, expected.row_ptr);
+  EXPECT_EQ(csr.col_ind, expected.col_ind);
+  EXPECT_EQ(csr.val, expected.val);
+  for (Eigen::Index r = 0; r < csr.rows; ++r) {
+    EXPECT_LE(csr.row_ptr[r + 1] - csr.row_ptr[r], 4);
+  }
+}
+
+TEST(CompressedSparseRowBuilder, ReusesBuffersAcrossBuilds) {
+  auto builder = asap::CompressedSparseRowBuilder<double>{};
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  for (const auto n : {60, 20}) {
+    const auto triplets = make_triplets(n, n, n);
+    builder.reset(n, n);
+    for (const auto &t : triplets) {
+      builder.add(t.row(), t.col(), t.value());
+    }
+    builder.build(csr);
+
+    auto expected = asap::CompressedSparseRowMatrix<double>{};
+    expected.assign(make_sparse_matrix(n, n, triplets));
+    EXPECT_EQ(csr.row_ptr, expected.row_ptr);
+    EXPECT_EQ(csr.col_ind, expected.col_ind);
+    EXPECT_EQ(csr.val, expected.val);
+  }
+}
+
+TEST(CompressedSparseRowBuilder, SolveBuiltMatrix) {
+  const auto triplets = make_triplets(50, 35, 3);
+  const auto sm = make_sparse_matrix(50, 35, triplets);
+
+  auto builder = asap::CompressedSparseRowBuilder<double>{};
+  builder.reset(50, 35);
+  for (const auto &t : triplets) {
+    builder.add(t.row(), t.col(), t.value());
+  }
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  builder.build(csr);
+
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  const auto actual = asap::solve_sparse_assignment_problem(csr.view());
+
+  ASSERT_TRUE(actual.valid);
+  EXPECT_EQ(actual.row_idx, expected.row_idx);
+  EXPECT_EQ(actual.col_idx, expected.col_idx);
+}
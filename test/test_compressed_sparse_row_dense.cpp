@@ -0,0 +1,182 @@
+#include "../include/compressed_sparse_row_builder.hpp"
+#include "../include/compressed_sparse_row_dense.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace {
+
+using RowMajorMatrixT =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+// Small integral costs make ties at the gate and within the top k common.
+Eigen::MatrixXd make_dense(Eigen::Index rows, Eigen::Index cols, int seed) {
+  auto gen = std::mt19937{static_cast<std::mt19937::result_type>(seed)};
+  auto cost = std::uniform_int_distribution<int>{0, 30};
+  auto dense = Eigen::MatrixXd(rows, cols);
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      dense(r, c) = cost(gen);
+    }
+  }
+  return dense;
+}
+
+template <typename T, typename I, typename MatrixT>
+asap::CompressedSparseRowMatrix<T, I>
+build_expected(const MatrixT &dense,
+               const asap::DenseCompressedSparseRowOptions &options) {
+  auto builder_options = asap::CompressedSparseRowBuilderOptions{};
+  builder_options.gate = options.gate;
+  builder_options.top_k = options.top_k;
+  auto csr = asap::CompressedSparseRowMatrix<T, I>{};
+  auto scratch = std::vector<asap::Edge<T, I>>{};
+  asap::build_compressed_sparse_row_matrix(
+      dense.rows(), dense.cols(),
+      [&](Eigen::Index r, const auto &emit) {
+        for (Eigen::Index c = 0; c < dense.cols(); ++c) {
+          emit(c, dense(r, c));
+        }
+      },
+      csr, scratch, builder_options);
+  return csr;
+}
+
+template <typename T, typename I>
+void expect_equal(const asap::CompressedSparseRowMatrix<T, I> &actual,
+                  const asap::CompressedSparseRowMatrix<T, I> &expected) {
+  EXPECT_EQ(actual.rows, expected.rows);
+  EXPECT_EQ(actual.cols, expected.cols);
+  EXPECT_EQ(actual.row_ptr, expected.row_ptr);
+  EXPECT_EQ(actual.col_ind, expected.col_ind);
+  EXPECT_EQ(actual.val, expected.val);
+}
+
+} // namespace
+
+TEST(CompressedSparseRowDense, MatchesCallbackBuilder) {
+  const auto dense = make_dense(150, 70, 1);
+  const auto row_major = RowMajorMatrixT(dense);
+  auto ws = asap::DenseCompressedSparseRowWorkspace<double>{};
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+
+  const auto inf = std::numeric_limits<double>::infinity();
+  for (const auto gate : {inf, 12.0, -1.0}) {
+    for (const auto top_k : {Eigen::Index{0}, Eigen::Index{5}}) {
+      for (const auto vectorize : {false, true}) {
+        for (const auto num_threads : {std::size_t{1}, std::size_t{3}}) {
+          auto options = asap::DenseCompressedSparseRowOptions{};
+          options.gate = gate;
+          options.top_k = top_k;
+          options.vectorize = vectorize;
+          options.num_threads = num_threads;
+          const auto expected =
+              build_expected<double, Eigen::Index>(dense, options);
+
+          asap::build_compressed_sparse_row_matrix(dense, csr, ws, options);
+          expect_equal(csr, expected);
+          asap::build_compressed_sparse_row_matrix(row_major, csr, ws,
+                                                   options);
+          expect_equal(csr, expected);
+        }
+      }
+    }
+  }
+}
+
+TEST(CompressedSparseRowDense, RefsMapsAndExpressions) {
+  const auto dense = make_dense(90, 60, 2);
+  const auto row_major = RowMajorMatrixT(dense);
+  auto options = asap::DenseCompressedSparseRowOptions{};
+  options.gate = 20.0;
+  options.top_k = 7;
+  options.num_threads = 2;
+  const auto block = dense.block(5, 3, 80, 50);
+  const auto expected =
+      build_expected<double, std::int32_t>(block.eval(), options);
+  auto ws = asap::DenseCompressedSparseRowWorkspace<double, std::int32_t>{};
+  auto csr = asap::CompressedSparseRowMatrix<double, std::int32_t>{};
+
+  const auto ref = Eigen::Ref<const Eigen::MatrixXd>(block);
+  asap::build_compressed_sparse_row_matrix(ref, csr, ws, options);
+  expect_equal(csr, expected);
+
+  const auto row_major_ref =
+      Eigen::Ref<const RowMajorMatrixT>(row_major.block(5, 3, 80, 50));
+  asap::build_compressed_sparse_row_matrix(row_major_ref, csr, ws, options);
+  expect_equal(csr, expected);
+
+  const auto map = Eigen::Map<const RowMajorMatrixT, 0, Eigen::OuterStride<>>(
+      row_major.data() + 5 * 60 + 3, 80, 50, Eigen::OuterStride<>(60));
+  asap::build_compressed_sparse_row_matrix(map, csr, ws, options);
+  expect_equal(csr, expected);
+
+  asap::build_compressed_sparse_row_matrix(2.0 * block - block, csr, ws,
+                                           options);
+  expect_equal(csr, expected);
+  asap::build_compressed_sparse_row_matrix(
+      2.0 * row_major_ref - row_major_ref, csr, ws, options);
+  expect_equal(csr, expected);
+}
+
+TEST(CompressedSparseRowDense, IntegerCosts) {
+  auto gen = std::mt19937{3};
+  auto cost = std::uniform_int_distribution<std::int32_t>{-5, 5};
+  auto dense = Eigen::Matrix<std::int32_t, Eigen::Dynamic, Eigen::Dynamic>(
+      40, 45);
+  for (Eigen::Index r = 0; r < dense.rows(); ++r) {
+    for (Eigen::Index c = 0; c < dense.cols(); ++c) {
+      dense(r, c) = cost(gen);
+    }
+  }
+  auto options = asap::DenseCompressedSparseRowOptions{};
+  options.gate = 1.5;
+  options.top_k = 10;
+  auto ws = asap::DenseCompressedSparseRowWorkspace<std::int32_t>{};
+  auto csr = asap::CompressedSparseRowMatrix<std::int32_t>{};
+
+  asap::build_compressed_sparse_row_matrix(dense, csr, ws, options);
+  expect_equal(csr,
+               build_expected<std::int32_t, Eigen::Index>(dense, options));
+}
+
+TEST(CompressedSparseRowDense, ReusesBuffersAcrossConversions) {
+  auto options = asap::DenseCompressedSparseRowOptions{};
+  options.gate = 15.0;
+  options.num_threads = 2;
+  auto ws = asap::DenseCompressedSparseRowWorkspace<double>{};
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  for (const auto n : {300, 20, 0, 120}) {
+    const auto dense = make_dense(n, n + 5, n);
+    asap::build_compressed_sparse_row_matrix(dense, csr, ws, options);
+    expect_equal(csr, build_expected<double, Eigen::Index>(dense, options));
+  }
+}
+
+TEST(CompressedSparseRowDense, SolveConvertedMatrix) {
+  const auto dense = make_dense(60, 80, 4);
+  auto options = asap::DenseCompressedSparseRowOptions{};
+  options.top_k = 8;
+  auto ws = asap::DenseCompressedSparseRowWorkspace<double>{};
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  asap::build_compressed_sparse_row_matrix(dense, csr, ws, options);
+
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < csr.rows; ++r) {
+    for (auto t = csr.row_ptr[r]; t < csr.row_ptr[r + 1]; ++t) {
+      triplets.emplace_back(r, csr.col_ind[t], csr.val[t]);
+    }
+  }
+  auto sm = Eigen::SparseMatrix<double, Eigen::RowMajor>(60, 80);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  const auto actual = asap::solve_sparse_assignment_problem(csr.view());
+
+  ASSERT_TRUE(actual.valid);
+  EXPECT_EQ(actual.row_idx, expected.row_idx);
+  EXPECT_EQ(actual.col_idx, expected.col_idx);
+}
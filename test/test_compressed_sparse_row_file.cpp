@@ -0,0 +1,210 @@
+#include "../include/compressed_sparse_row_file.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <random>
+
+namespace {
+
+template <typename T>
+Eigen::SparseMatrix<T, Eigen::RowMajor> make_random_matrix(Eigen::Index rows,
+                                                           Eigen::Index cols,
+                                                           unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto cost = std::uniform_int_distribution<int>{-20, 50};
+  auto coin = std::uniform_int_distribution<int>{0, 9};
+  auto triplets = std::vector<Eigen::Triplet<T>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if ((r % cols == c) || (coin(gen) < 3)) {
+        triplets.emplace_back(r, c, static_cast<T>(cost(gen)));
+      }
+    }
+  }
+  auto sm = Eigen::SparseMatrix<T, Eigen::RowMajor>(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+std::string temp_path(const std::string &name) {
+  return ::testing::TempDir() + "asap_" + name + ".csr";
+}
+
+/** Overwrites size bytes of the file at path at offset with data.
+ */
+void patch_file(const std::string &path, std::uint64_t offset,
+                const void *data, std::size_t size) {
+  auto fs = std::fstream(path, std::ios::binary | std::ios::in | std::ios::out);
+  fs.seekp(static_cast<std::streamoff>(offset));
+  fs.write(static_cast<const char *>(data),
+           static_cast<std::streamsize>(size));
+}
+
+} // namespace
+
+template <typename T>
+class CompressedSparseRowFileFixture : public testing::Test {};
+
+using FileTypes =
+    ::testing::Types<std::pair<double, Eigen::Index>,
+                     std::pair<float, std::int32_t>,
+                     std::pair<std::int32_t, std::int32_t>,
+                     std::pair<std::int64_t, std::int64_t>>;
+TYPED_TEST_SUITE(CompressedSparseRowFileFixture, FileTypes);
+
+TYPED_TEST(CompressedSparseRowFileFixture, RoundTripsThroughMapping) {
+  using T = typename TypeParam::first_type;
+  using I = typename TypeParam::second_type;
+  const auto sm = make_random_matrix<T>(37, 45, 1U);
+  auto csr = asap::CompressedSparseRowMatrix<T, I>{};
+  csr.assign(sm);
+  const auto path = temp_path("round_trip");
+
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, csr.view()),
+            asap::CompressedSparseRowFileStatus::Ok);
+  auto header = asap::CompressedSparseRowFileHeader{};
+  ASSERT_EQ(asap::read_compressed_sparse_row_file_header(path, header),
+            asap::CompressedSparseRowFileStatus::Ok);
+  EXPECT_EQ(header.value_type, asap::compressed_sparse_row_file_type<T>());
+  EXPECT_EQ(header.index_type, asap::compressed_sparse_row_file_type<I>());
+  EXPECT_EQ(header.nnz, static_cast<std::uint64_t>(sm.nonZeros()));
+
+  auto mapped = asap::MappedCompressedSparseRowMatrix<T, I>{};
+  ASSERT_EQ(mapped.open(path), asap::CompressedSparseRowFileStatus::Ok);
+  const auto view = mapped.view();
+  ASSERT_EQ(view.rows, 37);
+  ASSERT_EQ(view.cols, 45);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.val) % 64, 0U);
+  EXPECT_EQ(std::vector<I>(view.row_ptr, view.row_ptr + 38), csr.row_ptr);
+  EXPECT_EQ(std::vector<I>(view.col_ind, view.col_ind + sm.nonZeros()),
+            csr.col_ind);
+  EXPECT_EQ(std::vector<T>(view.val, view.val + sm.nonZeros()), csr.val);
+}
+
+TEST(CompressedSparseRowFile, SolveMappedMatrix) {
+  const auto sm = make_random_matrix<double>(60, 80, 2U);
+  const auto path = temp_path("solve");
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, sm),
+            asap::CompressedSparseRowFileStatus::Ok);
+
+  auto mapped = asap::MappedCompressedSparseRowMatrix<double, std::int32_t>{};
+  ASSERT_EQ(mapped.open(path), asap::CompressedSparseRowFileStatus::Ok);
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  const auto actual = asap::solve_sparse_assignment_problem(mapped.view());
+
+  ASSERT_TRUE(actual.valid);
+  EXPECT_EQ(actual.row_idx, expected.row_idx);
+  EXPECT_EQ(actual.col_idx, expected.col_idx);
+
+  // Moving transfers the mapping, closing empties the view.
+  auto moved = std::move(mapped);
+  EXPECT_FALSE(mapped.is_open());
+  EXPECT_TRUE(moved.is_open());
+  EXPECT_EQ(moved.view().rows, 60);
+  moved.close();
+  EXPECT_EQ(moved.view().rows, 0);
+}
+
+TEST(CompressedSparseRowFile, RebasesViewOfRowBlock) {
+  const auto sm = make_random_matrix<double>(30, 30, 3U);
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  csr.assign(sm);
+  const auto block = asap::CompressedSparseRowMatrixView<double, Eigen::Index>(
+      csr.val.data(), csr.col_ind.data(), csr.row_ptr.data() + 10, 15, 30);
+  const auto path = temp_path("block");
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, block),
+            asap::CompressedSparseRowFileStatus::Ok);
+
+  auto mapped = asap::MappedCompressedSparseRowMatrix<double>{};
+  ASSERT_EQ(mapped.open(path), asap::CompressedSparseRowFileStatus::Ok);
+  const auto view = mapped.view();
+  const auto expected = Eigen::MatrixXd(sm.middleRows(10, 15));
+  ASSERT_EQ(view.rows, 15);
+  EXPECT_EQ(view.row_ptr[0], 0);
+  auto actual = Eigen::MatrixXd::Zero(15, 30).eval();
+  for (Eigen::Index r = 0; r < view.rows; ++r) {
+    for (auto t = view.row_ptr[r]; t < view.row_ptr[r + 1]; ++t) {
+      actual(r, view.col_ind[t]) = view.val[t];
+    }
+  }
+  EXPECT_EQ(actual, expected);
+}
+
+TEST(CompressedSparseRowFile, RejectsMismatchedOrDamagedFiles) {
+  using Status = asap::CompressedSparseRowFileStatus;
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  csr.assign(make_random_matrix<double>(20, 20, 4U));
+  const auto sm = csr.view();
+  const auto path = temp_path("damaged");
+  auto mapped = asap::MappedCompressedSparseRowMatrix<double>{};
+
+  EXPECT_EQ(mapped.open(temp_path("missing")), Status::OpenFailed);
+
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, sm), Status::Ok);
+  auto as_float = asap::MappedCompressedSparseRowMatrix<float>{};
+  EXPECT_EQ(as_float.open(path), Status::TypeMismatch);
+  auto narrow = asap::MappedCompressedSparseRowMatrix<double, std::int32_t>{};
+  EXPECT_EQ(narrow.open(path), Status::TypeMismatch);
+
+  const auto swapped = std::uint32_t{0x04030201};
+  patch_file(path, 12, &swapped, sizeof(swapped));
+  EXPECT_EQ(mapped.open(path), Status::ByteOrderMismatch);
+
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, sm), Status::Ok);
+  const auto version = std::uint32_t{2};
+  patch_file(path, 8, &version, sizeof(version));
+  EXPECT_EQ(mapped.open(path), Status::UnsupportedVersion);
+
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, sm), Status::Ok);
+  patch_file(path, 0, "CSR", 3);
+  EXPECT_EQ(mapped.open(path), Status::BadMagic);
+  EXPECT_FALSE(mapped.is_open());
+
+  // A column index out of range is only caught by the verification.
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, sm), Status::Ok);
+  auto header = asap::CompressedSparseRowFileHeader{};
+  ASSERT_EQ(asap::read_compressed_sparse_row_file_header(path, header),
+            Status::Ok);
+  const auto col = Eigen::Index{20};
+  patch_file(path, header.col_ind_offset(), &col, sizeof(col));
+  EXPECT_EQ(mapped.open(path), Status::Corrupt);
+  EXPECT_EQ(mapped.open(path, false), Status::Ok);
+
+  // Truncated files are caught from their size.
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, sm), Status::Ok);
+  const auto nnz = header.nnz + 1000;
+  patch_file(path, 40, &nnz, sizeof(nnz));
+  EXPECT_EQ(mapped.open(path, false), Status::Truncated);
+}
+
+TEST(CompressedSparseRowFile, RejectsCountsWhoseSizesOverflow) {
+  using Status = asap::CompressedSparseRowFileStatus;
+  auto csr = asap::CompressedSparseRowMatrix<double, std::int64_t>{};
+  csr.assign(make_random_matrix<double>(4, 4, 5U));
+  const auto path = temp_path("overflow");
+  ASSERT_EQ(asap::write_compressed_sparse_row_file(path, csr.view()),
+            Status::Ok);
+
+  // (rows + 1) * 8 wraps around to 800008 bytes, which the padded file
+  // would hold.
+  const auto rows = (std::uint64_t{1} << 61) + 100000;
+  const auto nnz = std::uint64_t{0};
+  patch_file(path, 24, &rows, sizeof(rows));
+  patch_file(path, 40, &nnz, sizeof(nnz));
+  {
+    auto os = std::ofstream(path, std::ios::binary | std::ios::app);
+    const auto zeros = std::vector<char>(900000, 0);
+    os.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+  }
+  auto header = asap::CompressedSparseRowFileHeader{};
+  ASSERT_EQ(asap::read_compressed_sparse_row_file_header(path, header),
+            Status::Ok);
+  ASSERT_LT(header.file_size(), 900000U);
+
+  auto mapped = asap::MappedCompressedSparseRowMatrix<double, std::int64_t>{};
+  EXPECT_EQ(mapped.open(path, false), Status::Truncated);
+  EXPECT_EQ(mapped.open(path), Status::Truncated);
+  EXPECT_FALSE(mapped.is_open());
+}
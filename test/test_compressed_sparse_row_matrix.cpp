@@ -1,6 +1,8 @@
 #include "../include/compressed_sparse_row_matrix.hpp"
 #include <gtest/gtest.h>
 
+#include <cstdint>
+
 namespace {
 
 TEST(TestCompressedSparseRowMatrix, ScipySquareExample) {
@@ -84,4 +86,71 @@ TEST(TestCompressedSparseRowMatrix, WikipediaExample) {
   EXPECT_EQ(csr.val, expected_val);
 }
 
+TEST(TestCompressedSparseRowMatrix, AssignColMajor) {
+  auto mat = Eigen::SparseMatrix<double, Eigen::ColMajor>(4U, 5U);
+  mat.insert(0U, 0U) = 10.0;
+  mat.insert(0U, 3U) = 12.0;
+  mat.insert(1U, 2U) = 11.0;
+  mat.insert(1U, 4U) = 13.0;
+  mat.insert(2U, 1U) = 16.0;
+  mat.insert(3U, 2U) = 11.0;
+  mat.insert(3U, 4U) = 13.0;
+
+  const auto expected_row_ptr = std::vector<Eigen::Index>{0, 2, 4, 5, 7};
+  const auto expected_col_ind = std::vector<Eigen::Index>{0, 3, 2, 4, 1, 2, 4};
+  const auto expected_val =
+      std::vector<double>{10.0, 12.0, 11.0, 13.0, 16.0, 11.0, 13.0};
+
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  csr.assign(mat);
+
+  EXPECT_EQ(csr.rows, 4);
+  EXPECT_EQ(csr.cols, 5);
+  EXPECT_EQ(csr.row_ptr, expected_row_ptr);
+  EXPECT_EQ(csr.col_ind, expected_col_ind);
+  EXPECT_EQ(csr.val, expected_val);
+}
+
+TEST(TestCompressedSparseRowMatrix, AssignTransposeRowMajor) {
+  auto mat = Eigen::SparseMatrix<double, Eigen::RowMajor>(3U, 2U);
+  mat.insert(0U, 0U) = 1.0;
+  mat.insert(0U, 1U) = 2.0;
+  mat.insert(1U, 0U) = 3.0;
+  mat.insert(2U, 1U) = 4.0;
+
+  const auto expected_row_ptr = std::vector<Eigen::Index>{0, 2, 4};
+  const auto expected_col_ind = std::vector<Eigen::Index>{0, 1, 0, 2};
+  const auto expected_val = std::vector<double>{1.0, 3.0, 2.0, 4.0};
+
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  csr.assign_transpose(mat);
+
+  EXPECT_EQ(csr.rows, 2);
+  EXPECT_EQ(csr.cols, 3);
+  EXPECT_EQ(csr.row_ptr, expected_row_ptr);
+  EXPECT_EQ(csr.col_ind, expected_col_ind);
+  EXPECT_EQ(csr.val, expected_val);
+}
+
+TEST(TestCompressedSparseRowMatrix, AssignTransposeInt32Index) {
+  auto mat = Eigen::SparseMatrix<double, Eigen::RowMajor>(3U, 2U);
+  mat.insert(0U, 0U) = 1.0;
+  mat.insert(0U, 1U) = 2.0;
+  mat.insert(1U, 0U) = 3.0;
+  mat.insert(2U, 1U) = 4.0;
+
+  const auto expected_row_ptr = std::vector<std::int32_t>{0, 2, 4};
+  const auto expected_col_ind = std::vector<std::int32_t>{0, 1, 0, 2};
+  const auto expected_val = std::vector<double>{1.0, 3.0, 2.0, 4.0};
+
+  auto csr = asap::CompressedSparseRowMatrix<double, std::int32_t>{};
+  csr.assign_transpose(mat);
+
+  EXPECT_EQ(csr.rows, 2);
+  EXPECT_EQ(csr.cols, 3);
+  EXPECT_EQ(csr.row_ptr, expected_row_ptr);
+  EXPECT_EQ(csr.col_ind, expected_col_ind);
+  EXPECT_EQ(csr.val, expected_val);
+}
+
 } // namespace
@@ -0,0 +1,73 @@
+#include "../include/compressed_sparse_row_matrix.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+
+Eigen::SparseMatrix<double, Eigen::RowMajor> make_wikipedia_example() {
+  auto mat = Eigen::SparseMatrix<double, Eigen::RowMajor>(4U, 5U);
+  mat.insert(0U, 0U) = 10.0;
+  mat.insert(0U, 3U) = 12.0;
+  mat.insert(1U, 2U) = 11.0;
+  mat.insert(1U, 4U) = 13.0;
+  mat.insert(2U, 1U) = 16.0;
+  mat.insert(3U, 2U) = 11.0;
+  mat.insert(3U, 4U) = 13.0;
+  mat.makeCompressed();
+  return mat;
+}
+
+TEST(TestCompressedSparseRowMatrixView, AliasesEigenSparseMatrix) {
+  const auto mat = make_wikipedia_example();
+
+  const auto csr = asap::CompressedSparseRowMatrixView{mat};
+
+  EXPECT_EQ(csr.val, mat.valuePtr());
+  EXPECT_EQ(csr.col_ind, mat.innerIndexPtr());
+  EXPECT_EQ(csr.row_ptr, mat.outerIndexPtr());
+  EXPECT_EQ(csr.rows, 4);
+  EXPECT_EQ(csr.cols, 5);
+  EXPECT_EQ(csr.row_ptr[csr.rows], 7);
+}
+
+TEST(TestCompressedSparseRowMatrixView, AliasesEigenMap) {
+  const auto val =
+      std::vector<double>{10.0, 12.0, 11.0, 13.0, 16.0, 11.0, 13.0};
+  const auto col_ind = std::vector<int>{0, 3, 2, 4, 1, 2, 4};
+  const auto row_ptr = std::vector<int>{0, 2, 4, 5, 7};
+  using MapT = Eigen::Map<const Eigen::SparseMatrix<double, Eigen::RowMajor>>;
+  const auto map =
+      MapT(4, 5, 7, row_ptr.data(), col_ind.data(), val.data());
+
+  const auto csr = asap::CompressedSparseRowMatrixView{map};
+
+  EXPECT_EQ(csr.val, val.data());
+  EXPECT_EQ(csr.col_ind, col_ind.data());
+  EXPECT_EQ(csr.row_ptr, row_ptr.data());
+  EXPECT_EQ(csr.rows, 4);
+  EXPECT_EQ(csr.cols, 5);
+}
+
+TEST(TestCompressedSparseRowMatrixView, AssignTransposeOfRawPointerView) {
+  const auto val =
+      std::vector<double>{10.0, 12.0, 11.0, 13.0, 16.0, 11.0, 13.0};
+  const auto col_ind = std::vector<Eigen::Index>{0, 3, 2, 4, 1, 2, 4};
+  const auto row_ptr = std::vector<Eigen::Index>{0, 2, 4, 5, 7};
+  const auto view = asap::CompressedSparseRowMatrixView<double, Eigen::Index>{
+      val.data(), col_ind.data(), row_ptr.data(), 4, 5};
+
+  const auto expected_row_ptr = std::vector<Eigen::Index>{0, 1, 2, 4, 5, 7};
+  const auto expected_col_ind = std::vector<Eigen::Index>{0, 2, 1, 3, 0, 1, 3};
+  const auto expected_val =
+      std::vector<double>{10.0, 16.0, 11.0, 11.0, 12.0, 13.0, 13.0};
+
+  auto csr = asap::CompressedSparseRowMatrix<double>{};
+  csr.assign_transpose(view);
+
+  EXPECT_EQ(csr.rows, 5);
+  EXPECT_EQ(csr.cols, 4);
+  EXPECT_EQ(csr.row_ptr, expected_row_ptr);
+  EXPECT_EQ(csr.col_ind, expected_col_ind);
+  EXPECT_EQ(csr.val, expected_val);
+}
+
+} // namespace
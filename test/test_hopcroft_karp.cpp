@@ -0,0 +1,135 @@
+#include "../include/hopcroft_karp.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+SparseMatrixT make_random_pattern(Eigen::Index rows, Eigen::Index cols,
+                                  double density, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto dist = std::bernoulli_distribution{density};
+
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if (dist(gen)) {
+        triplets.emplace_back(r, c, 1.0);
+      }
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+// Simple augmenting path matching as reference for the cardinality.
+Eigen::Index reference_matching_size(const SparseMatrixT &sm) {
+  auto y = std::vector<Eigen::Index>(sm.cols(), -1);
+  auto visited = std::vector<bool>(sm.cols());
+  const auto augment = [&](const auto &self, Eigen::Index r) -> bool {
+    for (SparseMatrixT::InnerIterator it(sm, r); it; ++it) {
+      if (visited[it.col()]) {
+        continue;
+      }
+      visited[it.col()] = true;
+      if ((y[it.col()] == -1) || self(self, y[it.col()])) {
+        y[it.col()] = r;
+        return true;
+      }
+    }
+    return false;
+  };
+  auto size = Eigen::Index{0};
+  for (Eigen::Index r = 0; r < sm.rows(); ++r) {
+    std::fill(visited.begin(), visited.end(), false);
+    size += augment(augment, r) ? 1 : 0;
+  }
+  return size;
+}
+
+void expect_matching(const SparseMatrixT &sm, const asap::Result<> &res) {
+  auto used = std::vector<bool>(sm.cols(), false);
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    EXPECT_NE(sm.coeff(res.row_idx[k], res.col_idx[k]), 0.0);
+    EXPECT_FALSE(used[res.col_idx[k]]);
+    used[res.col_idx[k]] = true;
+    if (k > 0) {
+      EXPECT_LT(res.row_idx[k - 1], res.row_idx[k]);
+    }
+  }
+}
+
+TEST(HopcroftKarp, PerfectMatchingNeedsAugmentation) {
+  // Greedy matches row 0 to column 0 and leaves row 1 to an augmenting path.
+  auto sm = SparseMatrixT(3U, 3U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 1.0;
+  sm.insert(1U, 0U) = 1.0;
+  sm.insert(2U, 1U) = 1.0;
+  sm.insert(2U, 2U) = 1.0;
+  const auto expected_col_idx = std::vector<Eigen::Index>{1, 0, 2};
+
+  const auto res = asap::maximum_cardinality_matching(sm);
+
+  EXPECT_TRUE(res.valid);
+  EXPECT_EQ(res.col_idx, expected_col_idx);
+}
+
+TEST(HopcroftKarp, DeficientMatrix) {
+  auto sm = SparseMatrixT(3U, 3U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 1.0;
+  sm.insert(1U, 0U) = 1.0;
+  sm.insert(2U, 0U) = 1.0;
+
+  const auto res = asap::maximum_cardinality_matching(sm);
+
+  EXPECT_FALSE(res.valid);
+  EXPECT_EQ(res.row_idx.size(), 2U);
+  expect_matching(sm, res);
+}
+
+class HopcroftKarpFixture
+    : public ::testing::TestWithParam<std::tuple<Eigen::Index, Eigen::Index>> {
+};
+
+TEST_P(HopcroftKarpFixture, MatchesReferenceCardinality) {
+  const auto [rows, cols] = GetParam();
+  auto ws = asap::HopcroftKarpWorkspace<double>{};
+  auto res = asap::Result{};
+
+  for (unsigned seed = 0; seed < 20; ++seed) {
+    const auto sm = make_random_pattern(rows, cols, 0.04, seed);
+    const auto expected_size = reference_matching_size(sm);
+
+    asap::maximum_cardinality_matching(sm, ws, res);
+
+    EXPECT_EQ(static_cast<Eigen::Index>(res.row_idx.size()), expected_size);
+    EXPECT_EQ(res.valid, expected_size == std::min(rows, cols));
+    expect_matching(sm, res);
+  }
+}
+
+TEST_P(HopcroftKarpFixture, ColMajorMatchesRowMajor) {
+  const auto [rows, cols] = GetParam();
+  const auto sm = make_random_pattern(rows, cols, 0.04, 7);
+  const auto sm_col_major = Eigen::SparseMatrix<double, Eigen::ColMajor>(sm);
+
+  const auto expected = asap::maximum_cardinality_matching(sm);
+  const auto res = asap::maximum_cardinality_matching(sm_col_major);
+
+  EXPECT_EQ(res.valid, expected.valid);
+  EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+  expect_matching(sm, res);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    HopcroftKarp, HopcroftKarpFixture,
+    ::testing::Values(std::make_tuple(Eigen::Index{100}, Eigen::Index{100}),
+                      std::make_tuple(Eigen::Index{60}, Eigen::Index{100}),
+                      std::make_tuple(Eigen::Index{100}, Eigen::Index{60})));
+
+} // namespace
@@ -0,0 +1,198 @@
+#include "../include/hopcroft_karp.hpp"
+#include "../include/interleaved_compressed_sparse_row_matrix.hpp"
+#include "../include/sparse_assignment_batch.hpp"
+#include "../include/sparse_auction_solver.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_test_helpers.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+
+namespace {
+
+using asap::test::assignment_cost;
+
+Eigen::SparseMatrix<double, Eigen::RowMajor> make_wikipedia_example() {
+  auto mat = Eigen::SparseMatrix<double, Eigen::RowMajor>(4U, 5U);
+  mat.insert(0U, 0U) = 10.0;
+  mat.insert(0U, 3U) = 12.0;
+  mat.insert(1U, 2U) = 11.0;
+  mat.insert(1U, 4U) = 13.0;
+  mat.insert(2U, 1U) = 16.0;
+  mat.insert(3U, 2U) = 11.0;
+  mat.insert(3U, 4U) = 13.0;
+  mat.makeCompressed();
+  return mat;
+}
+
+Eigen::SparseMatrix<double, Eigen::RowMajor>
+make_random_matrix(Eigen::Index rows, Eigen::Index cols, int seed) {
+  auto gen = std::mt19937{static_cast<std::mt19937::result_type>(seed)};
+  auto cost = std::uniform_real_distribution<double>{0.0, 100.0};
+  auto coin = std::uniform_int_distribution<int>{0, 9};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if ((r % cols == c) || (c % rows == r) || (coin(gen) < 2)) {
+        triplets.emplace_back(r, c, cost(gen));
+      }
+    }
+  }
+  auto sm = Eigen::SparseMatrix<double, Eigen::RowMajor>(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+template <typename T, typename I>
+void expect_same_entries(
+    const asap::InterleavedCompressedSparseRowMatrix<T, I> &csr,
+    const Eigen::SparseMatrix<T, Eigen::RowMajor> &sm) {
+  ASSERT_EQ(csr.rows, sm.rows());
+  ASSERT_EQ(csr.cols, sm.cols());
+  ASSERT_EQ(csr.row_ptr.size(), static_cast<std::size_t>(sm.rows() + 1));
+  using InnerIterator =
+      typename Eigen::SparseMatrix<T, Eigen::RowMajor>::InnerIterator;
+  const auto view = csr.view();
+  for (Eigen::Index r = 0; r < sm.rows(); ++r) {
+    auto t = static_cast<Eigen::Index>(view.row_ptr[r]);
+    for (auto it = InnerIterator(sm, r); it; ++it) {
+      ASSERT_LT(t, static_cast<Eigen::Index>(view.row_ptr[r + 1]));
+      EXPECT_EQ(view.col_ind[t], it.index());
+      EXPECT_EQ(view.val[t], it.value());
+      ++t;
+    }
+    EXPECT_EQ(t, static_cast<Eigen::Index>(view.row_ptr[r + 1]));
+  }
+}
+
+} // namespace
+
+TEST(TestInterleavedCompressedSparseRowMatrix, AssignRowMajor) {
+  const auto mat = make_wikipedia_example();
+
+  auto csr = asap::InterleavedCompressedSparseRowMatrix<double>{};
+  csr.assign(mat);
+
+  expect_same_entries(csr, mat);
+}
+
+TEST(TestInterleavedCompressedSparseRowMatrix, AssignColMajor) {
+  const auto mat = make_wikipedia_example();
+
+  auto csr = asap::InterleavedCompressedSparseRowMatrix<double>{};
+  csr.assign(Eigen::SparseMatrix<double, Eigen::ColMajor>(mat));
+
+  expect_same_entries(csr, mat);
+}
+
+TEST(TestInterleavedCompressedSparseRowMatrix, PacksNarrowEdges) {
+  EXPECT_EQ((sizeof(asap::Edge<float, std::int32_t>)), 8U);
+  EXPECT_EQ((sizeof(asap::Edge<double, std::int64_t>)), 16U);
+
+  const auto mat = Eigen::SparseMatrix<float, Eigen::RowMajor>(
+      make_wikipedia_example().cast<float>());
+
+  auto csr = asap::InterleavedCompressedSparseRowMatrix<float, std::int32_t>{};
+  csr.assign(mat);
+
+  expect_same_entries(csr, mat);
+}
+
+TEST(TestInterleavedCompressedSparseRowMatrix, AssignTransposeOfView) {
+  auto csr = asap::InterleavedCompressedSparseRowMatrix<double>{};
+  csr.assign(make_wikipedia_example());
+
+  const auto expected_row_ptr = std::vector<Eigen::Index>{0, 1, 2, 4, 5, 7};
+  const auto expected_col_ind = std::vector<Eigen::Index>{0, 2, 1, 3, 0, 1, 3};
+  const auto expected_val =
+      std::vector<double>{10.0, 16.0, 11.0, 11.0, 12.0, 13.0, 13.0};
+
+  auto transpose = asap::CompressedSparseRowMatrix<double>{};
+  transpose.assign_transpose(csr.view());
+
+  EXPECT_EQ(transpose.rows, 5);
+  EXPECT_EQ(transpose.cols, 4);
+  EXPECT_EQ(transpose.row_ptr, expected_row_ptr);
+  EXPECT_EQ(transpose.col_ind, expected_col_ind);
+  EXPECT_EQ(transpose.val, expected_val);
+}
+
+class InterleavedSolveFixture
+    : public ::testing::TestWithParam<std::pair<Eigen::Index, Eigen::Index>> {
+};
+
+TEST_P(InterleavedSolveFixture, JonkerVolgenantMatchesSeparateArrays) {
+  const auto [rows, cols] = GetParam();
+  const auto sm = make_random_matrix(rows, cols, 3);
+  auto csr = asap::InterleavedCompressedSparseRowMatrix<double>{};
+  csr.assign(sm);
+
+  for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                              asap::AugmentationStrategy::Heap}) {
+    const auto options = asap::SparseJonkerVolgenantOptions{strategy};
+    auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+    const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+    const auto actual =
+        asap::solve_sparse_assignment_problem(csr.view(), ws, options);
+
+    ASSERT_TRUE(expected.valid);
+    ASSERT_TRUE(actual.valid);
+    EXPECT_EQ(actual.row_idx, expected.row_idx);
+    EXPECT_EQ(actual.col_idx, expected.col_idx);
+    EXPECT_EQ(actual.u, expected.u);
+    EXPECT_EQ(actual.v, expected.v);
+
+    const auto resolved =
+        asap::resolve_sparse_assignment_problem(csr.view(), ws, actual);
+    ASSERT_TRUE(resolved.valid);
+    EXPECT_DOUBLE_EQ(assignment_cost(sm, resolved),
+                     assignment_cost(sm, expected));
+  }
+}
+
+TEST_P(InterleavedSolveFixture, AuctionAndMatchingAcceptInterleavedViews) {
+  const auto [rows, cols] = GetParam();
+  const auto sm = make_random_matrix(rows, cols, 5);
+  auto csr = asap::InterleavedCompressedSparseRowMatrix<double>{};
+  csr.assign(sm);
+
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  auto ws = asap::SparseAuctionWorkspace<double>{};
+  const auto actual = asap::solve_sparse_assignment_problem(csr.view(), ws);
+  ASSERT_TRUE(actual.valid);
+  EXPECT_NEAR(assignment_cost(sm, actual), assignment_cost(sm, expected), 1e-6);
+
+  const auto matching = asap::maximum_cardinality_matching(csr.view());
+  EXPECT_TRUE(matching.valid);
+  EXPECT_EQ(matching.row_idx.size(),
+            static_cast<std::size_t>(std::min(rows, cols)));
+}
+
+INSTANTIATE_TEST_SUITE_P(InterleavedSolve, InterleavedSolveFixture,
+                         ::testing::Values(std::make_pair(40, 40),
+                                           std::make_pair(30, 45),
+                                           std::make_pair(45, 30)));
+
+TEST(TestInterleavedCompressedSparseRowMatrix, BatchSolve) {
+  using ViewT =
+      asap::InterleavedCompressedSparseRowMatrixView<double, Eigen::Index>;
+  auto matrices =
+      std::vector<asap::InterleavedCompressedSparseRowMatrix<double>>(4);
+  auto views = std::vector<ViewT>{};
+  auto expected = std::vector<asap::Result<>>{};
+  for (int k = 0; k < 4; ++k) {
+    const auto sm = make_random_matrix(20 + k, 25, k);
+    matrices[k].assign(sm);
+    views.push_back(matrices[k].view());
+    expected.push_back(asap::solve_sparse_assignment_problem(sm));
+  }
+
+  const auto res = asap::solve_sparse_assignment_problems(views);
+
+  ASSERT_EQ(res.size(), expected.size());
+  for (std::size_t k = 0; k < res.size(); ++k) {
+    ASSERT_TRUE(res[k].valid);
+    EXPECT_EQ(res[k].col_idx, expected[k].col_idx);
+  }
+}
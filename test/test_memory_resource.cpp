@@ -0,0 +1,257 @@
+// GCC flags the std::malloc in the counting operator new below once it is
+// inlined into a sized operator delete call.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+#include "../include/memory_resource.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+std::atomic<bool> count_allocations{false};
+std::atomic<std::size_t> allocations{0U};
+
+} // namespace
+
+// The default operator delete releases memory with std::free, which keeps it
+// compatible with this counting replacement.
+void *operator new(std::size_t size) {
+  if (count_allocations) {
+    ++allocations;
+  }
+  if (auto *ptr = std::malloc(size == 0U ? 1U : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+/** Forwards to an upstream resource and counts the allocations it serves.
+ */
+class CountingResource : public std::pmr::memory_resource {
+public:
+  explicit CountingResource(std::pmr::memory_resource *upstream) noexcept
+      : upstream_{upstream} {}
+
+  std::size_t allocations{};
+  std::size_t bytes{};
+
+private:
+  void *do_allocate(std::size_t size, std::size_t alignment) override {
+    ++allocations;
+    bytes += size;
+    return upstream_->allocate(size, alignment);
+  }
+
+  void do_deallocate(void *ptr, std::size_t size,
+                     std::size_t alignment) override {
+    upstream_->deallocate(ptr, size, alignment);
+  }
+
+  [[nodiscard]] bool
+  do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+
+  std::pmr::memory_resource *upstream_;
+};
+
+/** Fails every allocation that silently falls back to the default resource.
+ */
+class NullDefaultResource {
+public:
+  NullDefaultResource() noexcept
+      : previous_{std::pmr::set_default_resource(
+            std::pmr::null_memory_resource())} {}
+  NullDefaultResource(const NullDefaultResource &) = delete;
+  NullDefaultResource &operator=(const NullDefaultResource &) = delete;
+  ~NullDefaultResource() { std::pmr::set_default_resource(previous_); }
+
+private:
+  std::pmr::memory_resource *previous_;
+};
+
+SparseMatrixT make_sparse_matrix(Eigen::Index rows, Eigen::Index cols,
+                                 int seed) {
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (const auto c : {r % cols, (r + 1 + seed) % cols, (3 * r + 7) % cols,
+                         (5 * r + seed) % cols}) {
+      triplets.emplace_back(r, c, 1.0 + ((r * 31 + c * 17 + seed) % 23));
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](double a, double) { return a; });
+  return sm;
+}
+
+template <typename ResultT, typename ExpectedT>
+void expect_equal(const ResultT &actual, const ExpectedT &expected) {
+  ASSERT_EQ(actual.valid, expected.valid);
+  EXPECT_TRUE(std::equal(actual.row_idx.begin(), actual.row_idx.end(),
+                         expected.row_idx.begin(), expected.row_idx.end()));
+  EXPECT_TRUE(std::equal(actual.col_idx.begin(), actual.col_idx.end(),
+                         expected.col_idx.begin(), expected.col_idx.end()));
+  EXPECT_TRUE(std::equal(actual.u.begin(), actual.u.end(),
+                         expected.u.begin(), expected.u.end()));
+  EXPECT_TRUE(std::equal(actual.v.begin(), actual.v.end(),
+                         expected.v.begin(), expected.v.end()));
+}
+
+} // namespace
+
+TEST(MemoryResource, SolveMatchesDefaultAllocator) {
+  auto counting = CountingResource{std::pmr::new_delete_resource()};
+  for (const auto &[rows, cols] :
+       {std::pair{60, 60}, std::pair{40, 70}, std::pair{70, 40}}) {
+    const auto sm = make_sparse_matrix(rows, cols, rows);
+    const auto col_major = Eigen::SparseMatrix<double>(sm);
+    for (const auto augmentation : {asap::AugmentationStrategy::LinearScan,
+                                    asap::AugmentationStrategy::Heap}) {
+      auto options = asap::SparseJonkerVolgenantOptions{};
+      options.augmentation = augmentation;
+      options.check_feasibility = true;
+      options.initialization = asap::InitialAssignment::Matching;
+      const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+      ASSERT_TRUE(expected.valid);
+
+      auto ws = asap::pmr::SparseJonkerVolgenantWorkspace<double>{&counting};
+      auto res = asap::pmr::Result<double>{&counting};
+      asap::solve_sparse_assignment_problem(sm, ws, res, options);
+      expect_equal(res, expected);
+      asap::solve_sparse_assignment_problem(col_major, ws, res, options);
+      expect_equal(res,
+                   asap::solve_sparse_assignment_problem(col_major, options));
+      EXPECT_EQ(res.row_idx.get_allocator().resource(), &counting);
+    }
+  }
+  EXPECT_GT(counting.allocations, 0U);
+}
+
+TEST(MemoryResource, SolveAllocatesOnlyFromResource) {
+  // Tall, so the solve transposes into the CSR buffer of the workspace.
+  const auto sm = make_sparse_matrix(300, 200, 3);
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.augmentation = asap::AugmentationStrategy::Heap;
+  options.check_feasibility = true;
+  options.initialization = asap::InitialAssignment::Matching;
+  const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+
+  alignas(std::max_align_t) static auto buffer =
+      std::array<std::byte, 1 << 18>{};
+  auto arena = std::pmr::monotonic_buffer_resource{
+      buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+  auto counting = CountingResource{&arena};
+  const auto null_default = NullDefaultResource{};
+
+  auto ws = asap::pmr::SparseJonkerVolgenantWorkspace<double, std::int32_t>{
+      &counting};
+  auto res = asap::pmr::Result<double, std::int32_t>{&counting};
+  allocations = 0U;
+  count_allocations = true;
+  asap::solve_sparse_assignment_problem(sm, ws, res, options);
+  count_allocations = false;
+
+  EXPECT_EQ(allocations, 0U);
+  EXPECT_GT(counting.allocations, 0U);
+  expect_equal(res, expected);
+}
+
+TEST(MemoryResource, InstrumentedSolveAllocatesOnlyFromResource) {
+  const auto sm = make_sparse_matrix(200, 240, 9);
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.augmentation = asap::AugmentationStrategy::Heap;
+  const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+
+  auto counting = CountingResource{std::pmr::new_delete_resource()};
+  auto ws = asap::pmr::SparseJonkerVolgenantWorkspace<
+      double, std::int32_t, asap::pmr::SolverStats>{&counting};
+  auto res = asap::pmr::Result<double, std::int32_t>{&counting};
+  {
+    const auto null_default = NullDefaultResource{};
+    allocations = 0U;
+    count_allocations = true;
+    asap::solve_sparse_assignment_problem(sm, ws, res, options);
+    count_allocations = false;
+  }
+
+  EXPECT_EQ(allocations, 0U);
+  expect_equal(res, expected);
+  ASSERT_FALSE(ws.stats.phases.empty());
+  EXPECT_EQ(ws.stats.phases.get_allocator().resource(), &counting);
+  EXPECT_EQ(ws.stats.path_lengths.get_allocator().resource(), &counting);
+}
+
+TEST(MemoryResource, ParallelAugmentationUsesResource) {
+  const auto sm = make_sparse_matrix(400, 450, 5);
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.augmentation = asap::AugmentationStrategy::Parallel;
+  options.num_threads = 3;
+  const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+
+  auto counting = CountingResource{std::pmr::new_delete_resource()};
+  auto ws = asap::pmr::SparseJonkerVolgenantWorkspace<double>{&counting};
+  auto res = asap::pmr::Result<double>{&counting};
+  asap::solve_sparse_assignment_problem(sm, ws, res, options);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+  EXPECT_DOUBLE_EQ(
+      std::accumulate(res.u.begin(), res.u.end(), 0.0) +
+          std::accumulate(res.v.begin(), res.v.end(), 0.0),
+      std::accumulate(expected.u.begin(), expected.u.end(), 0.0) +
+          std::accumulate(expected.v.begin(), expected.v.end(), 0.0));
+  ASSERT_FALSE(ws.searches.empty());
+  EXPECT_EQ(ws.searches.front().d.get_allocator().resource(), &counting);
+  EXPECT_EQ(ws.speculations.front().path.get_allocator().resource(),
+            &counting);
+}
+
+TEST(MemoryResource, ResolveAndMatchingKeepResource) {
+  const auto sm = make_sparse_matrix(80, 90, 7);
+  auto counting = CountingResource{std::pmr::new_delete_resource()};
+  auto ws = asap::pmr::SparseJonkerVolgenantWorkspace<double>{&counting};
+  const auto start = asap::solve_sparse_assignment_problem(sm, ws);
+  EXPECT_EQ(start.u.get_allocator().resource(), &counting);
+
+  auto changed = SparseMatrixT(sm);
+  changed.coeffRef(0, 0) += 5.0;
+  const auto res = asap::resolve_sparse_assignment_problem(changed, ws, start);
+  EXPECT_EQ(res.col_idx.get_allocator().resource(), &counting);
+
+  // Moving the previous frame in reuses its buffers.
+  auto frame = asap::pmr::Result<double>{&counting};
+  frame = start;
+  frame =
+      asap::resolve_sparse_assignment_problem(changed, ws, std::move(frame));
+  EXPECT_EQ(frame.col_idx.get_allocator().resource(), &counting);
+  expect_equal(frame, res);
+
+  auto default_ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  const auto default_start =
+      asap::solve_sparse_assignment_problem(sm, default_ws);
+  expect_equal(start, default_start);
+  expect_equal(res, asap::resolve_sparse_assignment_problem(
+                        changed, default_ws, default_start));
+
+  auto hk = asap::pmr::HopcroftKarpWorkspace<double>{&counting};
+  auto matching = asap::pmr::Result<double>{&counting};
+  asap::maximum_cardinality_matching(sm, hk, matching);
+  EXPECT_TRUE(matching.valid);
+  EXPECT_EQ(hk.x.get_allocator().resource(), &counting);
+}
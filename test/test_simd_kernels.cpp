@@ -0,0 +1,219 @@
+#include "../include/simd_kernels.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace {
+
+using asap::internal::SimdLevel;
+
+// Small integral costs and duals make ties between reduced costs common.
+struct Rows {
+  std::vector<double> cc{};
+  std::vector<double> v{};
+  std::vector<std::int32_t> kk32{};
+  std::vector<std::int64_t> kk64{};
+  std::vector<Eigen::Index> first{};
+};
+
+Rows make_rows(Eigen::Index cols, Eigen::Index max_degree, int seed) {
+  auto gen = std::mt19937{static_cast<std::mt19937::result_type>(seed)};
+  auto cost = std::uniform_int_distribution<int>{0, 7};
+  auto rows = Rows{};
+  rows.v.resize(cols);
+  for (auto &vj : rows.v) {
+    vj = cost(gen);
+  }
+  rows.first.push_back(0);
+  auto perm = std::vector<std::int64_t>(cols);
+  std::iota(perm.begin(), perm.end(), 0);
+  for (Eigen::Index degree = 0; degree <= max_degree; ++degree) {
+    std::shuffle(perm.begin(), perm.end(), gen);
+    for (Eigen::Index k = 0; k < degree; ++k) {
+      rows.kk64.push_back(perm[k]);
+      rows.kk32.push_back(static_cast<std::int32_t>(perm[k]));
+      rows.cc.push_back(cost(gen));
+    }
+    rows.first.push_back(static_cast<Eigen::Index>(rows.cc.size()));
+  }
+  return rows;
+}
+
+std::vector<SimdLevel> supported_levels() {
+  auto levels = std::vector<SimdLevel>{SimdLevel::Scalar};
+  const auto best = asap::internal::detect_simd_level();
+  if (best != SimdLevel::Scalar) {
+    levels.push_back(SimdLevel::Avx2);
+  }
+  if (best == SimdLevel::Avx512) {
+    levels.push_back(SimdLevel::Avx512);
+  }
+  return levels;
+}
+
+template <typename J>
+void expect_two_minima_match(const Rows &rows, const std::vector<J> &kk) {
+  using asap::internal::two_minima;
+  using asap::internal::two_minima_scalar;
+  for (const auto level : supported_levels()) {
+    for (std::size_t r = 0; r + 1 < rows.first.size(); ++r) {
+      const auto expected =
+          two_minima_scalar(rows.cc.data(), kk.data(), rows.v.data(),
+                            rows.first[r], rows.first[r + 1]);
+      const auto actual =
+          two_minima(level, rows.cc.data(), kk.data(), rows.v.data(),
+                     rows.first[r], rows.first[r + 1]);
+      EXPECT_EQ(actual.v0, expected.v0);
+      EXPECT_EQ(actual.v1, expected.v1);
+      EXPECT_EQ(actual.t0, expected.t0);
+      EXPECT_EQ(actual.t1, expected.t1);
+    }
+  }
+}
+
+template <typename J>
+void expect_column_minima_match(const Rows &rows, const std::vector<J> &kk) {
+  using asap::internal::column_minima;
+  using asap::internal::column_minima_scalar;
+  const auto cols = rows.v.size();
+  auto v_expected = std::vector<double>(cols, 4.0);
+  auto y_expected = std::vector<std::int64_t>(cols, -1);
+  for (std::size_t r = 0; r + 1 < rows.first.size(); ++r) {
+    column_minima_scalar(rows.cc.data(), kk.data(), v_expected.data(),
+                         y_expected.data(), static_cast<std::int64_t>(r),
+                         rows.first[r], rows.first[r + 1]);
+  }
+  for (const auto level : supported_levels()) {
+    auto v = std::vector<double>(cols, 4.0);
+    auto y = std::vector<std::int64_t>(cols, -1);
+    for (std::size_t r = 0; r + 1 < rows.first.size(); ++r) {
+      column_minima(level, rows.cc.data(), kk.data(), v.data(), y.data(),
+                    static_cast<std::int64_t>(r), rows.first[r],
+                    rows.first[r + 1]);
+    }
+    EXPECT_EQ(v, v_expected);
+    EXPECT_EQ(y, y_expected);
+  }
+}
+
+template <typename J>
+void expect_gate_row_match(const std::vector<double> &cc, double gate) {
+  using asap::internal::gate_row;
+  using asap::internal::gate_row_scalar;
+  const auto n = static_cast<Eigen::Index>(cc.size());
+  auto kk_expected = std::vector<J>(cc.size());
+  auto out_expected = std::vector<double>(cc.size());
+  const auto m = gate_row_scalar(cc.data(), 0, n, gate, kk_expected.data(),
+                                 out_expected.data());
+  kk_expected.resize(m);
+  out_expected.resize(m);
+  for (const auto level : supported_levels()) {
+    auto kk = std::vector<J>(cc.size());
+    auto out = std::vector<double>(cc.size());
+    ASSERT_EQ(gate_row(level, cc.data(), n, gate, kk.data(), out.data()), m);
+    kk.resize(m);
+    out.resize(m);
+    EXPECT_EQ(kk, kk_expected);
+    EXPECT_EQ(out, out_expected);
+  }
+}
+
+} // namespace
+
+TEST(SimdKernels, TwoMinimaMatchScalar) {
+  for (int seed = 0; seed < 8; ++seed) {
+    const auto rows = make_rows(64, 40, seed);
+    expect_two_minima_match(rows, rows.kk32);
+    expect_two_minima_match(rows, rows.kk64);
+  }
+}
+
+TEST(SimdKernels, TwoMinimaSkipInfiniteReducedCosts) {
+  const auto inf = asap::internal::infinity<double>();
+  const auto rows = Rows{{inf, 1.0, inf, inf, 1.0, inf, inf, inf, inf},
+                         {0.0, 0.0},
+                         {0, 1, 0, 1, 0, 1, 0, 1, 0},
+                         {0, 1, 0, 1, 0, 1, 0, 1, 0},
+                         {0, 9}};
+  const auto m = asap::internal::two_minima_scalar(
+      rows.cc.data(), rows.kk64.data(), rows.v.data(), 0, 9);
+  EXPECT_EQ(m.t0, 1);
+  EXPECT_EQ(m.t1, 4);
+  expect_two_minima_match(rows, rows.kk32);
+  expect_two_minima_match(rows, rows.kk64);
+}
+
+TEST(SimdKernels, ColumnMinimaMatchScalar) {
+  for (int seed = 0; seed < 8; ++seed) {
+    const auto rows = make_rows(64, 40, seed);
+    expect_column_minima_match(rows, rows.kk32);
+    expect_column_minima_match(rows, rows.kk64);
+  }
+}
+
+TEST(SimdKernels, GateRowMatchScalar) {
+  auto gen = std::mt19937{5};
+  auto cost = std::uniform_int_distribution<int>{0, 9};
+  for (Eigen::Index n = 0; n <= 40; ++n) {
+    auto cc = std::vector<double>(n);
+    for (auto &c : cc) {
+      c = cost(gen);
+    }
+    for (const auto gate : {-1.0, 0.0, 3.0, 8.5, 9.0}) {
+      expect_gate_row_match<std::int32_t>(cc, gate);
+      expect_gate_row_match<std::int64_t>(cc, gate);
+    }
+  }
+}
+
+TEST(SimdKernels, GateRowRejectsNaN) {
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  auto cc = std::vector<double>(19, nan);
+  cc[3] = 1.0;
+  cc[17] = 0.0;
+  expect_gate_row_match<std::int64_t>(cc, 1.0);
+  auto kk = std::vector<std::int64_t>(cc.size());
+  auto out = std::vector<double>(cc.size());
+  const auto m = asap::internal::gate_row_scalar(
+      cc.data(), 0, static_cast<Eigen::Index>(cc.size()), 1.0, kk.data(),
+      out.data());
+  ASSERT_EQ(m, 2);
+  EXPECT_EQ(kk[0], 3);
+  EXPECT_EQ(kk[1], 17);
+}
+
+TEST(SimdKernels, SolveSparseAssignmentProblem_VectorizeMatchesScalar) {
+  auto gen = std::mt19937{7};
+  auto cost = std::uniform_int_distribution<int>{1, 20};
+  const auto n = Eigen::Index{300};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < n; ++r) {
+    for (Eigen::Index c = 0; c < n; ++c) {
+      if ((r == c) || (cost(gen) <= 6)) {
+        triplets.emplace_back(r, c, cost(gen));
+      }
+    }
+  }
+  auto sm = Eigen::SparseMatrix<double, Eigen::RowMajor>(n, n);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+
+  auto vectorized = asap::SparseJonkerVolgenantOptions{};
+  auto scalar = asap::SparseJonkerVolgenantOptions{};
+  scalar.vectorize = false;
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto expected = asap::Result{};
+  auto actual = asap::Result{};
+  asap::solve_sparse_assignment_problem(sm, ws, expected, scalar);
+  asap::solve_sparse_assignment_problem(sm, ws, actual, vectorized);
+
+  ASSERT_TRUE(expected.valid);
+  ASSERT_TRUE(actual.valid);
+  EXPECT_EQ(actual.col_idx, expected.col_idx);
+  EXPECT_EQ(actual.u, expected.u);
+  EXPECT_EQ(actual.v, expected.v);
+}
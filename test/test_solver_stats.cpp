@@ -0,0 +1,147 @@
+#include "../include/solver_stats.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+using StatsWorkspaceT =
+    asap::SparseJonkerVolgenantWorkspace<double, Eigen::Index,
+                                         asap::SolverStats>;
+
+SparseMatrixT make_random_matrix(Eigen::Index rows, Eigen::Index cols,
+                                 int seed) {
+  auto gen = std::mt19937{static_cast<std::mt19937::result_type>(seed)};
+  auto cost = std::uniform_int_distribution<int>{1, 50};
+  auto coin = std::uniform_int_distribution<int>{0, 9};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if ((r == c) || (coin(gen) < 2)) {
+        triplets.emplace_back(r, c, cost(gen));
+      }
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+std::vector<asap::SolverPhase> phases_of(const asap::SolverStats &stats) {
+  auto phases = std::vector<asap::SolverPhase>{};
+  for (const auto &p : stats.phases) {
+    phases.push_back(p.phase);
+  }
+  return phases;
+}
+
+} // namespace
+
+static_assert(std::is_empty_v<asap::NoSolverStats>);
+
+TEST(SolverStats, RecordsPhasesOfSquareSolve) {
+  const auto sm = make_random_matrix(200, 200, 1);
+  auto ws = StatsWorkspaceT{};
+  auto res = asap::Result{};
+
+  asap::solve_sparse_assignment_problem(sm, ws, res);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_EQ(res.col_idx, asap::solve_sparse_assignment_problem(sm).col_idx);
+  using asap::SolverPhase;
+  EXPECT_EQ(phases_of(ws.stats),
+            (std::vector<SolverPhase>{SolverPhase::ColumnReduction,
+                                      SolverPhase::ReductionTransfer,
+                                      SolverPhase::AugmentingRowReduction,
+                                      SolverPhase::AugmentingRowReduction,
+                                      SolverPhase::Augmentation}));
+  for (std::size_t k = 1; k < ws.stats.phases.size(); ++k) {
+    EXPECT_GE(ws.stats.phases[k].start, ws.stats.phases[k - 1].start);
+    EXPECT_GE(ws.stats.phases[k].duration, 0.0);
+  }
+  EXPECT_EQ(ws.stats.phases[3].free_rows, ws.augmentations);
+  EXPECT_EQ(ws.stats.phases.back().free_rows, 0);
+  EXPECT_EQ(static_cast<Eigen::Index>(ws.stats.path_lengths.size()),
+            ws.augmentations);
+  for (const auto length : ws.stats.path_lengths) {
+    EXPECT_GE(length, 1);
+  }
+  if (ws.augmentations > 0) {
+    EXPECT_GT(ws.stats.edge_relaxations, 0);
+  }
+}
+
+TEST(SolverStats, RecordsRowReductionOfRectangularSolve) {
+  const auto sm = make_random_matrix(60, 90, 2);
+  for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                              asap::AugmentationStrategy::Heap}) {
+    auto ws = StatsWorkspaceT{};
+    auto res = asap::Result{};
+
+    asap::solve_sparse_assignment_problem(
+        sm, ws, res, asap::SparseJonkerVolgenantOptions{strategy});
+
+    ASSERT_TRUE(res.valid);
+    using asap::SolverPhase;
+    EXPECT_EQ(phases_of(ws.stats),
+              (std::vector<SolverPhase>{SolverPhase::RowReduction,
+                                        SolverPhase::AugmentingRowReduction,
+                                        SolverPhase::AugmentingRowReduction,
+                                        SolverPhase::Augmentation}));
+    EXPECT_LT(ws.stats.phases[0].free_rows, 60);
+    EXPECT_EQ(ws.stats.phases[2].free_rows, ws.augmentations);
+    EXPECT_EQ(static_cast<Eigen::Index>(ws.stats.path_lengths.size()),
+              ws.augmentations);
+    if (ws.augmentations > 0) {
+      EXPECT_GT(ws.stats.edge_relaxations, 0);
+    }
+    if (strategy == asap::AugmentationStrategy::Heap) {
+      EXPECT_GE(ws.stats.min_scans, ws.augmentations);
+    }
+  }
+}
+
+TEST(SolverStats, RecordsFeasibilityAndWarmStart) {
+  const auto sm = make_random_matrix(100, 100, 3);
+  auto ws = StatsWorkspaceT{};
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.check_feasibility = true;
+
+  auto res = asap::solve_sparse_assignment_problem(sm, ws, options);
+  ASSERT_TRUE(res.valid);
+  ASSERT_FALSE(ws.stats.phases.empty());
+  EXPECT_EQ(ws.stats.phases.front().phase, asap::SolverPhase::Feasibility);
+  EXPECT_EQ(ws.stats.phases.front().free_rows, 0);
+
+  res = asap::resolve_sparse_assignment_problem(sm, ws, std::move(res));
+  ASSERT_TRUE(res.valid);
+  ASSERT_FALSE(ws.stats.phases.empty());
+  EXPECT_EQ(ws.stats.phases.front().phase, asap::SolverPhase::WarmStart);
+  EXPECT_EQ(ws.stats.phases.front().free_rows, 0);
+  EXPECT_TRUE(ws.stats.path_lengths.empty());
+}
+
+TEST(SolverStats, WritesChromeTrace) {
+  const auto sm = make_random_matrix(50, 50, 4);
+  auto ws = StatsWorkspaceT{};
+  static_cast<void>(asap::solve_sparse_assignment_problem(sm, ws));
+
+  auto os = std::ostringstream{};
+  asap::write_chrome_trace(os, ws.stats);
+  const auto trace = os.str();
+
+  EXPECT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0U);
+  EXPECT_EQ(trace.substr(trace.size() - 2), "]}");
+  EXPECT_NE(trace.find("\"name\":\"column_reduction\""), std::string::npos);
+  EXPECT_NE(trace.find("\"edge_relaxations\":"), std::string::npos);
+  auto events = std::size_t{0};
+  for (auto pos = trace.find("\"ph\":\"X\""); pos != std::string::npos;
+       pos = trace.find("\"ph\":\"X\"", pos + 1)) {
+    ++events;
+  }
+  EXPECT_EQ(events, ws.stats.phases.size());
+}
@@ -0,0 +1,174 @@
+#include "../include/sparse_assignment_analysis.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+// Gating pattern with up to four entries per row around the diagonal of a
+// rows x cols problem, with unique random costs.
+SparseMatrixT make_gated(Eigen::Index rows, Eigen::Index cols,
+                         unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto cost = std::uniform_real_distribution<double>{0.0, 10.0};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  const auto n = std::max(rows, cols);
+  for (Eigen::Index k = 0; k < n; ++k) {
+    for (const auto d : {0, 1, 3, 7}) {
+      triplets.emplace_back(k % rows, (k + d) % cols, cost(gen));
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](double a, double) { return a; });
+  return sm;
+}
+
+// Same pattern and storage layout, new costs.
+template <typename MatrixT> void refill(MatrixT &sm, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto cost = std::uniform_real_distribution<double>{0.0, 10.0};
+  for (Eigen::Index p = 0; p < sm.data().size(); ++p) {
+    sm.valuePtr()[p] = cost(gen);
+  }
+}
+
+void expect_equal(const asap::Result<> &actual,
+                  const asap::Result<> &expected) {
+  ASSERT_EQ(actual.valid, expected.valid);
+  EXPECT_EQ(actual.row_idx, expected.row_idx);
+  EXPECT_EQ(actual.col_idx, expected.col_idx);
+}
+
+} // namespace
+
+TEST(SparseAssignmentAnalysis, MatchesDirectSolveAcrossValueUpdates) {
+  for (const auto &[rows, cols] :
+       {std::pair{50, 50}, std::pair{40, 65}, std::pair{65, 40}}) {
+    auto sm = make_gated(rows, cols, 1);
+    auto col_major = Eigen::SparseMatrix<double>(sm);
+    auto row_major_analysis = asap::SparseAssignmentAnalysis<double>{};
+    auto col_major_analysis = asap::SparseAssignmentAnalysis<double>{};
+    auto view_analysis = asap::SparseAssignmentAnalysis<double>{};
+    asap::analyze_sparse_assignment_problem(sm, row_major_analysis);
+    asap::analyze_sparse_assignment_problem(col_major, col_major_analysis);
+    asap::analyze_sparse_assignment_problem(
+        asap::CompressedSparseRowMatrixView{sm}, view_analysis);
+    ASSERT_TRUE(row_major_analysis.feasible);
+    ASSERT_TRUE(col_major_analysis.feasible);
+    EXPECT_EQ(row_major_analysis.transposed, rows > cols);
+    EXPECT_EQ(col_major_analysis.transposed, rows >= cols);
+
+    auto res = asap::Result<>{};
+    for (unsigned seed = 2; seed < 6; ++seed) {
+      refill(sm, seed);
+      refill(col_major, seed + 10);
+      const auto expected = asap::solve_sparse_assignment_problem(sm);
+      ASSERT_TRUE(expected.valid);
+
+      asap::solve_sparse_assignment_problem(sm, row_major_analysis, res);
+      expect_equal(res, expected);
+      asap::solve_sparse_assignment_problem(
+          asap::CompressedSparseRowMatrixView{sm}, view_analysis, res);
+      expect_equal(res, expected);
+      asap::solve_sparse_assignment_problem(col_major, col_major_analysis,
+                                            res);
+      expect_equal(res, asap::solve_sparse_assignment_problem(col_major));
+    }
+  }
+}
+
+TEST(SparseAssignmentAnalysis, SolvesComponentsInParallel) {
+  // Three diagonal blocks, the middle one wide.
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  auto gen = std::mt19937{7};
+  auto cost = std::uniform_real_distribution<double>{0.0, 10.0};
+  for (const auto &[row_offset, col_offset, rows, cols] :
+       {std::tuple{0, 0, 20, 20}, std::tuple{20, 20, 15, 25},
+        std::tuple{35, 45, 30, 30}}) {
+    for (auto i = 0; i < rows; ++i) {
+      for (const auto d : {0, 2, 5}) {
+        triplets.emplace_back(row_offset + i, col_offset + (i + d) % cols,
+                              cost(gen));
+      }
+    }
+  }
+  auto sm = SparseMatrixT(65, 80);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+
+  auto analysis = asap::SparseAssignmentAnalysis<double>{};
+  asap::analyze_sparse_assignment_problem(sm, analysis);
+  ASSERT_TRUE(analysis.feasible);
+  EXPECT_EQ(analysis.decomposition.components, 3);
+
+  auto options = asap::SparseAssignmentDecompositionOptions{};
+  options.num_threads = 2;
+  auto res = asap::Result<>{};
+  for (unsigned seed = 1; seed < 4; ++seed) {
+    refill(sm, seed);
+    asap::solve_sparse_assignment_problem(sm, analysis, res, options);
+    expect_equal(res, asap::solve_sparse_assignment_problem(sm));
+  }
+}
+
+TEST(SparseAssignmentAnalysis, SolvesFromValueArray) {
+  auto sm = make_gated(70, 45, 3);
+  auto analysis = asap::SparseAssignmentAnalysis<double>{};
+  asap::analyze_sparse_assignment_problem(sm, analysis);
+  ASSERT_EQ(analysis.values, sm.nonZeros());
+
+  refill(sm, 4);
+  const auto values =
+      Eigen::Map<const Eigen::VectorXd>(sm.valuePtr(), sm.nonZeros());
+  auto res = asap::Result<>{};
+  asap::solve_sparse_assignment_problem(values, analysis, res);
+  expect_equal(res, asap::solve_sparse_assignment_problem(sm));
+
+  asap::solve_sparse_assignment_problem(values.head(10), analysis, res);
+  EXPECT_FALSE(res.valid);
+}
+
+TEST(SparseAssignmentAnalysis, UncompressedStorage) {
+  auto sm = SparseMatrixT(30, 40);
+  sm.reserve(Eigen::VectorXi::Constant(30, 6));
+  for (Eigen::Index r = 0; r < 30; ++r) {
+    for (const auto d : {0, 4, 9}) {
+      sm.insert(r, (r + d) % 40) = 1.0;
+    }
+  }
+  ASSERT_FALSE(sm.isCompressed());
+
+  auto analysis = asap::SparseAssignmentAnalysis<double>{};
+  asap::analyze_sparse_assignment_problem(sm, analysis);
+  ASSERT_TRUE(analysis.feasible);
+  for (unsigned seed = 1; seed < 3; ++seed) {
+    refill(sm, seed);
+    auto res = asap::Result<>{};
+    asap::solve_sparse_assignment_problem(sm, analysis, res);
+    expect_equal(res, asap::solve_sparse_assignment_problem(sm));
+  }
+}
+
+TEST(SparseAssignmentAnalysis, InfeasibleOrMismatchedIsInvalid) {
+  // Rows 0 and 1 compete for column 0 only.
+  auto triplets = std::vector<Eigen::Triplet<double>>{
+      {0, 0, 1.0}, {1, 0, 2.0}, {2, 1, 1.0}, {2, 2, 3.0}};
+  auto sm = SparseMatrixT(3, 3);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+
+  auto analysis = asap::SparseAssignmentAnalysis<double>{};
+  asap::analyze_sparse_assignment_problem(sm, analysis);
+  EXPECT_FALSE(analysis.feasible);
+  auto res = asap::Result<>{};
+  asap::solve_sparse_assignment_problem(sm, analysis, res);
+  EXPECT_FALSE(res.valid);
+
+  const auto other = make_gated(4, 4, 1);
+  asap::solve_sparse_assignment_problem(other, analysis, res);
+  EXPECT_FALSE(res.valid);
+  EXPECT_TRUE(res.row_idx.empty());
+}
@@ -0,0 +1,105 @@
+#include "../include/sparse_assignment_batch.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+SparseMatrixT make_cluster(Eigen::Index rows, Eigen::Index cols,
+                           unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto col_dist = std::uniform_int_distribution<Eigen::Index>{0, cols - 1};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 10.0};
+
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index k = 0; k < std::min(rows, cols); ++k) {
+    triplets.emplace_back(k, k, cost_dist(gen));
+  }
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index k = 0; k < 3; ++k) {
+      triplets.emplace_back(r, col_dist(gen), cost_dist(gen));
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](const auto &, const auto &b) { return b; });
+  return sm;
+}
+
+std::vector<SparseMatrixT> make_clusters(std::size_t n, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto size_dist = std::uniform_int_distribution<Eigen::Index>{1, 80};
+
+  auto clusters = std::vector<SparseMatrixT>{};
+  for (std::size_t k = 0; k < n; ++k) {
+    clusters.push_back(make_cluster(size_dist(gen), size_dist(gen),
+                                    seed + static_cast<unsigned>(k)));
+  }
+  return clusters;
+}
+
+TEST(SparseAssignmentBatch, MatchesSequentialSolves) {
+  const auto clusters = make_clusters(100, 1U);
+  auto options = asap::SparseAssignmentBatchOptions{};
+  options.num_threads = 4;
+
+  const auto res = asap::solve_sparse_assignment_problems(clusters, options);
+
+  ASSERT_EQ(res.size(), clusters.size());
+  for (std::size_t k = 0; k < clusters.size(); ++k) {
+    const auto expected = asap::solve_sparse_assignment_problem(clusters[k]);
+    EXPECT_EQ(res[k].valid, expected.valid);
+    EXPECT_EQ(res[k].row_idx, expected.row_idx);
+    EXPECT_EQ(res[k].col_idx, expected.col_idx);
+  }
+}
+
+TEST(SparseAssignmentBatch, ReusedWorkspaceMatchesFreshSolve) {
+  auto ws = asap::SparseAssignmentBatchWorkspace<double>{};
+  auto res = std::vector<asap::Result<>>{};
+  auto options = asap::SparseAssignmentBatchOptions{};
+  options.num_threads = 3;
+
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    const auto clusters = make_clusters(20 + 10 * seed, seed);
+
+    asap::solve_sparse_assignment_problems(clusters.begin(), clusters.end(),
+                                           ws, res, options);
+
+    ASSERT_EQ(res.size(), clusters.size());
+    for (std::size_t k = 0; k < clusters.size(); ++k) {
+      const auto expected =
+          asap::solve_sparse_assignment_problem(clusters[k]);
+      EXPECT_EQ(res[k].col_idx, expected.col_idx);
+    }
+  }
+}
+
+TEST(SparseAssignmentBatch, BlockCompressedSparseRowMatrix) {
+  // A 2 x 2 and a 3 x 1 block stored back to back in one set of CSR
+  // buffers with block-local column indices.
+  const auto val = std::vector<double>{1.0, 2.0, 2.0, 1.0, 5.0, 1.0, 3.0};
+  const auto col_ind = std::vector<int>{0, 1, 0, 1, 0, 0, 0};
+  const auto row_ptr = std::vector<int>{0, 2, 4, 5, 6, 7};
+  const auto blocks =
+      std::vector<asap::CompressedSparseRowMatrixView<double, int>>{
+          {val.data(), col_ind.data(), row_ptr.data(), 2, 2},
+          {val.data(), col_ind.data(), row_ptr.data() + 2, 3, 1}};
+  const auto expected_row_idx =
+      std::vector<std::vector<Eigen::Index>>{{0, 1}, {1}};
+  const auto expected_col_idx =
+      std::vector<std::vector<Eigen::Index>>{{0, 1}, {0}};
+
+  const auto res = asap::solve_sparse_assignment_problems(blocks);
+
+  ASSERT_EQ(res.size(), blocks.size());
+  for (std::size_t k = 0; k < blocks.size(); ++k) {
+    EXPECT_TRUE(res[k].valid);
+    EXPECT_EQ(res[k].row_idx, expected_row_idx[k]);
+    EXPECT_EQ(res[k].col_idx, expected_col_idx[k]);
+  }
+}
+
+} // namespace
@@ -0,0 +1,154 @@
+#include "../include/sparse_assignment_decomposition.hpp"
+#include "sparse_assignment_test_helpers.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+using asap::test::assignment_cost;
+
+// Scatters n_clusters random feasible clusters over shuffled rows and
+// columns, followed by n_isolated columns without any entry.
+SparseMatrixT make_scattered_clusters(std::size_t n_clusters,
+                                      Eigen::Index n_isolated,
+                                      unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto size_dist = std::uniform_int_distribution<Eigen::Index>{1, 30};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 10.0};
+
+  auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{};
+  auto rows = Eigen::Index{0};
+  auto cols = n_isolated;
+  for (std::size_t k = 0; k < n_clusters; ++k) {
+    const auto r = size_dist(gen);
+    const auto c = r + size_dist(gen) % 3;
+    shapes.emplace_back(r, c);
+    rows += r;
+    cols += c;
+  }
+
+  auto row_perm = std::vector<Eigen::Index>(rows);
+  auto col_perm = std::vector<Eigen::Index>(cols);
+  std::iota(row_perm.begin(), row_perm.end(), 0);
+  std::iota(col_perm.begin(), col_perm.end(), 0);
+  std::shuffle(row_perm.begin(), row_perm.end(), gen);
+  std::shuffle(col_perm.begin(), col_perm.end(), gen);
+
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  auto row_offset = Eigen::Index{0};
+  auto col_offset = Eigen::Index{0};
+  for (const auto &[r, c] : shapes) {
+    auto col_dist = std::uniform_int_distribution<Eigen::Index>{0, c - 1};
+    for (Eigen::Index i = 0; i < r; ++i) {
+      triplets.emplace_back(row_perm[row_offset + i],
+                            col_perm[col_offset + i], cost_dist(gen));
+      for (Eigen::Index k = 0; k < 2; ++k) {
+        triplets.emplace_back(row_perm[row_offset + i],
+                              col_perm[col_offset + col_dist(gen)],
+                              cost_dist(gen));
+      }
+    }
+    row_offset += r;
+    col_offset += c;
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](const auto &, const auto &b) { return b; });
+  return sm;
+}
+
+void expect_duals_certify_optimality(const SparseMatrixT &sm,
+                                     const asap::Result<> &res) {
+  ASSERT_EQ(res.u.size(), static_cast<std::size_t>(sm.rows()));
+  ASSERT_EQ(res.v.size(), static_cast<std::size_t>(sm.cols()));
+  for (Eigen::Index k = 0; k < sm.outerSize(); ++k) {
+    for (SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+      EXPECT_GE(it.value() - res.u[it.row()] - res.v[it.col()], -1e-9);
+    }
+  }
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    const auto r = res.row_idx[k];
+    const auto c = res.col_idx[k];
+    EXPECT_NEAR(sm.coeff(r, c) - res.u[r] - res.v[c], 0.0, 1e-9);
+  }
+}
+
+TEST(SparseAssignmentDecomposition, MatchesMonolithicSolve) {
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    const auto sm = make_scattered_clusters(40, 5, seed);
+
+    auto ws = asap::SparseAssignmentDecompositionWorkspace<double>{};
+    auto res = asap::Result{};
+    asap::solve_sparse_assignment_problem(sm, ws, res);
+    const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+    ASSERT_TRUE(res.valid);
+    EXPECT_GE(ws.components, Eigen::Index{40});
+    EXPECT_EQ(res.row_idx, expected.row_idx);
+    EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected),
+                1e-9);
+    expect_duals_certify_optimality(sm, res);
+  }
+}
+
+TEST(SparseAssignmentDecomposition, TallMatrixMatchesMonolithicSolve) {
+  const auto sm = SparseMatrixT(make_scattered_clusters(30, 0, 7U)
+                                    .transpose());
+
+  const auto res = asap::solve_sparse_assignment_problem(
+      sm, asap::SparseAssignmentDecompositionOptions{});
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected), 1e-9);
+  expect_duals_certify_optimality(sm, res);
+}
+
+TEST(SparseAssignmentDecomposition, MultithreadedMatchesSequential) {
+  const auto sm = make_scattered_clusters(100, 10, 3U);
+  auto options = asap::SparseAssignmentDecompositionOptions{};
+
+  const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+  options.num_threads = 4;
+  const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_EQ(res.row_idx, expected.row_idx);
+  EXPECT_EQ(res.col_idx, expected.col_idx);
+}
+
+TEST(SparseAssignmentDecomposition, InfeasibleComponent) {
+  // Rows 0 and 2 compete for column 1 only, while the remaining component
+  // carries the surplus column.
+  auto sm = SparseMatrixT(3, 4);
+  sm.insert(0, 1) = 1.0;
+  sm.insert(1, 0) = 1.0;
+  sm.insert(1, 2) = 2.0;
+  sm.insert(1, 3) = 3.0;
+  sm.insert(2, 1) = 1.0;
+  sm.makeCompressed();
+
+  auto ws = asap::SparseAssignmentDecompositionWorkspace<double>{};
+  auto res = asap::Result{};
+  asap::solve_sparse_assignment_problem(sm, ws, res);
+
+  EXPECT_FALSE(res.valid);
+  EXPECT_TRUE(res.row_idx.empty());
+  EXPECT_TRUE(res.col_idx.empty());
+}
+
+TEST(SparseAssignmentDecomposition, EmptyRow) {
+  auto sm = SparseMatrixT(2, 2);
+  sm.insert(0, 0) = 1.0;
+  sm.insert(0, 1) = 1.0;
+  sm.makeCompressed();
+
+  const auto res = asap::solve_sparse_assignment_problem(
+      sm, asap::SparseAssignmentDecompositionOptions{});
+
+  EXPECT_FALSE(res.valid);
+}
+
+} // namespace
@@ -0,0 +1,170 @@
+#include "../include/sparse_assignment_k_best.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_test_helpers.hpp"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <set>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+using asap::test::assignment_cost;
+
+SparseMatrixT make_random_matrix(Eigen::Index rows, Eigen::Index cols,
+                                 int density, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto cost = std::uniform_int_distribution<int>{0, 20};
+  auto coin = std::uniform_int_distribution<int>{0, 9};
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      if ((r % cols == c) || (c % rows == r) || (coin(gen) < density)) {
+        triplets.emplace_back(r, c, cost(gen));
+      }
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+/** Costs of all assignments of the smaller side of sm, sorted.
+ */
+std::vector<double> enumerate_costs(const SparseMatrixT &sm) {
+  const auto dense = Eigen::MatrixXd(sm);
+  const auto mask = Eigen::MatrixXd(
+      SparseMatrixT(sm.unaryExpr([](double) { return 1.0; })));
+  const auto transposed = sm.rows() > sm.cols();
+  const auto rows = std::min(sm.rows(), sm.cols());
+  const auto cols = std::max(sm.rows(), sm.cols());
+  const auto entry = [&](Eigen::Index r, Eigen::Index c) {
+    return transposed ? std::make_pair(mask(c, r), dense(c, r))
+                      : std::make_pair(mask(r, c), dense(r, c));
+  };
+
+  auto costs = std::vector<double>{};
+  auto used = std::vector<bool>(cols, false);
+  const auto recurse = [&](const auto &self, Eigen::Index r,
+                           double cost) -> void {
+    if (r == rows) {
+      costs.push_back(cost);
+      return;
+    }
+    for (Eigen::Index c = 0; c < cols; ++c) {
+      const auto [present, value] = entry(r, c);
+      if ((present != 0.0) && !used[c]) {
+        used[c] = true;
+        self(self, r + 1, cost + value);
+        used[c] = false;
+      }
+    }
+  };
+  recurse(recurse, 0, 0.0);
+  std::sort(costs.begin(), costs.end());
+  return costs;
+}
+
+void expect_k_best(const SparseMatrixT &sm, const asap::KBestResult<> &res,
+                   std::size_t k) {
+  const auto expected = enumerate_costs(sm);
+  const auto count = std::min(k, expected.size());
+  ASSERT_EQ(res.costs.size(), count);
+  ASSERT_EQ(res.assignments.size(), count);
+
+  auto seen = std::set<std::vector<Eigen::Index>>{};
+  for (std::size_t n = 0; n < count; ++n) {
+    const auto &a = res.assignments[n];
+    ASSERT_TRUE(a.valid);
+    EXPECT_EQ(a.row_idx.size(),
+              static_cast<std::size_t>(std::min(sm.rows(), sm.cols())));
+    EXPECT_DOUBLE_EQ(res.costs[n], expected[n]);
+    EXPECT_DOUBLE_EQ(assignment_cost(sm, a), res.costs[n]);
+
+    auto key = a.row_idx;
+    key.insert(key.end(), a.col_idx.begin(), a.col_idx.end());
+    EXPECT_TRUE(seen.insert(key).second);
+  }
+}
+
+} // namespace
+
+class KBestFixture
+    : public ::testing::TestWithParam<std::pair<Eigen::Index, Eigen::Index>> {
+};
+
+TEST_P(KBestFixture, MatchesBruteForceEnumeration) {
+  const auto [rows, cols] = GetParam();
+  for (unsigned seed = 0; seed < 8; ++seed) {
+    const auto sm = make_random_matrix(rows, cols, 5, seed);
+    const auto res = asap::solve_k_best_sparse_assignment_problem(sm, 40);
+
+    expect_k_best(sm, res, 40);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(KBest, KBestFixture,
+                         ::testing::Values(std::make_pair(6, 6),
+                                           std::make_pair(4, 7),
+                                           std::make_pair(3, 9),
+                                           std::make_pair(7, 5)));
+
+TEST(KBest, ReturnsAllAssignmentsIfFewerThanK) {
+  const auto sm = make_random_matrix(4, 5, 3, 11U);
+
+  const auto res = asap::solve_k_best_sparse_assignment_problem(sm, 1000);
+
+  EXPECT_LT(res.costs.size(), 1000U);
+  expect_k_best(sm, res, 1000);
+}
+
+TEST(KBest, FirstIsOptimum) {
+  const auto sm = make_random_matrix(60, 80, 1, 5U);
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+  auto ws = asap::SparseAssignmentKBestWorkspace<double>{};
+  auto res = asap::KBestResult<>{};
+  asap::solve_k_best_sparse_assignment_problem(sm, 25, ws, res);
+
+  ASSERT_EQ(res.costs.size(), 25U);
+  EXPECT_DOUBLE_EQ(res.costs[0], assignment_cost(sm, expected));
+  EXPECT_EQ(res.assignments[0].col_idx, expected.col_idx);
+  EXPECT_TRUE(std::is_sorted(res.costs.begin(), res.costs.end()));
+  EXPECT_GE(ws.augmentations, 24);
+
+  // The workspace and result buffers can be reused for a smaller problem.
+  const auto small = make_random_matrix(5, 5, 5, 6U);
+  asap::solve_k_best_sparse_assignment_problem(small, 10, ws, res);
+  expect_k_best(small, res, 10);
+}
+
+TEST(KBest, InfeasibleOrZero) {
+  auto sm = SparseMatrixT(3, 3);
+  sm.insert(0, 0) = 1.0;
+  sm.insert(1, 0) = 1.0;
+  sm.insert(2, 2) = 1.0;
+  sm.makeCompressed();
+
+  EXPECT_TRUE(asap::solve_k_best_sparse_assignment_problem(sm, 5)
+                  .assignments.empty());
+  EXPECT_TRUE(asap::solve_k_best_sparse_assignment_problem(
+                  make_random_matrix(5, 5, 5, 1U), 0)
+                  .costs.empty());
+}
+
+TEST(KBest, IntegerCostsAndNarrowIndex) {
+  const auto sm = make_random_matrix(5, 8, 5, 3U);
+  const auto expected = asap::solve_k_best_sparse_assignment_problem(sm, 30);
+  const auto si = Eigen::SparseMatrix<std::int32_t, Eigen::RowMajor>(
+      sm.cast<std::int32_t>());
+
+  auto ws = asap::SparseAssignmentKBestWorkspace<std::int32_t, std::int32_t>{};
+  auto res = asap::KBestResult<std::int32_t, std::int32_t>{};
+  asap::solve_k_best_sparse_assignment_problem(si, 30, ws, res);
+
+  ASSERT_EQ(res.costs.size(), expected.costs.size());
+  for (std::size_t n = 0; n < res.costs.size(); ++n) {
+    EXPECT_EQ(static_cast<double>(res.costs[n]), expected.costs[n]);
+  }
+}
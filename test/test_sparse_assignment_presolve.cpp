@@ -0,0 +1,185 @@
+#include "../include/sparse_assignment_presolve.hpp"
+#include "sparse_assignment_test_helpers.hpp"
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+using asap::test::assignment_cost;
+
+// Gates a feasible problem with rows <= cols: every row reaches its own
+// column and up to three random ones, a third of the rows only their own
+// column. Every third spare column is reached by a random row. Integral
+// costs produce the ties the pruning has to keep.
+SparseMatrixT make_gated_matrix(Eigen::Index rows, Eigen::Index cols,
+                                bool integral, unsigned seed) {
+  auto gen = std::mt19937{seed};
+  auto col_dist = std::uniform_int_distribution<Eigen::Index>{0, cols - 1};
+  auto degree_dist = std::uniform_int_distribution<int>{0, 5};
+  auto cost_dist = std::uniform_real_distribution<double>{0.0, 10.0};
+  const auto cost = [&]() {
+    return integral ? std::floor(cost_dist(gen)) : cost_dist(gen);
+  };
+
+  auto own = std::vector<Eigen::Index>(cols);
+  std::iota(own.begin(), own.end(), 0);
+  std::shuffle(own.begin(), own.end(), gen);
+
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index i = 0; i < rows; ++i) {
+    triplets.emplace_back(i, own[i], cost());
+    for (auto k = degree_dist(gen) - 2; k > 0; --k) {
+      triplets.emplace_back(i, col_dist(gen), cost());
+    }
+  }
+  for (Eigen::Index j = rows; j < cols; j += 3) {
+    triplets.emplace_back(col_dist(gen) % rows, own[j], cost());
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end(),
+                     [](const auto &, const auto &b) { return b; });
+  return sm;
+}
+
+void expect_duals_certify_optimality(const SparseMatrixT &sm,
+                                     const asap::Result<> &res) {
+  ASSERT_EQ(res.u.size(), static_cast<std::size_t>(sm.rows()));
+  ASSERT_EQ(res.v.size(), static_cast<std::size_t>(sm.cols()));
+  for (Eigen::Index k = 0; k < sm.outerSize(); ++k) {
+    for (SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+      EXPECT_GE(it.value() - res.u[it.row()] - res.v[it.col()], -1e-9);
+    }
+  }
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    const auto r = res.row_idx[k];
+    const auto c = res.col_idx[k];
+    EXPECT_NEAR(sm.coeff(r, c) - res.u[r] - res.v[c], 0.0, 1e-9);
+  }
+}
+
+} // namespace
+
+TEST(SparseAssignmentPresolve, MatchesPlainSolve) {
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {300, 300}, {200, 260}, {100, 400}};
+  auto ws = asap::SparseAssignmentPresolveWorkspace<double>{};
+  auto res = asap::Result{};
+  auto forced = Eigen::Index{0};
+  auto pruned = Eigen::Index{0};
+
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    for (const auto &[rows, cols] : shapes) {
+      for (const auto integral : {false, true}) {
+        const auto sm = make_gated_matrix(rows, cols, integral, seed);
+
+        asap::solve_sparse_assignment_problem(sm, ws, res);
+        const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+        ASSERT_TRUE(expected.valid);
+        ASSERT_TRUE(res.valid);
+        EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+        EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected),
+                    1e-9);
+        expect_duals_certify_optimality(sm, res);
+        EXPECT_LT(ws.reduced_rows, std::min(rows, cols));
+        forced += ws.forced;
+        pruned += ws.pruned;
+      }
+    }
+  }
+  EXPECT_GT(forced, 0);
+  EXPECT_GT(pruned, 0);
+}
+
+TEST(SparseAssignmentPresolve, WithoutPruning) {
+  const auto sm = make_gated_matrix(200, 300, true, 3U);
+  auto options = asap::SparseAssignmentPresolveOptions{};
+  options.prune_dominated = false;
+  auto ws = asap::SparseAssignmentPresolveWorkspace<double>{};
+  auto res = asap::Result{};
+
+  asap::solve_sparse_assignment_problem(sm, ws, res, options);
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_EQ(ws.pruned, 0);
+  EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected), 1e-9);
+  expect_duals_certify_optimality(sm, res);
+}
+
+TEST(SparseAssignmentPresolve, SolvesChainWithoutReducedProblem) {
+  // Row 0 is forced to column 0, which leaves row 1 with column 1 only, and
+  // so on. Columns 3 and 4 are private to row 3, which keeps the cheaper.
+  auto sm = SparseMatrixT(4, 5);
+  sm.insert(0, 0) = 1.0;
+  sm.insert(1, 0) = 0.0;
+  sm.insert(1, 1) = 2.0;
+  sm.insert(2, 1) = 0.0;
+  sm.insert(2, 2) = 3.0;
+  sm.insert(3, 2) = 0.0;
+  sm.insert(3, 3) = 5.0;
+  sm.insert(3, 4) = 4.0;
+  sm.makeCompressed();
+  auto ws = asap::SparseAssignmentPresolveWorkspace<double>{};
+  auto res = asap::Result{};
+
+  asap::solve_sparse_assignment_problem(sm, ws, res);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_EQ(ws.forced, 4);
+  EXPECT_EQ(ws.pruned, 1);
+  EXPECT_EQ(ws.reduced_rows, 0);
+  EXPECT_EQ(res.col_idx, (std::vector<Eigen::Index>{0, 1, 2, 4}));
+  expect_duals_certify_optimality(sm, res);
+}
+
+TEST(SparseAssignmentPresolve, TallMatrix) {
+  const auto sm = make_gated_matrix(180, 240, false, 11U);
+  const auto tall = SparseMatrixT(sm.transpose());
+
+  const auto res = asap::solve_sparse_assignment_problem(
+      tall, asap::SparseAssignmentPresolveOptions{});
+  const auto expected = asap::solve_sparse_assignment_problem(tall);
+
+  ASSERT_TRUE(res.valid);
+  EXPECT_NEAR(assignment_cost(tall, res), assignment_cost(tall, expected),
+              1e-9);
+  expect_duals_certify_optimality(tall, res);
+}
+
+TEST(SparseAssignmentPresolve, Infeasible) {
+  // Rows 0 and 2 are both forced to column 1.
+  auto sm = SparseMatrixT(3, 4);
+  sm.insert(0, 1) = 1.0;
+  sm.insert(1, 0) = 1.0;
+  sm.insert(1, 2) = 2.0;
+  sm.insert(2, 1) = 1.0;
+  sm.makeCompressed();
+  auto ws = asap::SparseAssignmentPresolveWorkspace<double>{};
+  auto res = asap::Result{};
+
+  asap::solve_sparse_assignment_problem(sm, ws, res);
+  EXPECT_FALSE(res.valid);
+  EXPECT_TRUE(res.row_idx.empty());
+
+  // Column 2 of the square problem has no edge.
+  auto square = SparseMatrixT(3, 3);
+  square.insert(0, 0) = 1.0;
+  square.insert(0, 1) = 1.0;
+  square.insert(1, 0) = 1.0;
+  square.insert(1, 1) = 1.0;
+  square.insert(2, 0) = 1.0;
+  square.insert(2, 1) = 1.0;
+  square.makeCompressed();
+
+  asap::solve_sparse_assignment_problem(square, ws, res);
+  EXPECT_FALSE(res.valid);
+
+  // The workspace solves the next problem.
+  const auto feasible = make_gated_matrix(50, 60, false, 1U);
+  asap::solve_sparse_assignment_problem(feasible, ws, res);
+  EXPECT_TRUE(res.valid);
+  expect_duals_certify_optimality(feasible, res);
+}
@@ -0,0 +1,167 @@
+#include "../include/sparse_auction_solver.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_test_helpers.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+using asap::test::assignment_cost;
+
+// Real costs, so the optimal assignment is unique.
+SparseMatrixT make_random_sparse_matrix(Eigen::Index rows, Eigen::Index cols,
+                                        Eigen::Index nnz_per_row,
+                                        unsigned seed) {
+  return asap::test::make_random_sparse_matrix(rows, cols, nnz_per_row, seed,
+                                               false);
+}
+
+class SparseAuctionSolverFixture
+    : public ::testing::TestWithParam<std::tuple<Eigen::Index, Eigen::Index>> {
+};
+
+TEST_P(SparseAuctionSolverFixture, ExactMatchesJonkerVolgenant) {
+  const auto [rows, cols] = GetParam();
+
+  for (unsigned seed = 0; seed < 10; ++seed) {
+    const auto sm = make_random_sparse_matrix(rows, cols, 4, seed);
+    auto options = asap::SparseAuctionOptions{};
+    options.num_threads = 4;
+
+    const auto expected = asap::solve_sparse_assignment_problem(sm);
+    const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+    ASSERT_TRUE(res.valid);
+    EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+    EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected),
+                1e-9);
+  }
+}
+
+TEST_P(SparseAuctionSolverFixture, BoundedIsWithinEpsilonOfOptimum) {
+  const auto [rows, cols] = GetParam();
+
+  for (unsigned seed = 0; seed < 10; ++seed) {
+    const auto sm = make_random_sparse_matrix(rows, cols, 4, seed);
+    auto options = asap::SparseAuctionOptions{};
+    options.num_threads = 4;
+    options.epsilon_final = 0.5;
+    options.exact = false;
+
+    const auto expected = asap::solve_sparse_assignment_problem(sm);
+    const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+    ASSERT_TRUE(res.valid);
+    const auto n = static_cast<double>(res.row_idx.size());
+    EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+    EXPECT_LE(assignment_cost(sm, res),
+              assignment_cost(sm, expected) + n * options.epsilon_final);
+  }
+}
+
+TEST_P(SparseAuctionSolverFixture, DefaultBoundIsOnePercentOfCostRange) {
+  const auto [rows, cols] = GetParam();
+
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    const auto sm = make_random_sparse_matrix(rows, cols, 4, seed);
+    auto options = asap::SparseAuctionOptions{};
+    options.exact = false;
+
+    const auto expected = asap::solve_sparse_assignment_problem(sm);
+    const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+    ASSERT_TRUE(res.valid);
+    const auto *first = sm.valuePtr();
+    const auto *last = first + sm.nonZeros();
+    const auto c_range =
+        *std::max_element(first, last) - *std::min_element(first, last);
+    EXPECT_LE(assignment_cost(sm, res),
+              assignment_cost(sm, expected) + c_range / 100.0 + 1e-9);
+  }
+}
+
+TEST_P(SparseAuctionSolverFixture, ResultDoesNotDependOnThreadCount) {
+  const auto [rows, cols] = GetParam();
+  const auto sm = make_random_sparse_matrix(rows, cols, 4, 42);
+  auto ws = asap::SparseAuctionWorkspace<double>{};
+  auto options = asap::SparseAuctionOptions{};
+  options.exact = false;
+
+  options.num_threads = 1;
+  const auto expected = asap::solve_sparse_assignment_problem(sm, ws, options);
+  options.num_threads = 3;
+  const auto res = asap::solve_sparse_assignment_problem(sm, ws, options);
+
+  EXPECT_EQ(res.row_idx, expected.row_idx);
+  EXPECT_EQ(res.col_idx, expected.col_idx);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparseAuctionSolver, SparseAuctionSolverFixture,
+    ::testing::Values(std::make_tuple(Eigen::Index{500}, Eigen::Index{500}),
+                      std::make_tuple(Eigen::Index{300}, Eigen::Index{500}),
+                      std::make_tuple(Eigen::Index{500}, Eigen::Index{300})));
+
+TEST(SparseAuctionSolver, IntegerCostsMatchJonkerVolgenant) {
+  using IntegerSparseMatrixT =
+      Eigen::SparseMatrix<std::int32_t, Eigen::RowMajor>;
+
+  for (unsigned seed = 0; seed < 5; ++seed) {
+    // Quantized costs spanning most of the supported integer range.
+    const auto sm = IntegerSparseMatrixT(
+        (make_random_sparse_matrix(400, 400, 4, seed) * 1.0e6)
+            .cast<std::int32_t>());
+    auto options = asap::SparseAuctionOptions{};
+    options.num_threads = 2;
+
+    const auto expected = asap::solve_sparse_assignment_problem(sm);
+    const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+    ASSERT_TRUE(res.valid);
+    EXPECT_EQ(assignment_cost(sm, res), assignment_cost(sm, expected));
+  }
+}
+
+TEST(SparseAuctionSolver, InfeasibleMatrix) {
+  auto sm = SparseMatrixT(3U, 3U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 2.0;
+  sm.insert(1U, 0U) = 3.0;
+  sm.insert(2U, 0U) = 4.0;
+  auto options = asap::SparseAuctionOptions{};
+
+  for (const auto exact : {true, false}) {
+    for (const auto check_feasibility : {true, false}) {
+      options.exact = exact;
+      options.check_feasibility = check_feasibility;
+      const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+      EXPECT_FALSE(res.valid);
+      EXPECT_TRUE(res.row_idx.empty());
+      EXPECT_TRUE(res.col_idx.empty());
+    }
+  }
+}
+
+TEST(SparseAuctionSolver, EqualWeightSquareMatrix) {
+  auto sm = SparseMatrixT(3U, 3U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 1.0;
+  sm.insert(0U, 2U) = 1.0;
+  sm.insert(1U, 0U) = 1.0;
+  sm.insert(2U, 1U) = 1.0;
+  const auto expected_col_idx = std::vector<Eigen::Index>{2, 0, 1};
+
+  const auto res =
+      asap::solve_sparse_assignment_problem(sm, asap::SparseAuctionOptions{});
+
+  EXPECT_TRUE(res.valid);
+  EXPECT_EQ(res.col_idx, expected_col_idx);
+}
+
+} // namespace
@@ -1,8 +1,18 @@
 #include "../include/sparse_jonker_volgenant_solver.hpp"
+#include "sparse_assignment_test_helpers.hpp"
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+
 namespace {
 
+using asap::test::assignment_cost;
+using asap::test::make_random_sparse_matrix;
+
 template <typename MatrixType>
 class SparseJonkerVolgenantSolverFixture : public ::testing::Test {
 public:
@@ -89,4 +99,596 @@ TYPED_TEST(SparseJonkerVolgenantSolverFixture,
   EXPECT_EQ(res.col_idx, expected_col_idx);
 }
 
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_HeapAugmentationMatchesLinearScan) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  const auto heap =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Heap};
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {50, 50}, {200, 200}, {40, 120}, {120, 40}};
+
+  for (unsigned seed = 0U; seed < 8U; ++seed) {
+    for (const auto &[rows, cols] : shapes) {
+      const auto sm = make_random_sparse_matrix<SparseMatrixT>(rows, cols, 4,
+                                                               seed);
+
+      const auto expected = asap::solve_sparse_assignment_problem(sm);
+      const auto res = asap::solve_sparse_assignment_problem(sm, heap);
+
+      ASSERT_TRUE(expected.valid);
+      EXPECT_TRUE(res.valid);
+      EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+      EXPECT_DOUBLE_EQ(assignment_cost(sm, res),
+                       assignment_cost(sm, expected));
+    }
+  }
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_HeapAugmentationInfeasibleMatrix) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  auto sm = SparseMatrixT(3U, 3U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 2.0;
+  sm.insert(1U, 0U) = 1.0;
+  sm.insert(2U, 0U) = 3.0;
+
+  const auto res = asap::solve_sparse_assignment_problem(
+      std::move(sm),
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Heap});
+
+  EXPECT_FALSE(res.valid);
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_ParallelAugmentationMatchesHeap) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  const auto heap =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Heap};
+  auto parallel =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Parallel};
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {400, 400}, {1000, 1000}, {300, 700}, {700, 300}};
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto heap_ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto augmentations = Eigen::Index{0};
+
+  for (unsigned seed = 0U; seed < 4U; ++seed) {
+    for (const auto &[rows, cols] : shapes) {
+      for (const auto num_threads : {1U, 3U, 8U}) {
+        const auto sm = make_random_sparse_matrix<SparseMatrixT>(rows, cols,
+                                                                 2, seed);
+        parallel.num_threads = num_threads;
+
+        const auto expected =
+            asap::solve_sparse_assignment_problem(sm, heap_ws, heap);
+        const auto res = asap::solve_sparse_assignment_problem(sm, ws,
+                                                               parallel);
+
+        ASSERT_TRUE(expected.valid);
+        EXPECT_TRUE(res.valid);
+        EXPECT_EQ(ws.augmentations, heap_ws.augmentations);
+        EXPECT_EQ(res.row_idx, expected.row_idx);
+        EXPECT_EQ(res.col_idx, expected.col_idx);
+        EXPECT_EQ(res.u, expected.u);
+        EXPECT_EQ(res.v, expected.v);
+        augmentations += ws.augmentations;
+      }
+    }
+  }
+  EXPECT_GT(augmentations, 0);
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_ParallelAugmentationInfeasibleMatrix) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  auto options =
+      asap::SparseJonkerVolgenantOptions{asap::AugmentationStrategy::Parallel};
+  options.num_threads = 4;
+  auto sm = make_random_sparse_matrix<SparseMatrixT>(300, 300, 2, 1U);
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  auto infeasible = SparseMatrixT(sm);
+  infeasible.prune([](Eigen::Index row, Eigen::Index col, double) {
+    return (row < 200) || (col == 0);
+  });
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+
+  EXPECT_FALSE(
+      asap::solve_sparse_assignment_problem(infeasible, ws, options).valid);
+
+  // The search buffers are restored, so the workspace solves the next problem.
+  const auto res = asap::solve_sparse_assignment_problem(sm, ws, options);
+  ASSERT_TRUE(res.valid);
+  EXPECT_DOUBLE_EQ(assignment_cost(sm, res), assignment_cost(sm, expected));
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_InfeasibleMatrixTerminates) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  // Three rows displace each other from two columns, lowering their duals
+  // without bound in the augmenting row reduction.
+  auto sm = SparseMatrixT(3U, 4U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 2.0;
+  sm.insert(1U, 0U) = 3.0;
+  sm.insert(1U, 1U) = 1.0;
+  sm.insert(2U, 0U) = 2.0;
+  sm.insert(2U, 1U) = 4.0;
+
+  const auto res = asap::solve_sparse_assignment_problem(std::move(sm));
+
+  EXPECT_FALSE(res.valid);
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_FeasibilityCheckInfeasibleMatrix) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  auto sm = SparseMatrixT(3U, 3U);
+  sm.insert(0U, 0U) = 1.0;
+  sm.insert(0U, 1U) = 2.0;
+  sm.insert(1U, 0U) = 1.0;
+  sm.insert(2U, 0U) = 3.0;
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.check_feasibility = true;
+
+  const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+  EXPECT_FALSE(res.valid);
+  EXPECT_TRUE(res.row_idx.empty());
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_MatchingInitialization) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.initialization = asap::InitialAssignment::Matching;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {60, 60}, {40, 90}, {90, 40}};
+
+  for (const auto &[rows, cols] : shapes) {
+    for (unsigned seed = 0; seed < 10; ++seed) {
+      const auto sm =
+          make_random_sparse_matrix<SparseMatrixT>(rows, cols, 3, seed);
+
+      const auto expected = asap::solve_sparse_assignment_problem(sm);
+      const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+      EXPECT_TRUE(res.valid);
+      EXPECT_EQ(res.row_idx, expected.row_idx);
+      EXPECT_DOUBLE_EQ(assignment_cost(sm, res),
+                       assignment_cost(sm, expected));
+    }
+  }
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_DualsCertifyOptimality) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {60, 60}, {40, 90}, {90, 40}};
+
+  for (const auto &[rows, cols] : shapes) {
+    for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                                asap::AugmentationStrategy::Heap,
+                                asap::AugmentationStrategy::Parallel}) {
+      const auto sm =
+          make_random_sparse_matrix<SparseMatrixT>(rows, cols, 3, 5U);
+
+      const auto res = asap::solve_sparse_assignment_problem(
+          sm, asap::SparseJonkerVolgenantOptions{strategy});
+
+      ASSERT_TRUE(res.valid);
+      ASSERT_EQ(res.u.size(), static_cast<std::size_t>(rows));
+      ASSERT_EQ(res.v.size(), static_cast<std::size_t>(cols));
+      for (Eigen::Index k = 0; k < sm.outerSize(); ++k) {
+        for (typename SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+          EXPECT_GE(it.value() - res.u[it.row()] - res.v[it.col()], -1e-9);
+        }
+      }
+      for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+        const auto r = res.row_idx[k];
+        const auto c = res.col_idx[k];
+        EXPECT_NEAR(sm.coeff(r, c) - res.u[r] - res.v[c], 0.0, 1e-9);
+      }
+    }
+  }
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           ResolveSparseAssignmentProblem_SmallChangeMatchesFreshSolve) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {200, 200}, {150, 250}, {250, 150}};
+
+  for (const auto &[rows, cols] : shapes) {
+    auto sm = make_random_sparse_matrix<SparseMatrixT>(rows, cols, 4, 3U);
+    auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+    auto res = asap::solve_sparse_assignment_problem(sm, ws);
+
+    auto gen = std::mt19937{17U};
+    auto delta_dist = std::uniform_real_distribution<double>{-5.0, 5.0};
+    for (int frame = 0; frame < 5; ++frame) {
+      for (Eigen::Index k = 0; k < sm.outerSize(); k += 20) {
+        for (typename SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+          it.valueRef() += delta_dist(gen);
+        }
+      }
+      const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+      res = asap::resolve_sparse_assignment_problem(sm, ws, std::move(res));
+
+      ASSERT_TRUE(res.valid);
+      EXPECT_LT(ws.augmentations, std::min(rows, cols) / 2);
+      EXPECT_EQ(res.row_idx, expected.row_idx);
+      EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected),
+                  1e-9);
+    }
+  }
+}
+
+TEST(SparseJonkerVolgenantSolver,
+     ResolveSparseAssignmentProblem_MismatchedStartSolvesFromScratch) {
+  using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  const auto sm = make_random_sparse_matrix<SparseMatrixT>(50, 50, 3, 9U);
+  const auto other = make_random_sparse_matrix<SparseMatrixT>(40, 50, 3, 9U);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+  const auto res = asap::resolve_sparse_assignment_problem(
+      sm, ws, asap::solve_sparse_assignment_problem(other));
+
+  EXPECT_TRUE(res.valid);
+  EXPECT_DOUBLE_EQ(assignment_cost(sm, res), assignment_cost(sm, expected));
+}
+
+TEST(SparseJonkerVolgenantSolver,
+     ResolveSparseAssignmentProblem_PatternChangeMatchesFreshSolve) {
+  using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  // Negative entries of the dense costs are missing from the pattern.
+  const auto gate = [](const Eigen::MatrixXd &costs) {
+    auto triplets = std::vector<Eigen::Triplet<double>>{};
+    for (Eigen::Index r = 0; r < costs.rows(); ++r) {
+      for (Eigen::Index c = 0; c < costs.cols(); ++c) {
+        if (costs(r, c) >= 0.0) {
+          triplets.emplace_back(r, c, costs(r, c));
+        }
+      }
+    }
+    auto sm = SparseMatrixT(costs.rows(), costs.cols());
+    sm.setFromTriplets(triplets.begin(), triplets.end());
+    return sm;
+  };
+
+  // Rows with a single entry used to leave unbounded duals that made every
+  // entry added to their column unreachable on the next frame.
+  auto frames = std::vector<std::pair<SparseMatrixT, SparseMatrixT>>{};
+  frames.emplace_back(gate((Eigen::MatrixXd(2, 2) << 1, 3, 8, -1).finished()),
+                      gate((Eigen::MatrixXd(2, 2) << 1, 3, 8, 1).finished()));
+  frames.emplace_back(
+      gate((Eigen::MatrixXd(4, 3) << -1, -1, 4, -1, 4, 5, 7, -1, -1, -1, -1, 9)
+               .finished()),
+      gate((Eigen::MatrixXd(4, 3) << -1, -1, 4, 1, 5, 5, 7, 0, -1, -1, -1, 7)
+               .finished()));
+
+  auto gen = std::mt19937{23U};
+  auto size_dist = std::uniform_int_distribution<Eigen::Index>{1, 7};
+  auto cost_dist = std::uniform_int_distribution<int>{-6, 9};
+  for (int k = 0; k < 300; ++k) {
+    const auto rows = size_dist(gen);
+    const auto cols = size_dist(gen);
+    const auto random_costs = [&]() {
+      return Eigen::MatrixXd(Eigen::MatrixXd::NullaryExpr(
+          rows, cols, [&]() { return static_cast<double>(cost_dist(gen)); }));
+    };
+    frames.emplace_back(gate(random_costs()), gate(random_costs()));
+  }
+
+  for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                              asap::AugmentationStrategy::Heap}) {
+    const auto options = asap::SparseJonkerVolgenantOptions{strategy};
+    for (const auto &[first, second] : frames) {
+      auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+      const auto start =
+          asap::solve_sparse_assignment_problem(first, ws, options);
+      for (const auto d : start.u) {
+        EXPECT_LT(std::abs(d), 1e100);
+      }
+      for (const auto d : start.v) {
+        EXPECT_LT(std::abs(d), 1e100);
+      }
+
+      const auto expected =
+          asap::solve_sparse_assignment_problem(second, options);
+      const auto res =
+          asap::resolve_sparse_assignment_problem(second, ws, start, options);
+
+      ASSERT_EQ(res.valid, expected.valid);
+      EXPECT_DOUBLE_EQ(assignment_cost(second, res),
+                       assignment_cost(second, expected));
+    }
+  }
+}
+
+TEST(SparseJonkerVolgenantSolver,
+     ResolveSparseAssignmentProblem_UnboundedStartSolvesFromScratch) {
+  using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  const auto sm = make_random_sparse_matrix<SparseMatrixT>(30, 30, 3, 4U);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto start = asap::solve_sparse_assignment_problem(sm, ws);
+  ASSERT_TRUE(start.valid);
+  start.v[0] = -std::numeric_limits<double>::max();
+
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  const auto res = asap::resolve_sparse_assignment_problem(sm, ws, start);
+
+  EXPECT_TRUE(res.valid);
+  EXPECT_DOUBLE_EQ(assignment_cost(sm, res), assignment_cost(sm, expected));
+  // A start passed as lvalue is left as it was.
+  EXPECT_EQ(start.v[0], -std::numeric_limits<double>::max());
+}
+
+TEST(SparseJonkerVolgenantSolver,
+     SolveSparseAssignmentProblem_CompressedSparseRowMatrixView) {
+  using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {60, 60}, {40, 90}, {90, 40}};
+
+  for (const auto &[rows, cols] : shapes) {
+    const auto sm =
+        make_random_sparse_matrix<SparseMatrixT>(rows, cols, 3, 7U);
+    const auto expected = asap::solve_sparse_assignment_problem(
+        static_cast<Eigen::SparseMatrix<double, Eigen::ColMajor>>(sm));
+
+    const auto map = Eigen::Map<const SparseMatrixT>(
+        sm.rows(), sm.cols(), sm.nonZeros(), sm.outerIndexPtr(),
+        sm.innerIndexPtr(), sm.valuePtr());
+
+    const auto res = asap::solve_sparse_assignment_problem(
+        asap::CompressedSparseRowMatrixView{map});
+
+    EXPECT_TRUE(res.valid);
+    EXPECT_EQ(res.row_idx, expected.row_idx);
+    EXPECT_DOUBLE_EQ(assignment_cost(sm, res), assignment_cost(sm, expected));
+  }
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_Int32IndexMatchesDefaultIndex) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {70, 70}, {50, 90}, {90, 50}};
+
+  for (const auto &[rows, cols] : shapes) {
+    for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                                asap::AugmentationStrategy::Heap}) {
+      const auto sm =
+          make_random_sparse_matrix<SparseMatrixT>(rows, cols, 3, 19U);
+      const auto options = asap::SparseJonkerVolgenantOptions{strategy};
+      const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+
+      auto ws = asap::SparseJonkerVolgenantWorkspace<double, std::int32_t>{};
+      auto res = asap::Result<double, std::int32_t>{};
+      asap::solve_sparse_assignment_problem(sm, ws, res, options);
+
+      ASSERT_TRUE(res.valid);
+      EXPECT_TRUE(std::equal(res.row_idx.begin(), res.row_idx.end(),
+                             expected.row_idx.begin(),
+                             expected.row_idx.end()));
+      EXPECT_TRUE(std::equal(res.col_idx.begin(), res.col_idx.end(),
+                             expected.col_idx.begin(),
+                             expected.col_idx.end()));
+      EXPECT_EQ(res.u, expected.u);
+      EXPECT_EQ(res.v, expected.v);
+
+      res = asap::resolve_sparse_assignment_problem(sm, ws, std::move(res),
+                                                    options);
+      ASSERT_TRUE(res.valid);
+      EXPECT_DOUBLE_EQ(assignment_cost(sm, res),
+                       assignment_cost(sm, expected));
+    }
+  }
+}
+
+TEST(SparseJonkerVolgenantSolver,
+     SolveSparseAssignmentProblem_ColMajorMatchesRowMajor) {
+  using RowMajorSparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+  using ColMajorSparseMatrixT = Eigen::SparseMatrix<double, Eigen::ColMajor>;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {60, 60}, {40, 90}, {90, 40}};
+
+  for (const auto &[rows, cols] : shapes) {
+    const auto sm =
+        make_random_sparse_matrix<RowMajorSparseMatrixT>(rows, cols, 3, 11U);
+    const auto expected = asap::solve_sparse_assignment_problem(sm);
+
+    const auto res =
+        asap::solve_sparse_assignment_problem(ColMajorSparseMatrixT(sm));
+
+    EXPECT_TRUE(res.valid);
+    EXPECT_EQ(res.row_idx.size(), expected.row_idx.size());
+    EXPECT_TRUE(std::is_sorted(res.row_idx.begin(), res.row_idx.end()));
+    EXPECT_DOUBLE_EQ(assignment_cost(sm, res), assignment_cost(sm, expected));
+  }
+}
+
+TYPED_TEST(SparseJonkerVolgenantSolverFixture,
+           SolveSparseAssignmentProblem_RectangularMatchesPaddedSquare) {
+  using SparseMatrixT = typename TestFixture::Type;
+
+  // Padding a rectangular problem with zero cost rows that reach every column
+  // gives a square problem with the same optimal cost, which is solved by the
+  // column reduction of the square initialization.
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {50, 55}, {40, 80}, {20, 200}, {80, 40}};
+
+  for (const auto &[rows, cols] : shapes) {
+    const auto sm = make_random_sparse_matrix<SparseMatrixT>(
+        rows, cols, 4, static_cast<unsigned>(rows + cols));
+    const auto n = std::max(rows, cols);
+    auto triplets = std::vector<Eigen::Triplet<double>>{};
+    for (Eigen::Index k = 0; k < sm.outerSize(); ++k) {
+      for (typename SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+        triplets.emplace_back(it.row(), it.col(), it.value());
+      }
+    }
+    for (Eigen::Index a = std::min(rows, cols); a < n; ++a) {
+      for (Eigen::Index b = 0; b < n; ++b) {
+        if (rows < cols) {
+          triplets.emplace_back(a, b, 0.0);
+        } else {
+          triplets.emplace_back(b, a, 0.0);
+        }
+      }
+    }
+    auto padded = SparseMatrixT(n, n);
+    padded.setFromTriplets(triplets.begin(), triplets.end());
+    const auto expected = asap::solve_sparse_assignment_problem(padded);
+    ASSERT_TRUE(expected.valid);
+
+    for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                                asap::AugmentationStrategy::Heap}) {
+      const auto res = asap::solve_sparse_assignment_problem(
+          sm, asap::SparseJonkerVolgenantOptions{strategy});
+
+      ASSERT_TRUE(res.valid);
+      ASSERT_EQ(static_cast<Eigen::Index>(res.row_idx.size()),
+                std::min(rows, cols));
+      EXPECT_DOUBLE_EQ(assignment_cost(sm, res),
+                       assignment_cost(padded, expected));
+
+      // Reduced costs are non-negative and the unassigned side keeps the
+      // maximal dual.
+      for (Eigen::Index k = 0; k < sm.outerSize(); ++k) {
+        for (typename SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+          EXPECT_GE(it.value() - res.u[it.row()] - res.v[it.col()], -1e-9);
+        }
+      }
+      const auto &duals = (rows < cols) ? res.v : res.u;
+      auto assigned = std::vector<bool>(duals.size(), false);
+      for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+        assigned[(rows < cols) ? res.col_idx[k] : res.row_idx[k]] = true;
+      }
+      const auto max_dual = *std::max_element(duals.begin(), duals.end());
+      for (std::size_t k = 0; k < duals.size(); ++k) {
+        if (!assigned[k]) {
+          EXPECT_EQ(duals[k], max_dual);
+        }
+      }
+    }
+  }
+}
+
+template <typename CostType>
+class SparseJonkerVolgenantCostTypeFixture : public ::testing::Test {
+public:
+  using Type = CostType;
+};
+
+using CostTypes = ::testing::Types<std::int32_t, std::int64_t, float>;
+TYPED_TEST_SUITE(SparseJonkerVolgenantCostTypeFixture, CostTypes);
+
+TYPED_TEST(SparseJonkerVolgenantCostTypeFixture,
+           SolveSparseAssignmentProblem_MatchesDoubleCosts) {
+  using CostT = typename TestFixture::Type;
+  using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  const auto shapes = std::vector<std::pair<Eigen::Index, Eigen::Index>>{
+      {80, 80}, {50, 110}, {110, 50}};
+
+  for (const auto &[rows, cols] : shapes) {
+    for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                                asap::AugmentationStrategy::Heap}) {
+      const auto sm =
+          make_random_sparse_matrix<SparseMatrixT>(rows, cols, 3, 13U);
+      const auto options = asap::SparseJonkerVolgenantOptions{strategy};
+      const auto expected = asap::solve_sparse_assignment_problem(sm, options);
+
+      const auto res = asap::solve_sparse_assignment_problem(
+          Eigen::SparseMatrix<CostT, Eigen::RowMajor>(
+              sm.template cast<CostT>()),
+          options);
+
+      ASSERT_TRUE(res.valid);
+      EXPECT_EQ(res.row_idx, expected.row_idx);
+      EXPECT_DOUBLE_EQ(assignment_cost(sm, res),
+                       assignment_cost(sm, expected));
+    }
+  }
+}
+
+TYPED_TEST(SparseJonkerVolgenantCostTypeFixture,
+           SolveSparseAssignmentProblem_SingleEntryRowsDoNotOverflow) {
+  using CostT = typename TestFixture::Type;
+  using SparseMatrixT = Eigen::SparseMatrix<CostT, Eigen::RowMajor>;
+
+  // Rows with a single entry let the reduction transfer subtract INF from
+  // a column dual, which must stay representable for negative costs.
+  const auto big = CostT(std::numeric_limits<CostT>::is_integer
+                             ? std::numeric_limits<std::int32_t>::max() / 16
+                             : 1.0e6);
+  auto sm = SparseMatrixT(4, 4);
+  sm.insert(0, 0) = -big;
+  sm.insert(1, 1) = big;
+  sm.insert(2, 1) = -big;
+  sm.insert(2, 2) = CostT(-1);
+  sm.insert(3, 2) = big;
+  sm.insert(3, 3) = -big;
+  sm.makeCompressed();
+  const auto expected_col_idx = std::vector<Eigen::Index>{0, 1, 2, 3};
+
+  for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                              asap::AugmentationStrategy::Heap}) {
+    const auto res = asap::solve_sparse_assignment_problem(
+        sm, asap::SparseJonkerVolgenantOptions{strategy});
+
+    ASSERT_TRUE(res.valid);
+    EXPECT_EQ(res.col_idx, expected_col_idx);
+  }
+}
+
+TEST(SparseJonkerVolgenantSolver, SolveSparseAssignmentProblem_Epsilon) {
+  using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+  // Perturbing integer costs by far less than epsilon must not change the
+  // optimal cost by more than rows * epsilon.
+  const auto rows = Eigen::Index{120};
+  auto sm = make_random_sparse_matrix<SparseMatrixT>(rows, rows, 4, 17U);
+  const auto expected = asap::solve_sparse_assignment_problem(sm);
+  auto gen = std::mt19937{17U};
+  auto noise_dist = std::uniform_real_distribution<double>{-1e-12, 1e-12};
+  for (Eigen::Index k = 0; k < sm.outerSize(); ++k) {
+    for (SparseMatrixT::InnerIterator it(sm, k); it; ++it) {
+      it.valueRef() += noise_dist(gen);
+    }
+  }
+  auto options = asap::SparseJonkerVolgenantOptions{};
+  options.epsilon = 1e-9;
+
+  for (const auto strategy : {asap::AugmentationStrategy::LinearScan,
+                              asap::AugmentationStrategy::Heap}) {
+    options.augmentation = strategy;
+    const auto res = asap::solve_sparse_assignment_problem(sm, options);
+
+    ASSERT_TRUE(res.valid);
+    EXPECT_NEAR(assignment_cost(sm, res), assignment_cost(sm, expected),
+                static_cast<double>(rows) * 1e-9);
+  }
+}
+
 } // namespace
@@ -0,0 +1,128 @@
+// GCC flags the std::malloc in the counting operator new below once it is
+// inlined into a sized operator delete call.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<bool> count_allocations{false};
+std::atomic<std::size_t> allocations{0U};
+
+} // namespace
+
+// The default operator delete releases memory with std::free, which keeps it
+// compatible with this counting replacement.
+void *operator new(std::size_t size) {
+  if (count_allocations) {
+    ++allocations;
+  }
+  if (auto *ptr = std::malloc(size == 0U ? 1U : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+namespace {
+
+using SparseMatrixT = Eigen::SparseMatrix<double, Eigen::RowMajor>;
+
+SparseMatrixT make_sparse_matrix(Eigen::Index rows, Eigen::Index cols,
+                                 int seed) {
+  auto triplets = std::vector<Eigen::Triplet<double>>{};
+  for (Eigen::Index r = 0; r < rows; ++r) {
+    auto cs = std::vector<Eigen::Index>{r % cols, (r + 1 + seed) % cols,
+                                        (3 * r + 7) % cols};
+    std::sort(cs.begin(), cs.end());
+    cs.erase(std::unique(cs.begin(), cs.end()), cs.end());
+    for (const auto c : cs) {
+      triplets.emplace_back(r, c, 1.0 + ((r * 31 + c * 17 + seed) % 23));
+    }
+  }
+  auto sm = SparseMatrixT(rows, cols);
+  sm.setFromTriplets(triplets.begin(), triplets.end());
+  return sm;
+}
+
+class SparseJonkerVolgenantWorkspaceFixture
+    : public ::testing::TestWithParam<std::pair<Eigen::Index, Eigen::Index>> {
+};
+
+TEST_P(SparseJonkerVolgenantWorkspaceFixture,
+       SolveSparseAssignmentProblem_SteadyStateDoesNotAllocate) {
+  const auto [rows, cols] = GetParam();
+  const auto large = make_sparse_matrix(rows, cols, 0);
+  const auto small = make_sparse_matrix(rows / 2, cols / 2, 1);
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  asap::solve_sparse_assignment_problem(large, ws, res);
+  ASSERT_TRUE(res.valid);
+
+  allocations = 0U;
+  count_allocations = true;
+  asap::solve_sparse_assignment_problem(large, ws, res);
+  asap::solve_sparse_assignment_problem(small, ws, res);
+  asap::solve_sparse_assignment_problem(large, ws, res);
+  count_allocations = false;
+
+  EXPECT_TRUE(res.valid);
+  EXPECT_EQ(allocations, 0U);
+}
+
+TEST_P(SparseJonkerVolgenantWorkspaceFixture,
+       SolveSparseAssignmentProblem_ColMajorSteadyStateDoesNotAllocate) {
+  using ColMajorSparseMatrixT = Eigen::SparseMatrix<double, Eigen::ColMajor>;
+
+  const auto [rows, cols] = GetParam();
+  const auto large =
+      ColMajorSparseMatrixT(make_sparse_matrix(rows, cols, 0));
+  const auto small =
+      ColMajorSparseMatrixT(make_sparse_matrix(rows / 2, cols / 2, 1));
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+  auto res = asap::Result{};
+
+  asap::solve_sparse_assignment_problem(large, ws, res);
+  ASSERT_TRUE(res.valid);
+
+  allocations = 0U;
+  count_allocations = true;
+  asap::solve_sparse_assignment_problem(large, ws, res);
+  asap::solve_sparse_assignment_problem(small, ws, res);
+  asap::solve_sparse_assignment_problem(large, ws, res);
+  count_allocations = false;
+
+  EXPECT_TRUE(res.valid);
+  EXPECT_EQ(allocations, 0U);
+}
+
+TEST_P(SparseJonkerVolgenantWorkspaceFixture,
+       SolveSparseAssignmentProblem_ReusedWorkspaceMatchesFreshSolve) {
+  const auto [rows, cols] = GetParam();
+  auto ws = asap::SparseJonkerVolgenantWorkspace<double>{};
+
+  for (int seed = 0; seed < 4; ++seed) {
+    auto sm = make_sparse_matrix(rows - seed, cols - seed, seed);
+    const auto reused = asap::solve_sparse_assignment_problem(sm, ws);
+    const auto fresh = asap::solve_sparse_assignment_problem(std::move(sm));
+
+    EXPECT_EQ(reused.valid, fresh.valid);
+    EXPECT_EQ(reused.row_idx, fresh.row_idx);
+    EXPECT_EQ(reused.col_idx, fresh.col_idx);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    SparseJonkerVolgenantWorkspace, SparseJonkerVolgenantWorkspaceFixture,
+    ::testing::Values(std::make_pair(Eigen::Index{40}, Eigen::Index{40}),
+                      std::make_pair(Eigen::Index{30}, Eigen::Index{50}),
+                      std::make_pair(Eigen::Index{50}, Eigen::Index{30})));
+
+} // namespace
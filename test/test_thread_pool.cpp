@@ -0,0 +1,62 @@
+#include "../include/thread_pool.hpp"
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace {
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+  auto pool = asap::ThreadPool{4};
+  auto visits = std::vector<int>(1000, 0);
+  auto threads = std::vector<std::size_t>(1000, 0);
+
+  pool.parallel_for(
+      visits.size(), 7,
+      [&](std::size_t begin, std::size_t end, std::size_t thread) {
+        for (auto k = begin; k < end; ++k) {
+          ++visits[k];
+          threads[k] = thread;
+        }
+      });
+
+  EXPECT_EQ(pool.size(), 4U);
+  EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), 1000);
+  EXPECT_LT(*std::max_element(threads.begin(), threads.end()), pool.size());
+}
+
+TEST(ThreadPool, RepeatedLoopsAccumulate) {
+  auto pool = asap::ThreadPool{3};
+  auto sums = std::vector<std::size_t>(64, 0);
+
+  for (int round = 0; round < 100; ++round) {
+    pool.parallel_for(sums.size(), 1,
+                      [&](std::size_t begin, std::size_t end, std::size_t) {
+                        for (auto k = begin; k < end; ++k) {
+                          sums[k] += k;
+                        }
+                      });
+  }
+
+  for (std::size_t k = 0; k < sums.size(); ++k) {
+    EXPECT_EQ(sums[k], 100 * k);
+  }
+}
+
+TEST(ThreadPool, SingleThreadRunsInline) {
+  auto pool = asap::ThreadPool{0};
+  auto calls = 0;
+
+  pool.parallel_for(10, 1,
+                    [&](std::size_t begin, std::size_t end,
+                        std::size_t thread) {
+                      EXPECT_EQ(begin, 0U);
+                      EXPECT_EQ(end, 10U);
+                      EXPECT_EQ(thread, 0U);
+                      ++calls;
+                    });
+
+  EXPECT_EQ(pool.size(), 1U);
+  EXPECT_EQ(calls, 1);
+}
+
+} // namespace
@@ -0,0 +1,250 @@
+#include "../include/compressed_sparse_row_file.hpp"
+#include "../include/sparse_jonker_volgenant_solver.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+constexpr auto usage =
+    "usage: asap_solve [options] <matrix.csr>\n"
+    "\n"
+    "Solves the sparse assignment problem of a CSR file and writes one\n"
+    "'row col' line per assigned row.\n"
+    "\n"
+    "options:\n"
+    "  -o, --output <file>  write the assignment to file, default stdout\n"
+    "  --heap               use the heap augmentation\n"
+    "  --threads <n>        use the parallel augmentation on n threads,\n"
+    "                       0 for all hardware threads\n"
+    "  --matching           start from a maximum cardinality matching\n"
+    "  --check-feasibility  reject infeasible problems before solving\n"
+    "  --epsilon <eps>      tie tolerance of floating point costs\n"
+    "  --no-verify          skip the index checks of the file\n"
+    "  --stats              print timings and solver phases to stderr\n"
+    "  --trace <file>       write a Chrome trace of the solve to file\n"
+    "  -h, --help           print this message\n";
+
+struct Arguments {
+  std::string input{};
+  std::string output{};
+  std::string trace{};
+  asap::SparseJonkerVolgenantOptions options{};
+  bool verify{true};
+  bool stats{false};
+};
+
+enum ExitCode { Solved = 0, Usage = 1, BadFile = 2, Infeasible = 3 };
+
+// Unsigned decimal number that fills all of s and fits into n.
+bool parse_count(const char *s, std::size_t &n) {
+  if (!std::isdigit(static_cast<unsigned char>(*s))) {
+    return false;
+  }
+  auto *end = static_cast<char *>(nullptr);
+  errno = 0;
+  const auto value = std::strtoull(s, &end, 10);
+  if ((errno != 0) || (*end != '\0') ||
+      (value > std::numeric_limits<std::size_t>::max())) {
+    return false;
+  }
+  n = static_cast<std::size_t>(value);
+  return true;
+}
+
+// Finite non-negative number that fills all of s.
+bool parse_tolerance(const char *s, double &eps) {
+  auto *end = static_cast<char *>(nullptr);
+  errno = 0;
+  const auto value = std::strtod(s, &end);
+  if ((end == s) || (errno != 0) || (*end != '\0') || !std::isfinite(value) ||
+      (value < 0.0)) {
+    return false;
+  }
+  eps = value;
+  return true;
+}
+
+bool parse_arguments(int argc, char **argv, Arguments &args) {
+  for (auto i = 1; i < argc; ++i) {
+    const auto arg = std::string{argv[i]};
+    const auto has_value = i + 1 < argc;
+    if ((arg == "-o" || arg == "--output") && has_value) {
+      args.output = argv[++i];
+    } else if (arg == "--heap") {
+      args.options.augmentation = asap::AugmentationStrategy::Heap;
+    } else if (arg == "--threads" && has_value) {
+      args.options.augmentation = asap::AugmentationStrategy::Parallel;
+      if (!parse_count(argv[++i], args.options.num_threads)) {
+        return false;
+      }
+    } else if (arg == "--matching") {
+      args.options.initialization = asap::InitialAssignment::Matching;
+    } else if (arg == "--check-feasibility") {
+      args.options.check_feasibility = true;
+    } else if (arg == "--epsilon" && has_value) {
+      if (!parse_tolerance(argv[++i], args.options.epsilon)) {
+        return false;
+      }
+    } else if (arg == "--no-verify") {
+      args.verify = false;
+    } else if (arg == "--stats") {
+      args.stats = true;
+    } else if (arg == "--trace" && has_value) {
+      args.trace = argv[++i];
+    } else if (!arg.empty() && arg[0] != '-' && args.input.empty()) {
+      args.input = arg;
+    } else {
+      return false;
+    }
+  }
+  return !args.input.empty();
+}
+
+double milliseconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+template <typename T, typename I>
+void write_assignment(std::ostream &os, const asap::Result<T, I> &res) {
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    os << res.row_idx[k] << ' ' << res.col_idx[k] << '\n';
+  }
+}
+
+template <typename T, typename I>
+void write_stats(std::ostream &os, const asap::Result<T, I> &res,
+                 const asap::CompressedSparseRowMatrixView<T, I> &csr,
+                 const asap::SolverStats &stats, double load, double solve) {
+  auto cost = 0.0;
+  for (std::size_t k = 0; k < res.row_idx.size(); ++k) {
+    const auto *first = csr.col_ind + csr.row_ptr[res.row_idx[k]];
+    const auto *last = csr.col_ind + csr.row_ptr[res.row_idx[k] + 1];
+    cost += static_cast<double>(
+        csr.val[std::find(first, last, res.col_idx[k]) - csr.col_ind]);
+  }
+  os << "rows " << csr.rows << ", cols " << csr.cols << ", nnz "
+     << csr.row_ptr[csr.rows] << '\n'
+     << "load " << load << " ms\n"
+     << "solve " << solve << " ms\n";
+  for (const auto &p : stats.phases) {
+    os << "  " << asap::to_string(p.phase) << ' ' << p.duration / 1000.0
+       << " ms, " << p.free_rows << " free rows\n";
+  }
+  os << "augmenting paths " << stats.path_lengths.size()
+     << ", edge relaxations " << stats.edge_relaxations << ", min scans "
+     << stats.min_scans << '\n'
+     << "assigned " << res.row_idx.size() << ", cost " << cost << '\n';
+}
+
+template <typename T, typename I, typename S>
+int solve(const Arguments &args) {
+  const auto start = std::chrono::steady_clock::now();
+  auto mapped = asap::MappedCompressedSparseRowMatrix<T, I>{};
+  const auto status = mapped.open(args.input, args.verify);
+  if (status != asap::CompressedSparseRowFileStatus::Ok) {
+    std::cerr << "asap_solve: cannot map " << args.input << ": "
+              << asap::to_string(status) << '\n';
+    return BadFile;
+  }
+  const auto csr = mapped.view();
+  const auto load = milliseconds_since(start);
+
+  auto ws = asap::SparseJonkerVolgenantWorkspace<T, I, S>{};
+  auto res = asap::Result<T, I>{};
+  const auto solve_start = std::chrono::steady_clock::now();
+  asap::solve_sparse_assignment_problem(csr, ws, res, args.options);
+  const auto solve = milliseconds_since(solve_start);
+
+  if (!res.valid) {
+    std::cerr << "asap_solve: " << args.input << " is infeasible\n";
+    return Infeasible;
+  }
+  if (args.output.empty()) {
+    write_assignment(std::cout, res);
+  } else {
+    auto os = std::ofstream(args.output);
+    write_assignment(os, res);
+    if (!os) {
+      std::cerr << "asap_solve: cannot write " << args.output << '\n';
+      return BadFile;
+    }
+  }
+  if constexpr (std::is_same_v<S, asap::SolverStats>) {
+    if (args.stats) {
+      write_stats(std::cerr, res, csr, ws.stats, load, solve);
+    }
+    if (!args.trace.empty()) {
+      auto os = std::ofstream(args.trace);
+      asap::write_chrome_trace(os, ws.stats);
+      if (!os) {
+        std::cerr << "asap_solve: cannot write " << args.trace << '\n';
+        return BadFile;
+      }
+    }
+  }
+  return Solved;
+}
+
+// Solver statistics are only collected if they are printed or traced.
+template <typename T, typename I> int solve(const Arguments &args) {
+  if (args.stats || !args.trace.empty()) {
+    return solve<T, I, asap::SolverStats>(args);
+  }
+  return solve<T, I, asap::NoSolverStats>(args);
+}
+
+template <typename T> int solve(const Arguments &args, bool narrow) {
+  return narrow ? solve<T, std::int32_t>(args) : solve<T, std::int64_t>(args);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::ios::sync_with_stdio(false);
+
+  auto args = Arguments{};
+  if (!parse_arguments(argc, argv, args)) {
+    std::cerr << usage;
+    return Usage;
+  }
+
+  auto header = asap::CompressedSparseRowFileHeader{};
+  const auto status =
+      asap::read_compressed_sparse_row_file_header(args.input, header);
+  if (status != asap::CompressedSparseRowFileStatus::Ok) {
+    std::cerr << "asap_solve: cannot read " << args.input << ": "
+              << asap::to_string(status) << '\n';
+    return BadFile;
+  }
+
+  const auto narrow =
+      header.index_type == asap::CompressedSparseRowFileType::Int32;
+  switch (header.value_type) {
+  case asap::CompressedSparseRowFileType::Float32:
+    return solve<float>(args, narrow);
+  case asap::CompressedSparseRowFileType::Float64:
+    return solve<double>(args, narrow);
+  case asap::CompressedSparseRowFileType::Int32:
+    return solve<std::int32_t>(args, narrow);
+  case asap::CompressedSparseRowFileType::Int64:
+    return solve<std::int64_t>(args, narrow);
+  default:
+    break;
+  }
+  std::cerr << "asap_solve: unsupported value type "
+            << asap::to_string(header.value_type) << '\n';
+  return BadFile;
+}